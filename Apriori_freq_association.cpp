@@ -8,18 +8,53 @@
 #include <string>
 using namespace std;
 
-// ---------- CSV Writer ----------
+// ---------- Buffered CSV Writer ----------
+// Copy of the CsvWriter in By-girl-new/normal.cpp, trimmed to the string
+// cells this program writes.
+class CsvWriter {
+public:
+    explicit CsvWriter(const string &filename, size_t bufferSize = 1 << 20)
+        : out(filename), limit(bufferSize) {
+        buf.reserve(bufferSize + 4096);
+    }
+    ~CsvWriter() { flush(); }
+
+    CsvWriter &cell(const string &s) { sep(); buf += s; return *this; }
+
+    CsvWriter &endRow() {
+        buf += '\n';
+        first = true;
+        if (buf.size() >= limit) {
+            out.write(buf.data(), buf.size());
+            buf.clear();
+        }
+        return *this;
+    }
+
+    void flush() {
+        if (!buf.empty()) out.write(buf.data(), buf.size());
+        buf.clear();
+        out.flush();
+    }
+
+private:
+    ofstream out;
+    string buf;
+    size_t limit;
+    bool first = true;
+
+    void sep() {
+        if (!first) buf += ',';
+        first = false;
+    }
+};
+
 void writeCSV(const string &filename, const vector<vector<string>> &rows) {
-    ofstream file(filename);
+    CsvWriter file(filename);
     for (auto &row : rows) {
-        for (size_t i = 0; i < row.size(); i++) {
-            file << row[i];
-            if (i != row.size() - 1)
-                file << ",";
-        }
-        file << "\n";
+        for (auto &cell : row) file.cell(cell);
+        file.endRow();
     }
-    file.close();
 }
 
 // ---------- Candidate Generator ----------
@@ -240,6 +275,8 @@ int main() {
 //
 // • Purpose: Save results (frequent itemsets and rules) into separate .csv files for later inspection.
 // • It loops through each “row” (vector<string>) and writes values separated by commas.
+// • Rows go through CsvWriter, which collects them in a 1 MB buffer and writes it in large
+//   blocks instead of one stream insertion per cell.
 // • Example Output Files:
 //     - frequent_itemsets.csv → Itemset + Support value
 //     - association_rules.csv → Antecedent + Consequent + Support + Confidence
@@ -96,6 +96,11 @@
 #include <string>
 #include <cmath>
 #include <iomanip>
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <numeric>
+#include <thread>
 using namespace std;
 // Function to compute Pearson correlation with detailed steps
 double pearsonCorrelation(const vector<double>& X, const vector<double>& Y) {
@@ -157,6 +162,359 @@ double pearsonCorrelation(const vector<double>& X, const vector<double>& Y) {
     return sumXY / sqrt(sumX2 * sumY2);
 }
 
+// ---------- Correlation Matrix Engine ----------
+// Copy of the correlation engine in By-vaibhav-new/7.co-relation/corelation.cpp,
+// which documents it (each program is built on its own). Keep CORR_TILE,
+// CorrelationResult, tileAccumulate, parallelBlocks, parallelFor and
+// correlationMatrix in step with that file. It has since moved on: its
+// tileAccumulate writes into a tile with row length ldt and its
+// correlationMatrix calls a separate standardize(), while this copy still
+// accumulates straight into the m x m result.
+const int CORR_TILE = 128;
+const double CORR_PARALLEL_WORK = 1e7;   // n * m * m below this: one thread
+
+struct CorrelationResult {
+    int m = 0;
+    size_t n = 0;
+    vector<double> mean, sd;      // sd: sample standard deviation (n - 1)
+    vector<double> corr, cov;     // m x m, row-major
+};
+
+void tileAccumulate(const double *Z, size_t n, int m, int i0, int i1, int j0, int j1, double *G) {
+    size_t r = 0;
+    for (; r + 4 <= n; r += 4) {
+        const double *z0 = Z + r * m, *z1 = z0 + m, *z2 = z1 + m, *z3 = z2 + m;
+        int i = i0;
+        for (; i + 2 <= i1; i += 2) {
+            double a0 = z0[i], a1 = z1[i], a2 = z2[i], a3 = z3[i];
+            double b0 = z0[i + 1], b1 = z1[i + 1], b2 = z2[i + 1], b3 = z3[i + 1];
+            double *gi = G + (size_t)i * m, *gk = gi + m;
+            if (j0 <= i) gi[i] += a0 * a0 + a1 * a1 + a2 * a2 + a3 * a3;
+            for (int j = max(j0, i + 1); j < j1; ++j) {
+                double v0 = z0[j], v1 = z1[j], v2 = z2[j], v3 = z3[j];
+                gi[j] += a0 * v0 + a1 * v1 + a2 * v2 + a3 * v3;
+                gk[j] += b0 * v0 + b1 * v1 + b2 * v2 + b3 * v3;
+            }
+        }
+        for (; i < i1; ++i) {
+            double a0 = z0[i], a1 = z1[i], a2 = z2[i], a3 = z3[i];
+            double *gi = G + (size_t)i * m;
+            for (int j = max(j0, i); j < j1; ++j) gi[j] += a0 * z0[j] + a1 * z1[j] + a2 * z2[j] + a3 * z3[j];
+        }
+    }
+    for (; r < n; ++r) {
+        const double *z = Z + r * m;
+        for (int i = i0; i < i1; ++i) {
+            double *gi = G + (size_t)i * m;
+            for (int j = max(j0, i); j < j1; ++j) gi[j] += z[i] * z[j];
+        }
+    }
+}
+
+template <class Fn>
+void parallelBlocks(size_t n, int threads, Fn fn) {
+    vector<thread> pool;
+    for (int t = 0; t < threads; t++) {
+        size_t b = n * t / threads, e = n * (t + 1) / threads;
+        pool.emplace_back([=] { fn(t, b, e); });
+    }
+    for (thread &th : pool) th.join();
+}
+
+template <class Fn>
+void parallelFor(size_t count, int threads, Fn fn) {
+    atomic<size_t> next(0);
+    threads = (int)min<size_t>(threads, max<size_t>(count, 1));
+    parallelBlocks(threads, threads, [&](int t, size_t, size_t) {
+        for (size_t k; (k = next++) < count;) fn(t, k);
+    });
+}
+
+CorrelationResult correlationMatrix(vector<double> &data, size_t n, int m) {
+    CorrelationResult R;
+    R.n = n;
+    R.m = m;
+    int threads = (double)n * m * m < CORR_PARALLEL_WORK ? 1 : max(1, (int)thread::hardware_concurrency());
+
+    vector<vector<double>> part(threads, vector<double>(m, 0.0));
+    parallelBlocks(n, threads, [&](int t, size_t b, size_t e) {
+        double *s = part[t].data();
+        for (size_t r = b; r < e; r++) {
+            const double *x = &data[r * m];
+            for (int j = 0; j < m; j++) s[j] += x[j];
+        }
+    });
+    R.mean.assign(m, 0.0);
+    for (int t = 0; t < threads; t++)
+        for (int j = 0; j < m; j++) R.mean[j] += part[t][j];
+    for (int j = 0; j < m; j++) R.mean[j] /= n;
+
+    for (auto &p : part) fill(p.begin(), p.end(), 0.0);
+    parallelBlocks(n, threads, [&](int t, size_t b, size_t e) {
+        double *s = part[t].data();
+        const double *mu = R.mean.data();
+        for (size_t r = b; r < e; r++) {
+            const double *x = &data[r * m];
+            for (int j = 0; j < m; j++) s[j] += (x[j] - mu[j]) * (x[j] - mu[j]);
+        }
+    });
+    vector<double> ss(m, 0.0), scale(m, 0.0);
+    for (int t = 0; t < threads; t++)
+        for (int j = 0; j < m; j++) ss[j] += part[t][j];
+    R.sd.assign(m, 0.0);
+    for (int j = 0; j < m; j++) {
+        R.sd[j] = sqrt(ss[j] / (n - 1));
+        if (ss[j] > 0) scale[j] = 1 / sqrt(ss[j]);
+    }
+
+    parallelBlocks(n, threads, [&](int, size_t b, size_t e) {
+        const double *mu = R.mean.data(), *sc = scale.data();
+        for (size_t r = b; r < e; r++) {
+            double *x = &data[r * m];
+            for (int j = 0; j < m; j++) x[j] = (x[j] - mu[j]) * sc[j];
+        }
+    });
+
+    vector<pair<int, int>> tiles;
+    for (int i0 = 0; i0 < m; i0 += CORR_TILE)
+        for (int j0 = i0; j0 < m; j0 += CORR_TILE) tiles.push_back({i0, j0});
+    R.corr.assign((size_t)m * m, 0.0);
+    parallelFor(tiles.size(), threads, [&](int, size_t k) {
+        int i0 = tiles[k].first, j0 = tiles[k].second;
+        tileAccumulate(data.data(), n, m, i0, min(m, i0 + CORR_TILE), j0, min(m, j0 + CORR_TILE), R.corr.data());
+    });
+
+    R.cov.assign((size_t)m * m, 0.0);
+    for (int i = 0; i < m; i++) {
+        for (int j = i; j < m; j++) {
+            double r = i == j ? (ss[i] > 0 ? 1.0 : 0.0) : min(1.0, max(-1.0, R.corr[(size_t)i * m + j]));
+            R.corr[(size_t)i * m + j] = R.corr[(size_t)j * m + i] = r;
+            R.cov[(size_t)i * m + j] = R.cov[(size_t)j * m + i] = i == j ? ss[i] / (n - 1) : r * R.sd[i] * R.sd[j];
+        }
+    }
+    return R;
+}
+
+// ---------- Rank Correlation ----------
+// Copy of the rank correlation code in By-vaibhav-new/7.co-relation/corelation.cpp,
+// which documents it (Spearman via ranks, Kendall's tau-b via Knight's
+// algorithm). Keep RankedColumn, rankColumn, averageRanks, countInversions,
+// KendallCounts, kendallCounts, spearmanMatrix and kendallMatrix identical to
+// that file.
+
+struct RankedColumn {
+    vector<int> order, dense;
+    long long ties = 0;
+};
+
+RankedColumn rankColumn(const double *x, size_t n, int stride) {
+    vector<double> v(n);
+    for (size_t r = 0; r < n; r++) v[r] = x[r * stride];
+    RankedColumn c;
+    c.order.resize(n);
+    c.dense.resize(n);
+    iota(c.order.begin(), c.order.end(), 0);
+    sort(c.order.begin(), c.order.end(), [&](int a, int b) { return v[a] < v[b] || (v[a] == v[b] && a < b); });
+    int rank = -1;
+    size_t run = 0;
+    for (size_t k = 0; k < n; k++) {
+        if (k == 0 || v[c.order[k]] != v[c.order[k - 1]]) {
+            c.ties += (long long)run * (run - 1) / 2;
+            run = 0;
+            rank++;
+        }
+        run++;
+        c.dense[c.order[k]] = rank;
+    }
+    c.ties += (long long)run * (run - 1) / 2;
+    return c;
+}
+
+void averageRanks(double *x, size_t n, int stride) {
+    RankedColumn c = rankColumn(x, n, stride);
+    for (size_t k = 0; k < n;) {
+        size_t e = k;
+        while (e < n && c.dense[c.order[e]] == c.dense[c.order[k]]) e++;
+        double r = (k + 1 + e) / 2.0;
+        for (size_t t = k; t < e; t++) x[(size_t)c.order[t] * stride] = r;
+        k = e;
+    }
+}
+
+long long countInversions(int *a, int *tmp, size_t n) {
+    long long inv = 0;
+    for (size_t w = 1; w < n; w *= 2) {
+        for (size_t lo = 0; lo < n; lo += 2 * w) {
+            size_t mid = min(n, lo + w), hi = min(n, lo + 2 * w), i = lo, j = mid, k = lo;
+            while (i < mid && j < hi) {
+                if (a[j] < a[i]) {
+                    inv += mid - i;
+                    tmp[k++] = a[j++];
+                } else {
+                    tmp[k++] = a[i++];
+                }
+            }
+            while (i < mid) tmp[k++] = a[i++];
+            while (j < hi) tmp[k++] = a[j++];
+        }
+        copy(tmp, tmp + n, a);
+    }
+    return inv;
+}
+
+struct KendallCounts {
+    long long pairs = 0, tiesX = 0, tiesY = 0, tiesXY = 0, discordant = 0;
+
+    long long concordant() const { return pairs - tiesX - tiesY + tiesXY - discordant; }
+    double tau() const {
+        if (pairs == tiesX || pairs == tiesY) return 0;
+        return (concordant() - discordant) / sqrt((double)(pairs - tiesX) * (pairs - tiesY));
+    }
+};
+
+KendallCounts kendallCounts(const RankedColumn &X, const RankedColumn &Y, vector<int> &seq, vector<int> &tmp) {
+    size_t n = X.order.size();
+    KendallCounts k;
+    k.pairs = (long long)n * (n - 1) / 2;
+    k.tiesX = X.ties;
+    k.tiesY = Y.ties;
+    seq.resize(n);
+    tmp.resize(n);
+    for (size_t s = 0; s < n;) {
+        size_t e = s;
+        while (e < n && X.dense[X.order[e]] == X.dense[X.order[s]]) {
+            seq[e] = Y.dense[X.order[e]];
+            e++;
+        }
+        if (e - s > 1) {
+            sort(seq.begin() + s, seq.begin() + e);
+            for (size_t a = s; a < e;) {
+                size_t b = a;
+                while (b < e && seq[b] == seq[a]) b++;
+                k.tiesXY += (long long)(b - a) * (b - a - 1) / 2;
+                a = b;
+            }
+        }
+        s = e;
+    }
+    k.discordant = countInversions(seq.data(), tmp.data(), n);
+    return k;
+}
+
+CorrelationResult spearmanMatrix(vector<double> &data, size_t n, int m) {
+    int threads = (double)n * m < CORR_PARALLEL_WORK ? 1 : max(1, (int)thread::hardware_concurrency());
+    parallelFor(m, threads, [&](int, size_t j) { averageRanks(&data[j], n, m); });
+    return correlationMatrix(data, n, m);
+}
+
+vector<double> kendallMatrix(const vector<double> &data, size_t n, int m) {
+    int threads = (double)n * m * m < CORR_PARALLEL_WORK ? 1 : max(1, (int)thread::hardware_concurrency());
+    vector<RankedColumn> cols(m);
+    parallelFor(m, threads, [&](int, size_t j) { cols[j] = rankColumn(&data[j], n, m); });
+
+    vector<pair<int, int>> pairs;
+    for (int i = 0; i < m; i++)
+        for (int j = i + 1; j < m; j++) pairs.push_back({i, j});
+    vector<double> tau((size_t)m * m, 0.0);
+    vector<vector<int>> seq(threads), tmp(threads);
+    parallelFor(pairs.size(), threads, [&](int t, size_t k) {
+        int i = pairs[k].first, j = pairs[k].second;
+        tau[(size_t)i * m + j] = tau[(size_t)j * m + i] = kendallCounts(cols[i], cols[j], seq[t], tmp[t]).tau();
+    });
+    long long allPairs = (long long)n * (n - 1) / 2;
+    for (int i = 0; i < m; i++) tau[(size_t)i * m + i] = cols[i].ties < allPairs ? 1.0 : 0.0;
+    return tau;
+}
+
+// Reads the rest of the file as an n x m numeric block (all columns).
+// Returns the number of rows skipped for a non-numeric cell or a different
+// column count.
+size_t readNumericTable(ifstream &file, int m, vector<double> &data, size_t &n) {
+    string line;
+    size_t skipped = 0;
+    n = 0;
+    vector<double> row;
+    while (getline(file, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty()) continue;
+        row.clear();
+        const char *p = line.data(), *end = p + line.size();
+        bool ok = true;
+        while (ok) {
+            const char *comma = find(p, end, ',');
+            const char *b = p, *e = comma;
+            while (b < e && isspace((unsigned char)*b)) b++;
+            while (e > b && isspace((unsigned char)e[-1])) e--;
+            if (b < e && *b == '+') b++;
+            double v;
+            auto r = from_chars(b, e, v);
+            ok = b < e && r.ec == errc() && r.ptr == e;
+            if (ok) row.push_back(v);
+            if (comma == end) break;
+            p = comma + 1;
+        }
+        if (!ok || (int)row.size() != m) {
+            skipped++;
+            continue;
+        }
+        data.insert(data.end(), row.begin(), row.end());
+        n++;
+    }
+    return skipped;
+}
+
+// Prints an m x m matrix with the column names; wide matrices go to a CSV
+// file instead of the console.
+void printMatrix(const string &title, const vector<double> &M, const vector<string> &headers, const string &csvName) {
+    int m = headers.size();
+    if (m > 10) {
+        ofstream out(csvName);
+        out << setprecision(6);
+        for (int j = 0; j < m; j++) out << "," << headers[j];
+        out << "\n";
+        for (int i = 0; i < m; i++) {
+            out << headers[i];
+            for (int j = 0; j < m; j++) out << "," << M[(size_t)i * m + j];
+            out << "\n";
+        }
+        cout << title << " (" << m << " x " << m << ") saved to " << csvName << endl;
+        return;
+    }
+    cout << "\n" << title << ":\n" << setw(12) << "";
+    for (int j = 0; j < m; j++) cout << setw(12) << headers[j].substr(0, 11);
+    cout << endl;
+    for (int i = 0; i < m; i++) {
+        cout << setw(12) << headers[i].substr(0, 11);
+        for (int j = 0; j < m; j++) cout << setw(12) << fixed << setprecision(4) << M[(size_t)i * m + j];
+        cout << endl;
+    }
+    cout.unsetf(ios::floatfield);
+    cout << setprecision(6);
+}
+
+// Pearson unless 2 or 3 is chosen
+int askMethod() {
+    int method = 1;
+    cout << "Correlation method: (1) Pearson  (2) Spearman  (3) Kendall tau-b: ";
+    cin >> method;
+    return method;
+}
+
+// Kendall's tau-b of two columns, with the pair counts behind it
+double kendallSteps(const vector<double> &X, const vector<double> &Y) {
+    RankedColumn rx = rankColumn(X.data(), X.size(), 1), ry = rankColumn(Y.data(), Y.size(), 1);
+    vector<int> seq, tmp;
+    KendallCounts k = kendallCounts(rx, ry, seq, tmp);
+    cout << "\nPairs of rows            = " << k.pairs << endl;
+    cout << "Pairs tied on X          = " << k.tiesX << endl;
+    cout << "Pairs tied on Y          = " << k.tiesY << endl;
+    cout << "Pairs tied on both       = " << k.tiesXY << endl;
+    cout << "Concordant pairs (C)     = " << k.concordant() << endl;
+    cout << "Discordant pairs (D)     = " << k.discordant << endl;
+    cout << "tau-b = (C - D) / sqrt((pairs - tiesX) * (pairs - tiesY))" << endl;
+    return k.tau();
+}
+
 int main() {
     string filename;
     cout << "Enter CSV file name : ";
@@ -181,8 +539,31 @@ int main() {
         cout << i << " -> " << headers[i] << endl;
 
     int col1, col2;
-    cout << "\nEnter index of first column: ";
+    cout << "\nEnter index of first column (or -1 for the full correlation and covariance matrices): ";
     cin >> col1;
+    if (col1 < 0) {
+        int m = headers.size();
+        vector<double> data;
+        size_t n = 0;
+        size_t skipped = readNumericTable(file, m, data, n);
+        file.close();
+        if (skipped > 0) cout << "Skipped " << skipped << " row(s) with a non-numeric cell or a different column count" << endl;
+        if (n < 2) {
+            cerr << "Need at least 2 rows of numeric data!" << endl;
+            return 1;
+        }
+        int method = askMethod();
+        if (method == 3) {
+            printMatrix("Kendall tau-b matrix", kendallMatrix(data, n, m), headers, "kendall_matrix.csv");
+        } else if (method == 2) {
+            printMatrix("Spearman correlation matrix", spearmanMatrix(data, n, m).corr, headers, "spearman_matrix.csv");
+        } else {
+            CorrelationResult R = correlationMatrix(data, n, m);
+            printMatrix("Pearson correlation matrix", R.corr, headers, "correlation_matrix.csv");
+            printMatrix("Covariance matrix", R.cov, headers, "covariance_matrix.csv");
+        }
+        return 0;
+    }
     cout << "Enter index of second column: ";
     cin >> col2;
 
@@ -204,12 +585,25 @@ int main() {
         return 1;
     }
 
-    double r = pearsonCorrelation(X, Y);
-
-    cout << "\nPearson correlation coefficient (r) = " << r << endl;
+    int method = askMethod();
+    double r;
+    if (method == 3) {
+        r = kendallSteps(X, Y);
+        cout << "\nKendall rank correlation (tau-b) = " << r << endl;
+    } else if (method == 2) {
+        vector<double> rankX = X, rankY = Y;
+        averageRanks(rankX.data(), rankX.size(), 1);
+        averageRanks(rankY.data(), rankY.size(), 1);
+        cout << "\nRanks of X and Y (tied values share their average rank); Pearson on the ranks:";
+        r = pearsonCorrelation(rankX, rankY);
+        cout << "\nSpearman rank correlation (rho) = " << r << endl;
+    } else {
+        r = pearsonCorrelation(X, Y);
+        cout << "\nPearson correlation coefficient (r) = " << r << endl;
+    }
 
     if (fabs(r) < 1e-6) 
-        cout << "Correlation is approximately zero (no linear relationship)." << endl;
+        cout << "Correlation is approximately zero (no " << (method == 2 || method == 3 ? "monotonic" : "linear") << " relationship)." << endl;
     else if (r > 0)
         cout << "Positive correlation." << endl;
     else
@@ -2,64 +2,89 @@
 using namespace std;
 
 // ---------- Function to calculate Entropy ----------
-double entropy(const vector<string>& y) {
-    unordered_map<string, int> freq;
-    for (size_t i = 0; i < y.size(); ++i)
-        freq[y[i]]++;
+// counts[] holds one count per class code; zero slots are skipped.
+// Same arithmetic as InfoGain.cpp / DecisionTree-info.cpp, so the three
+// programs give identical scores (and break ties the same way).
+double entropy(const double* counts, int numClasses) {
+    double total = 0.0;
+    for (int c = 0; c < numClasses; ++c)
+        total += counts[c];
+    if (total == 0) return 0.0;
 
     double ent = 0.0;
-    int total = y.size();
-    for (unordered_map<string, int>::iterator it = freq.begin(); it != freq.end(); ++it) {
-        double p = (double)it->second / total;
-        ent -= p * log2(p);
+    for (int c = 0; c < numClasses; ++c) {
+        double p = counts[c] / total;
+        if (p > 0)
+            ent += -p * log2(p);
     }
     return ent;
 }
 
 // ---------- Function to calculate Gini Index ----------
-double gini(const vector<string>& y) {
-    unordered_map<string, int> freq;
-    for (size_t i = 0; i < y.size(); ++i)
-        freq[y[i]]++;
+double gini(const double* counts, int numClasses) {
+    double total = 0.0;
+    for (int c = 0; c < numClasses; ++c)
+        total += counts[c];
+    if (total == 0) return 0.0;
 
     double g = 1.0;
-    int total = y.size();
-    for (unordered_map<string, int>::iterator it = freq.begin(); it != freq.end(); ++it) {
-        double p = (double)it->second / total;
+    for (int c = 0; c < numClasses; ++c) {
+        double p = counts[c] / total;
         g -= p * p;
     }
     return g;
 }
 
-// ---------- Split dataset by attribute value ----------
-vector<vector<string>> splitDataset(const vector<vector<string>>& dataset, int attrIndex, const string& value) {
-    vector<vector<string>> subset;
+// ---------- Encode one column as small integer codes ----------
+// Codes follow sorted value order, as in InfoGain.cpp's encodeData; numValues
+// returns how many distinct values the column has.
+vector<int> encodeColumn(const vector<vector<string>>& dataset, int colIndex, int& numValues) {
+    unordered_map<string, int> dict;
+    vector<int> codes(dataset.size());
     for (size_t i = 0; i < dataset.size(); ++i) {
-        if (dataset[i][attrIndex] == value)
-            subset.push_back(dataset[i]);
+        const string& v = dataset[i][colIndex];
+        unordered_map<string, int>::iterator it = dict.find(v);
+        if (it == dict.end())
+            it = dict.insert(make_pair(v, (int)dict.size())).first;
+        codes[i] = it->second;
     }
-    return subset;
+    numValues = dict.size();
+
+    // Re-number the first-appearance codes in sorted value order
+    vector<string> values(numValues);
+    for (auto& kv : dict) values[kv.second] = kv.first;
+    vector<int> order(numValues), remap(numValues);
+    iota(order.begin(), order.end(), 0);
+    sort(order.begin(), order.end(), [&](int a, int b) { return values[a] < values[b]; });
+    for (int i = 0; i < numValues; ++i)
+        remap[order[i]] = i;
+    for (int& c : codes)
+        c = remap[c];
+    return codes;
 }
 
 // ---------- Calculate weighted entropy and gini for feature ----------
-pair<double, double> calculateFeatureScores(const vector<vector<string>>& dataset, int attrIndex, int classIndex) {
-    unordered_set<string> values;
-    for (size_t i = 0; i < dataset.size(); ++i)
-        values.insert(dataset[i][attrIndex]);
-
-    double total = dataset.size();
+// One pass fills a flat [value][class] count table; both scores are then
+// read from it without building any per-value subsets.
+pair<double, double> calculateFeatureScores(const vector<int>& attrCodes, int numValues,
+                                            const vector<int>& classCodes, int numClasses) {
+    vector<double> counts(numValues * numClasses, 0.0);
+    for (size_t i = 0; i < attrCodes.size(); ++i)
+        counts[attrCodes[i] * numClasses + classCodes[i]] += 1.0;
+
+    double total = attrCodes.size();
     double weightedEntropy = 0.0;
     double weightedGini = 0.0;
 
-    for (unordered_set<string>::iterator it = values.begin(); it != values.end(); ++it) {
-        vector<vector<string>> subset = splitDataset(dataset, attrIndex, *it);
-        vector<string> subsetClass;
-        for (size_t i = 0; i < subset.size(); ++i)
-            subsetClass.push_back(subset[i][classIndex]);
+    for (int v = 0; v < numValues; ++v) {
+        const double* row = &counts[v * numClasses];
+        double subsetSize = 0.0;
+        for (int c = 0; c < numClasses; ++c)
+            subsetSize += row[c];
 
-        double subsetProb = subset.size() / total;
-        weightedEntropy += subsetProb * entropy(subsetClass);
-        weightedGini += subsetProb * gini(subsetClass);
+        double subsetProb = subsetSize / total;
+        weightedEntropy += subsetProb * entropy(row, numClasses);
+        weightedGini += subsetProb * gini(row, numClasses);
     }
 
     return make_pair(weightedEntropy, weightedGini);
@@ -100,12 +125,15 @@ int main() {
     file.close();
 
     int classIndex = header.size() - 1; // Last column is class
-    vector<string> classCol;
-    for (size_t i = 0; i < dataset.size(); ++i)
-        classCol.push_back(dataset[i][classIndex]);
+    int numClasses = 0;
+    vector<int> classCodes = encodeColumn(dataset, classIndex, numClasses);
+
+    vector<double> classCount(numClasses, 0.0);
+    for (size_t i = 0; i < classCodes.size(); ++i)
+        classCount[classCodes[i]] += 1.0;
 
-    double baseEntropy = entropy(classCol);
-    double baseGini = gini(classCol);
+    double baseEntropy = entropy(classCount.data(), numClasses);
+    double baseGini = gini(classCount.data(), numClasses);
 
     cout << fixed << setprecision(3);
     cout << "\nBase Entropy = " << baseEntropy << endl;
@@ -113,7 +141,9 @@ int main() {
     cout << "\n=== Attribute-wise Info Gain & Gini ===\n";
 
     for (int i = 0; i < classIndex; ++i) {
-        pair<double, double> featureScores = calculateFeatureScores(dataset, i, classIndex);
+        int numValues = 0;
+        vector<int> attrCodes = encodeColumn(dataset, i, numValues);
+        pair<double, double> featureScores = calculateFeatureScores(attrCodes, numValues, classCodes, numClasses);
         double featureEntropy = featureScores.first;
         double featureGini = featureScores.second;
         double infoGain = baseEntropy - featureEntropy;
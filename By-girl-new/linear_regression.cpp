@@ -77,6 +77,45 @@
 #include <iomanip>
 using namespace std;
 
+// ---------- Regression Accumulator ----------
+// Means of x and y plus the centred sums Sxx = sum (x - xBar)^2 and
+// Sxy = sum (x - xBar)(y - yBar), updated one point at a time (Welford), so
+// no point has to be stored. Two accumulators over different points merge
+// exactly (Chan et al.), which lets separate parts of the data be summed
+// independently and combined.
+struct RegressionStats {
+    long long n = 0;
+    double xBar = 0, yBar = 0, sxx = 0, sxy = 0;
+
+    void add(double x, double y) {
+        n++;
+        double dx = x - xBar;
+        xBar += dx / n;
+        yBar += (y - yBar) / n;
+        sxx += dx * (x - xBar);
+        sxy += dx * (y - yBar);
+    }
+
+    void merge(const RegressionStats &o) {
+        if (o.n == 0) return;
+        if (n == 0) {
+            *this = o;
+            return;
+        }
+        long long total = n + o.n;
+        double dx = o.xBar - xBar, dy = o.yBar - yBar;
+        double w = (double)n * o.n / total;
+        sxx += o.sxx + dx * dx * w;
+        sxy += o.sxy + dx * dy * w;
+        xBar += dx * o.n / total;
+        yBar += dy * o.n / total;
+        n = total;
+    }
+
+    double slope() const { return sxy / sxx; }
+    double intercept() const { return yBar - slope() * xBar; }
+};
+
 int main() {
     int n;
     cout << "Enter number of data points: ";
@@ -87,37 +126,17 @@ int main() {
         return 1;
     }
 
-    vector<double> xList(n), yList(n);
+    RegressionStats stats;
     cout << "Enter the data points (x y) separated by space:\n";
     for (int i = 0; i < n; i++) {
+        double x, y;
         cout << "Point " << i + 1 << ": ";
-        cin >> xList[i] >> yList[i];
-    }
-
-    // Calculate mean
-    double sumX = 0, sumY = 0;
-    for (int i = 0; i < n; i++) {
-        sumX += xList[i];
-        sumY += yList[i];
-    }
-    double xBar = sumX / n;
-    double yBar = sumY / n;
-
-    // Deviation calculations
-    vector<double> xDiff(n), yDiff(n), prodDiff(n), xDiff2(n);
-    double sumProdDiff = 0, sumXDiff2 = 0;
-
-    for (int i = 0; i < n; i++) {
-        xDiff[i] = xList[i] - xBar;
-        yDiff[i] = yList[i] - yBar;
-        prodDiff[i] = xDiff[i] * yDiff[i];
-        xDiff2[i] = xDiff[i] * xDiff[i];
-        sumProdDiff += prodDiff[i];
-        sumXDiff2 += xDiff2[i];
+        cin >> x >> y;
+        stats.add(x, y);
     }
 
-    double m = sumProdDiff / sumXDiff2;
-    double c = yBar - m * xBar;
+    double m = stats.slope();
+    double c = stats.intercept();
 
     cout << "\nLinear Regression Equation: y = " << m << " * x + " << c << endl;
 
@@ -67,109 +67,109 @@
 
 //     cout<<"Predicted class: "<<pred<<"\n";
 // }
-#include <bits/stdc++.h>
-using namespace std;
-
-vector<string> split(const string &s, char d) {
-    vector<string> t; string x; stringstream ss(s);
-    while (getline(ss, x, d)) t.push_back(x);
-    return t;
-}
-
-int main() {
-    string filename;
-    cout << "Enter CSV filename: ";
-    cin >> filename;
-
-    ifstream file(filename);
-    if (!file.is_open()) {
-        cerr << "Error: Cannot open file.\n";
-        return 1;
-    }
+// #include <bits/stdc++.h>
+// using namespace std;
 
-    string line;
-    getline(file, line);
-    vector<string> headers = split(line, ',');
-    int n = headers.size() - 1;
+// vector<string> split(const string &s, char d) {
+//     vector<string> t; string x; stringstream ss(s);
+//     while (getline(ss, x, d)) t.push_back(x);
+//     return t;
+// }
 
-    vector<vector<string>> data;
-    while (getline(file, line)) {
-        vector<string> row = split(line, ',');
-        if (row.size() == headers.size()) data.push_back(row);
-    }
-    file.close();
+// int main() {
+//     string filename;
+//     cout << "Enter CSV filename: ";
+//     cin >> filename;
 
-    map<string, int> classCount;
-    for (auto &r : data) classCount[r.back()]++;
-    int total = data.size();
+//     ifstream file(filename);
+//     if (!file.is_open()) {
+//         cerr << "Error: Cannot open file.\n";
+//         return 1;
+//     }
 
-    cout << "\nPrior Probabilities:\n";
-    map<string, double> prior;
-    for (auto &c : classCount) {
-        prior[c.first] = (double)c.second / total;
-        cout << "P(" << c.first << ") = " << classCount[c.first] << "/" << total
-             << " = " << fixed << setprecision(3) << prior[c.first] << endl;
-    }
+//     string line;
+//     getline(file, line);
+//     vector<string> headers = split(line, ',');
+//     int n = headers.size() - 1;
 
-    cout << "\nConditional Probabilities:\n";
-    map<string, map<string, map<string, double>>> featureProb;
-    for (int i = 0; i < n; i++) {
-        map<string, map<string, int>> freq;
-        for (auto &r : data) freq[r.back()][r[i]]++;
+//     vector<vector<string>> data;
+//     while (getline(file, line)) {
+//         vector<string> row = split(line, ',');
+//         if (row.size() == headers.size()) data.push_back(row);
+//     }
+//     file.close();
 
-        for (auto &c : classCount) {
-            cout << "\nFor Class = " << c.first << " (" << headers[i] << "):\n";
-            for (auto &f : freq[c.first]) {
-                featureProb[headers[i]][c.first][f.first] =
-                    (double)f.second / classCount[c.first];
-                cout << "P(" << f.first << " | " << c.first << ") = "
-                     << f.second << "/" << classCount[c.first]
-                     << " = " << featureProb[headers[i]][c.first][f.first] << endl;
-            }
-        }
-    }
+//     map<string, int> classCount;
+//     for (auto &r : data) classCount[r.back()]++;
+//     int total = data.size();
+
+//     cout << "\nPrior Probabilities:\n";
+//     map<string, double> prior;
+//     for (auto &c : classCount) {
+//         prior[c.first] = (double)c.second / total;
+//         cout << "P(" << c.first << ") = " << classCount[c.first] << "/" << total
+//              << " = " << fixed << setprecision(3) << prior[c.first] << endl;
+//     }
 
-    cout << "\nEnter values for a test case:\n";
-    map<string, string> inst;
-    for (int i = 0; i < n; i++) {
-        string v;
-        cout << headers[i] << ": ";
-        cin >> v;
-        inst[headers[i]] = v;
-    }
+//     cout << "\nConditional Probabilities:\n";
+//     map<string, map<string, map<string, double>>> featureProb;
+//     for (int i = 0; i < n; i++) {
+//         map<string, map<string, int>> freq;
+//         for (auto &r : data) freq[r.back()][r[i]]++;
+
+//         for (auto &c : classCount) {
+//             cout << "\nFor Class = " << c.first << " (" << headers[i] << "):\n";
+//             for (auto &f : freq[c.first]) {
+//                 featureProb[headers[i]][c.first][f.first] =
+//                     (double)f.second / classCount[c.first];
+//                 cout << "P(" << f.first << " | " << c.first << ") = "
+//                      << f.second << "/" << classCount[c.first]
+//                      << " = " << featureProb[headers[i]][c.first][f.first] << endl;
+//             }
+//         }
+//     }
 
-    cout << "\nCalculation of Posterior Probabilities:\n";
-    map<string, double> post;
+//     cout << "\nEnter values for a test case:\n";
+//     map<string, string> inst;
+//     for (int i = 0; i < n; i++) {
+//         string v;
+//         cout << headers[i] << ": ";
+//         cin >> v;
+//         inst[headers[i]] = v;
+//     }
 
-    for (auto &c : classCount) {
-        double prob = prior[c.first];
-        cout << "\nFor " << c.first << ":\n";
-        cout << "P(" << c.first << ") = " << prior[c.first] << endl;
-        for (int i = 0; i < n; i++) {
-            string f = headers[i], v = inst[f];
-            double cond = featureProb[f][c.first].count(v) ?
-                          featureProb[f][c.first][v] : 0.0;
-            cout << "P(" << v << " | " << c.first << ") = " << cond << endl;
-            prob *= cond;
-        }
-        cout << "=> Final P(" << c.first << " | Case) = " << prob << endl;
-        post[c.first] = prob;
-    }
+//     cout << "\nCalculation of Posterior Probabilities:\n";
+//     map<string, double> post;
+
+//     for (auto &c : classCount) {
+//         double prob = prior[c.first];
+//         cout << "\nFor " << c.first << ":\n";
+//         cout << "P(" << c.first << ") = " << prior[c.first] << endl;
+//         for (int i = 0; i < n; i++) {
+//             string f = headers[i], v = inst[f];
+//             double cond = featureProb[f][c.first].count(v) ?
+//                           featureProb[f][c.first][v] : 0.0;
+//             cout << "P(" << v << " | " << c.first << ") = " << cond << endl;
+//             prob *= cond;
+//         }
+//         cout << "=> Final P(" << c.first << " | Case) = " << prob << endl;
+//         post[c.first] = prob;
+//     }
 
-    cout << "\nComparison:\n";
-    for (auto &p : post)
-        cout << "P(" << p.first << " | Case) = " << p.second << endl;
+//     cout << "\nComparison:\n";
+//     for (auto &p : post)
+//         cout << "P(" << p.first << " | Case) = " << p.second << endl;
 
-    string pred = max_element(post.begin(), post.end(),
-                              [](auto &a, auto &b) {
-                                  return a.second < b.second;
-                              })->first;
+//     string pred = max_element(post.begin(), post.end(),
+//                               [](auto &a, auto &b) {
+//                                   return a.second < b.second;
+//                               })->first;
 
-    cout << "\nBased on calculations:\nPredicted classification for case is "
-         << pred << endl;
+//     cout << "\nBased on calculations:\nPredicted classification for case is "
+//          << pred << endl;
 
-    return 0;
-}
+//     return 0;
+// }
 
 
 
@@ -357,6 +357,150 @@ vector<string> split(const string &s, char d) {
     return t;
 }
 
+// ---------- Log-Space Batch Scoring ----------
+// Copy of the log-space scoring code (LogScoreTable through scoreMany) in
+// NaiveNumeric.cpp, which documents it; fix both copies together.
+struct LogScoreTable {
+    int numClasses = 0;
+    vector<string> labels;                       // table class index -> label
+    vector<double> logPrior;                     // [class]
+    vector<bool> isNum;                          // per feature
+    vector<vector<double>> logCond;              // categorical: [(value) * numClasses + class]
+    vector<vector<double>> gaussA, gaussB, gaussC; // numeric: [feature][class]
+};
+
+struct ScoreBatch {
+    int numRows = 0;
+    vector<vector<int>> codes;
+    vector<vector<double>> values;
+};
+
+void gaussianLogTerms(double mean, double sd, double &a, double &b, double &c) {
+    if (sd == 0) {                               // same 1e-9 floor as the PDF
+        a = 0.0; b = mean; c = log(1e-9);
+        return;
+    }
+    a = -1.0 / (2 * sd * sd);
+    b = mean;
+    c = -log(sqrt(2 * M_PI) * sd);
+}
+
+void scoreBlock(const LogScoreTable &t, const ScoreBatch &b, int begin, int end, double *scores, int *out) {
+    int n = end - begin, K = t.numClasses;
+    for (int k = 0; k < K; k++)
+        fill(scores + (size_t)k * n, scores + (size_t)(k + 1) * n, t.logPrior[k]);
+
+    for (int f = 0; f < (int)t.isNum.size(); f++) {
+        if (t.isNum[f]) {
+            const double *x = b.values[f].data() + begin;
+            for (int k = 0; k < K; k++) {
+                double A = t.gaussA[f][k], B = t.gaussB[f][k], C = t.gaussC[f][k];
+                double *s = scores + (size_t)k * n;
+                for (int i = 0; i < n; i++) {
+                    double d = x[i] - B;
+                    double v = C + A * d * d;
+                    s[i] += v == v ? v : 0.0;
+                }
+            }
+        } else {
+            const int *code = b.codes[f].data() + begin;
+            const double *table = t.logCond[f].data();
+            for (int k = 0; k < K; k++) {
+                double *s = scores + (size_t)k * n;
+                for (int i = 0; i < n; i++) s[i] += table[code[i] * K + k];
+            }
+        }
+    }
+
+    for (int i = 0; i < n; i++) {
+        int best = 0;
+        for (int k = 1; k < K; k++)
+            if (scores[(size_t)k * n + i] > scores[(size_t)best * n + i]) best = k;
+        out[begin + i] = best;
+    }
+}
+
+const int SCORE_BLOCK_ROWS = 4096;
+
+void scoreMany(const LogScoreTable &t, const ScoreBatch &b, vector<int> &out) {
+    out.assign(b.numRows, 0);
+    if (t.numClasses == 0) return;
+    int numBlocks = (b.numRows + SCORE_BLOCK_ROWS - 1) / SCORE_BLOCK_ROWS;
+    atomic<int> next(0);
+    auto worker = [&] {
+        vector<double> scores((size_t)t.numClasses * SCORE_BLOCK_ROWS);
+        for (int blk = next++; blk < numBlocks; blk = next++) {
+            int begin = blk * SCORE_BLOCK_ROWS;
+            scoreBlock(t, b, begin, min(b.numRows, begin + SCORE_BLOCK_ROWS), scores.data(), out.data());
+        }
+    };
+    int numThreads = max(1, min((int)thread::hardware_concurrency(), numBlocks));
+    vector<thread> threads;
+    for (int i = 1; i < numThreads; i++) threads.emplace_back(worker);
+    worker();
+    for (thread &th : threads) th.join();
+}
+
+// Builds the log-space scoring table from the trained frequency counts;
+// value codes follow the sorted order of featureValues
+LogScoreTable compileScoreTable(const vector<string> &headers, const map<string, int> &classCount,
+                                map<string, set<string>> &featureValues,
+                                map<string, map<string, map<string, int>>> &featureCount) {
+    LogScoreTable t;
+    int n = headers.size() - 1, K = classCount.size(), total = 0;
+    for (auto &c : classCount) total += c.second;
+    t.numClasses = K;
+    t.isNum.assign(n, false);
+    t.logCond.resize(n);
+    t.gaussA.resize(n);
+    t.gaussB.resize(n);
+    t.gaussC.resize(n);
+    for (auto &c : classCount) {
+        t.labels.push_back(c.first);
+        t.logPrior.push_back(log((double)c.second / total));
+    }
+    for (int i = 0; i < n; i++) {
+        const set<string> &vals = featureValues[headers[i]];
+        int V = vals.size();
+        t.logCond[i].resize((size_t)(V + 1) * K);
+        int k = 0;
+        for (auto &c : classCount) {
+            double denom = c.second + V;                      // Laplace smoothing
+            map<string, int> &counts = featureCount[headers[i]][c.first];
+            int v = 0;
+            for (auto &val : vals) {
+                auto it = counts.find(val);
+                int count = it == counts.end() ? 0 : it->second;
+                t.logCond[i][(size_t)v++ * K + k] = log((count + 1.0) / denom);
+            }
+            t.logCond[i][(size_t)V * K + k] = log(1.0 / denom);
+            k++;
+        }
+    }
+    return t;
+}
+
+ScoreBatch encodeScoreBatch(const vector<string> &headers, map<string, set<string>> &featureValues,
+                            const vector<vector<string>> &records) {
+    ScoreBatch b;
+    int n = headers.size() - 1;
+    b.numRows = records.size();
+    b.codes.resize(n);
+    b.values.resize(n);
+    for (int i = 0; i < n; i++) {
+        const set<string> &vals = featureValues[headers[i]];
+        unordered_map<string, int> lookup;
+        for (auto &val : vals) lookup.emplace(val, lookup.size());
+        b.codes[i].resize(b.numRows);
+        for (int r = 0; r < b.numRows; r++) {
+            const vector<string> &rec = records[r];
+            auto it = i < (int)rec.size() ? lookup.find(rec[i]) : lookup.end();
+            b.codes[i][r] = it == lookup.end() ? (int)vals.size() : it->second;
+        }
+    }
+    return b;
+}
+
 int main() {
     string filename;
     cout << "Enter CSV filename: ";
@@ -398,16 +542,66 @@ int main() {
     for (auto &c : classCount)
         prior[c.first] = (double)c.second / total;
 
-    // Compute conditional probabilities
-    map<string, map<string, map<string, double>>> featureProb;
+    // Count feature values per class (feature -> class -> value -> count);
+    // conditional probabilities are derived from these exact counts
+    map<string, map<string, map<string, int>>> featureCount;
     for (int i = 0; i < n; i++) {
-        map<string, map<string, int>> freq;
+        map<string, map<string, int>> &freq = featureCount[headers[i]];
         for (auto &r : data) freq[r.back()][r[i]]++;
+    }
+
+    // Batch mode: score a whole test CSV in log space
+    int choice = 1;
+    cout << "\nPredict (1) one test case or (2) all records of a CSV file: ";
+    cin >> choice;
+
+    if (choice == 2) {
+        string testFile, outFile;
+        cout << "Enter test CSV filename: ";
+        cin >> testFile;
+        cout << "Enter output CSV filename: ";
+        cin >> outFile;
+
+        ifstream in(testFile);
+        if (!getline(in, line)) {
+            cerr << "Error: Empty or invalid test file.\n";
+            return 1;
+        }
+        vector<string> testHeaders = split(line, ',');
+        vector<vector<string>> records;
+        while (getline(in, line))
+            if (!line.empty()) records.push_back(split(line, ','));
+        in.close();
+
+        LogScoreTable table = compileScoreTable(headers, classCount, featureValues, featureCount);
+        ScoreBatch batch = encodeScoreBatch(headers, featureValues, records);
+
+        auto t0 = chrono::steady_clock::now();
+        vector<int> predicted;
+        scoreMany(table, batch, predicted);
+        double secs = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+
+        // Accuracy is reported when the test file still has the class column
+        int labelled = 0, correct = 0;
+        ofstream out(outFile);
+        for (auto &h : testHeaders) out << h << ",";
+        out << "Predicted_" << headers.back() << "\n";
+        for (int r = 0; r < batch.numRows; r++) {
+            for (auto &v : records[r]) out << v << ",";
+            const string &label = table.labels[predicted[r]];
+            out << label << "\n";
+            if (records[r].size() == headers.size()) {
+                labelled++;
+                if (records[r].back() == label) correct++;
+            }
+        }
 
-        for (auto &c : classCount)
-            for (auto &f : featureValues[headers[i]])
-                featureProb[headers[i]][c.first][f] = 
-                    (double)(freq[c.first][f]) / classCount[c.first];
+        cout << "\nScored " << batch.numRows << " records in " << secs << " s";
+        if (secs > 0) cout << " (" << (long long)(batch.numRows / secs) << " records/s)";
+        cout << "\nPredictions written to " << outFile << endl;
+        if (labelled > 0)
+            cout << "Accuracy = " << 100.0 * correct / labelled << "% (" << correct << "/" << labelled << ")" << endl;
+        return 0;
     }
 
     // Input test case
@@ -422,8 +616,8 @@ int main() {
 
     // Function to calculate conditional probability with Laplace smoothing
     auto getConditionalProb = [&](const string &feature, const string &value, const string &cls) {
-        int count = featureProb[feature][cls].count(value) ? 
-                    featureProb[feature][cls][value] * classCount[cls] : 0;
+        int count = featureCount[feature][cls].count(value) ? 
+                    featureCount[feature][cls][value] : 0;
         int V = featureValues[feature].size();
         return (count + 1.0) / (classCount[cls] + V); // Laplace smoothing
     };
@@ -143,93 +143,323 @@ bool isFloat(const string &s) {
     }
 }
 
-// Normalize a single column
-vector<double> normalizeColumn(const vector<double>& col, int method) {
-    vector<double> normCol;
-    if (method == 1) { // Min-Max
-        double minVal = *min_element(col.begin(), col.end());
-        double maxVal = *max_element(col.begin(), col.end());
-        for (double x : col)
-            normCol.push_back((maxVal != minVal) ? (x - minVal) / (maxVal - minVal) : 0.0);
-    } 
-    else if (method == 2) { // Z-Score
-        double mean = accumulate(col.begin(), col.end(), 0.0) / col.size();
-        double sqSum = 0;
-        for (double x : col) sqSum += (x - mean) * (x - mean);
-        double stddev = sqrt(sqSum / col.size());
-        for (double x : col)
-            normCol.push_back((stddev != 0) ? (x - mean) / stddev : 0.0);
-    } 
-    else if (method == 3) { // Decimal Scaling
-        double maxAbs = 0;
-        for (double x : col) maxAbs = max(maxAbs, fabs(x));
-        int j = (maxAbs != 0) ? to_string((long long)maxAbs).length() : 1;
-        for (double x : col) normCol.push_back(x / pow(10, j));
+// ---------- Column Statistics Kernel ----------
+// Copy of ColumnStats and computeColumnStats in Normaliozation.cpp, which
+// documents them (each program is built on its own); fix both copies together.
+struct ColumnStats {
+    long long n = 0;
+    vector<double> minVal, maxVal, sum, mean, m2, maxAbs;
+
+    void init(int cols) {
+        n = 0;
+        minVal.assign(cols, numeric_limits<double>::max());
+        maxVal.assign(cols, numeric_limits<double>::lowest());
+        sum.assign(cols, 0.0);
+        mean.assign(cols, 0.0);
+        m2.assign(cols, 0.0);
+        maxAbs.assign(cols, 0.0);
+    }
+
+    void addRow(const double *x) {
+        n++;
+        double inv = 1.0 / n;
+        int cols = mean.size();
+        for (int j = 0; j < cols; j++) {
+            double v = x[j], a = fabs(v);
+            minVal[j] = v < minVal[j] ? v : minVal[j];
+            maxVal[j] = v > maxVal[j] ? v : maxVal[j];
+            maxAbs[j] = a > maxAbs[j] ? a : maxAbs[j];
+            sum[j] += v;
+            double d = v - mean[j];
+            mean[j] += d * inv;
+            m2[j] += d * (v - mean[j]);
+        }
     }
-    return normCol;
-}
 
-// Apply normalization to selected columns
-vector<vector<string>> applyNormalization(
-    int method,
-    const vector<string>& header,
-    const vector<vector<string>>& rows,
-    const vector<int>& numCols)
-{
-    int colCount = header.size();
-    vector<vector<string>> columns(colCount);
-    for (int c = 0; c < colCount; c++) {
-        for (auto &row : rows) {
-            columns[c].push_back(row[c]);
+    void merge(const ColumnStats &o) {
+        if (o.n == 0) return;
+        if (n == 0) {
+            *this = o;
+            return;
         }
+        long long total = n + o.n;
+        for (int j = 0; j < (int)mean.size(); j++) {
+            minVal[j] = min(minVal[j], o.minVal[j]);
+            maxVal[j] = max(maxVal[j], o.maxVal[j]);
+            maxAbs[j] = max(maxAbs[j], o.maxAbs[j]);
+            sum[j] += o.sum[j];
+            double d = o.mean[j] - mean[j];
+            mean[j] += d * o.n / total;
+            m2[j] += o.m2[j] + d * d * ((double)n * o.n / total);
+        }
+        n = total;
     }
 
-    vector<vector<string>> normalizedCols;
+    double stddev(int j) const { return n > 0 ? sqrt(m2[j] / n) : 0.0; }   // population
+};
+
+const size_t STATS_PARALLEL_ROWS = 100000;
+
+template <class RowAt>
+ColumnStats computeColumnStats(size_t rows, int cols, RowAt rowAt) {
+    int threads = rows < STATS_PARALLEL_ROWS ? 1 : max(1, (int)thread::hardware_concurrency());
+    vector<ColumnStats> part(threads);
+    vector<thread> workers;
+    for (int t = 0; t < threads; t++) {
+        auto work = [&, t] {
+            part[t].init(cols);
+            size_t begin = rows * t / threads, end = rows * (t + 1) / threads;
+            for (size_t i = begin; i < end; i++) part[t].addRow(rowAt(i));
+        };
+        if (t + 1 < threads) workers.emplace_back(work);
+        else work();
+    }
+    for (thread &w : workers) w.join();
+    for (int t = 1; t < threads; t++) part[0].merge(part[t]);
+    return part[0];
+}
 
-    for (int c = 0; c < colCount; c++) {
-        if (find(numCols.begin(), numCols.end(), c) != numCols.end()) {
-            vector<double> col;
-            for (auto &v : columns[c]) col.push_back(stod(v));
+// ---------- Affine Transform ----------
+// Once a column's statistics are known, every method is the same affine map
+// x' = (x - shift) / scale:
+//   Min-Max         : shift = min,  scale = max - min   (all 0 when max == min)
+//   Z-Score         : shift = mean, scale = stddev      (all 0 when stddev == 0)
+//   Decimal Scaling : shift = 0,    scale = 10^j
+// Dividing (rather than multiplying by 1 / scale) keeps every result bit for
+// bit equal to the per-method formulas, so x == min still prints 0.000000.
+struct Affine { double shift, scale; };
+
+Affine methodAffine(const ColumnStats &st, int k, int method) {
+    if (method == 1) return {st.minVal[k], st.maxVal[k] - st.minVal[k]};
+    if (method == 2) return {st.mean[k], st.stddev(k)};
+    double maxAbs = st.maxAbs[k];
+    int j = (maxAbs != 0) ? to_string((long long)maxAbs).length() : 1;
+    return {0.0, pow(10, j)};
+}
 
-            vector<double> normCol = normalizeColumn(col, method);
+// dst may be the same buffer as src (in place); a plain loop the compiler vectorizes
+void applyAffine(const double *src, double *dst, size_t n, Affine t) {
+    if (t.scale == 0) {
+        fill(dst, dst + n, 0.0);
+        return;
+    }
+    for (size_t i = 0; i < n; i++) dst[i] = (src[i] - t.shift) / t.scale;
+}
 
-            vector<string> normStr;
-            for (double val : normCol) {
-                ostringstream oss;
-                oss << fixed << setprecision(6) << val;
-                normStr.push_back(oss.str());
+// ---------- CSV Block Reader ----------
+// The file is streamed in blocks of lines. For every line we only record
+// where each field starts and ends: selected columns are parsed straight
+// from the line text into typed buffers, other cells are copied to the
+// output untouched, so no per-cell strings are ever built.
+const int BLOCK_ROWS = 1 << 17;
+
+struct LineBlock {
+    vector<string> lines;
+    vector<int> start, end;      // [row * cols + col] field bounds inside lines[row]
+    int numRows = 0;
+};
+
+bool readBlock(istream &in, int cols, LineBlock &b) {
+    b.lines.resize(BLOCK_ROWS);
+    b.start.resize((size_t)BLOCK_ROWS * cols);
+    b.end.resize((size_t)BLOCK_ROWS * cols);
+    b.numRows = 0;
+    while (b.numRows < BLOCK_ROWS && getline(in, b.lines[b.numRows])) {
+        const string &line = b.lines[b.numRows];
+        if (line.empty()) continue;
+        int *st = &b.start[(size_t)b.numRows * cols], *en = &b.end[(size_t)b.numRows * cols];
+        int c = 0, from = 0, len = line.size();
+        for (int i = 0; i <= len && c < cols; i++) {
+            if (i == len || line[i] == ',') {
+                st[c] = from;
+                en[c++] = i;
+                from = i + 1;
             }
-            normalizedCols.push_back(normStr);
         }
-        else {
-            normalizedCols.push_back(columns[c]);
+        for (; c < cols; c++) st[c] = en[c] = len;      // missing cells are empty
+        b.numRows++;
+    }
+    return b.numRows > 0;
+}
+
+// Accepts what stod did for these files: leading blanks and a '+' sign
+// (plus trailing blanks or a CR). Empty or text cells are rejected.
+bool parseCell(const char *p, const char *e, double &v) {
+    while (p < e && (*p == ' ' || *p == '+')) p++;
+    while (e > p && (e[-1] == ' ' || e[-1] == '\r')) e--;
+    if (p == e) return false;
+    from_chars_result r = from_chars(p, e, v);
+    return r.ec == errc() && r.ptr == e;
+}
+
+// Parses the selected cells of line r of the block into x[0..k); false if
+// any of them is empty or not a number (the row is then skipped)
+bool parseRow(const LineBlock &b, int r, int cols, const vector<int> &numCols, double *x) {
+    const char *line = b.lines[r].data();
+    for (int s = 0; s < (int)numCols.size(); s++) {
+        size_t f = (size_t)r * cols + numCols[s];
+        if (!parseCell(line + b.start[f], line + b.end[f], x[s])) return false;
+    }
+    return true;
+}
+
+// ---------- Pass 1: Statistics ----------
+// Rows with a bad selected cell are left out of the statistics and counted
+ColumnStats scanStats(const string &fileName, int cols, const vector<int> &numCols, long long &skipped) {
+    ifstream in(fileName);
+    string headerLine;
+    getline(in, headerLine);
+
+    int k = numCols.size();
+    ColumnStats total;
+    total.init(k);
+    skipped = 0;
+    LineBlock b;
+    vector<double> vals;
+    while (readBlock(in, cols, b)) {
+        vals.resize((size_t)b.numRows * k);
+        size_t good = 0;
+        for (int r = 0; r < b.numRows; r++) {
+            if (parseRow(b, r, cols, numCols, &vals[good * k])) good++;
+            else skipped++;
         }
+        total.merge(computeColumnStats(good, k, [&](size_t r) { return &vals[r * k]; }));
+    }
+    return total;
+}
+
+// ---------- Buffered CSV Writer ----------
+// Cells are formatted straight into one large buffer with to_chars and the
+// buffer goes to the file in big blocks, instead of one ofstream << per cell.
+// Numbers are written like the default stream output (%g, 6 significant
+// digits), or like << fixed << setprecision(p) after fixed(p). The file is
+// opened in text mode like the ofstream it replaces, so line endings on
+// Windows are unchanged. Each program is built on its own, so trimmed copies
+// of this class live in Normaliozation.cpp, Apriori_freq_association.cpp,
+// td.cpp and weight.cpp.
+class CsvWriter {
+public:
+    explicit CsvWriter(const string &filename, size_t bufferSize = 1 << 20)
+        : out(filename), limit(bufferSize) {
+        buf.reserve(bufferSize + 4096);
+    }
+    ~CsvWriter() { flush(); }
+
+    CsvWriter &fixed(int digits) { fmt = chars_format::fixed; precision = digits; return *this; }
+
+    CsvWriter &cell(const string &s) { sep(); buf += s; return *this; }
+    CsvWriter &cell(const char *s, size_t n) { sep(); buf.append(s, n); return *this; }
+    CsvWriter &cell(double v) {
+        sep();
+        char tmp[400];
+        buf.append(tmp, to_chars(tmp, tmp + sizeof(tmp), v, fmt, precision).ptr);
+        return *this;
     }
 
-    // Transpose back to rows
-    vector<vector<string>> normalizedRows(rows.size(), vector<string>(colCount));
-    for (int c = 0; c < colCount; c++) {
-        for (int r = 0; r < rows.size(); r++) {
-            normalizedRows[r][c] = normalizedCols[c][r];
+    // Text of the cell written last in this row
+    string lastCell() const { return buf.substr(cellStart); }
+
+    // Rows are never split across writes; the buffer is handed to the
+    // stream once it passes the block size.
+    CsvWriter &endRow() {
+        buf += '\n';
+        first = true;
+        if (buf.size() >= limit) {
+            out.write(buf.data(), buf.size());
+            buf.clear();
         }
+        return *this;
     }
 
-    return normalizedRows;
-}
+    void flush() {
+        if (!buf.empty()) out.write(buf.data(), buf.size());
+        buf.clear();
+        out.flush();
+    }
 
-// Save CSV
-void saveCSV(const vector<string>& header, const vector<vector<string>>& normalizedRows, const string& outFile) {
-    ofstream out(outFile);
-    for (int i = 0; i < header.size(); i++) {
-        out << header[i] << (i < header.size() - 1 ? "," : "\n");
+private:
+    ofstream out;
+    string buf;
+    size_t limit, cellStart = 0;
+    bool first = true;
+    chars_format fmt = chars_format::general;
+    int precision = 6;
+
+    void sep() {
+        if (!first) buf += ',';
+        first = false;
+        cellStart = buf.size();
+    }
+};
+
+// ---------- Pass 2: Transform and Write ----------
+// Each block's selected columns become one double buffer per column, are
+// transformed with (x - shift) / scale for every requested method (in place when there
+// is only one) and written through a CsvWriter per method with fixed(6) (same
+// text as fixed, setprecision(6)). The first 5 output rows of each method are
+// kept for the preview. Rows skipped in pass 1 are skipped here as well.
+void writeNormalized(const string &fileName, const vector<string> &header, const vector<int> &numCols,
+                     const ColumnStats &stats, const vector<int> &methods, const vector<string> &outFiles,
+                     vector<vector<vector<string>>> &preview) {
+    int cols = header.size(), k = numCols.size(), M = methods.size();
+    vector<int> slot(cols, -1);
+    for (int s = 0; s < k; s++) slot[numCols[s]] = s;
+
+    vector<vector<Affine>> affine(M, vector<Affine>(k));
+    for (int m = 0; m < M; m++)
+        for (int s = 0; s < k; s++) affine[m][s] = methodAffine(stats, s, methods[m]);
+
+    vector<unique_ptr<CsvWriter>> outs;
+    for (int m = 0; m < M; m++) {
+        outs.emplace_back(new CsvWriter(outFiles[m]));
+        outs[m]->fixed(6);
+        for (auto &h : header) outs[m]->cell(h);
+        outs[m]->endRow();
     }
-    for (auto &row : normalizedRows) {
-        for (int i = 0; i < row.size(); i++) {
-            out << row[i] << (i < row.size() - 1 ? "," : "\n");
+    preview.assign(M, {});
+
+    ifstream in(fileName);
+    string headerLine;
+    getline(in, headerLine);
+    LineBlock b;
+    vector<vector<double>> column(k), work(M > 1 ? k : 0);
+    vector<int> lineOf;                 // block line of each kept row
+    vector<double> x(k);
+    while (readBlock(in, cols, b)) {
+        lineOf.clear();
+        for (int s = 0; s < k; s++) column[s].resize(b.numRows);
+        for (int r = 0; r < b.numRows; r++) {
+            if (!parseRow(b, r, cols, numCols, x.data())) continue;
+            for (int s = 0; s < k; s++) column[s][lineOf.size()] = x[s];
+            lineOf.push_back(r);
+        }
+        int n = lineOf.size();
+
+        for (int m = 0; m < M; m++) {
+            vector<vector<double>> &out = M > 1 ? work : column;
+            for (int s = 0; s < k; s++) {
+                out[s].resize(n);
+                applyAffine(column[s].data(), out[s].data(), n, affine[m][s]);
+            }
+
+            CsvWriter &w = *outs[m];
+            for (int i = 0; i < n; i++) {
+                int r = lineOf[i];
+                bool keep = preview[m].size() < 5;
+                if (keep) preview[m].emplace_back();
+                for (int c = 0; c < cols; c++) {
+                    if (slot[c] >= 0) {
+                        w.cell(out[slot[c]][i]);
+                    } else {
+                        size_t f = (size_t)r * cols + c;
+                        w.cell(b.lines[r].data() + b.start[f], b.end[f] - b.start[f]);
+                    }
+                    if (keep) preview[m].back().push_back(w.lastCell());
+                }
+                w.endRow();
+            }
         }
     }
-    out.close();
-    cout << "Normalized data saved to '" << outFile << "'\n";
 }
 
 // Print preview of first 5 rows
@@ -254,11 +484,9 @@ int main() {
         return 1;
     }
 
+    // Only the header is read here; the data is streamed twice below
     vector<string> header;
-    vector<vector<string>> rows;
     string line;
-
-    // Read header
     if (getline(file, line)) {
         stringstream ss(line);
         string cell;
@@ -266,17 +494,6 @@ int main() {
             header.push_back(cell);
         }
     }
-
-    // Read rows
-    while (getline(file, line)) {
-        stringstream ss(line);
-        string cell;
-        vector<string> row;
-        while (getline(ss, cell, ',')) {
-            row.push_back(cell);
-        }
-        rows.push_back(row);
-    }
     file.close();
 
     // Ask user which columns to normalize
@@ -304,6 +521,8 @@ int main() {
         cout << "No valid columns selected. Exiting.\n";
         return 1;
     }
+    sort(numCols.begin(), numCols.end());
+    numCols.erase(unique(numCols.begin(), numCols.end()), numCols.end());
 
     // Choose normalization method
     int choice;
@@ -315,24 +534,33 @@ int main() {
     cout << "Enter choice (1/2/3/4): ";
     cin >> choice;
 
-    if (choice >= 1 && choice <= 3) {
-        auto normalizedRows = applyNormalization(choice, header, rows, numCols);
-        printPreview(header, normalizedRows, "Normalized Data");
-        
-        string outFile;
-        if (choice == 1) outFile = "minmax_normalized.csv";
-        else if (choice == 2) outFile = "zscore_normalized.csv";
-        else if (choice == 3) outFile = "decimalscaling_normalized.csv";
-
-        saveCSV(header, normalizedRows, outFile);
-    } 
-    else if (choice == 4) {
-        vector<string> titles = {"Min-Max Normalization", "Z-Score Normalization", "Decimal Scaling Normalization"};
-        vector<string> outFiles = {"minmax_normalized.csv", "zscore_normalized.csv", "decimalscaling_normalized.csv"};
+    if (choice >= 1 && choice <= 4) {
+        vector<int> methods;
+        vector<string> titles, outFiles;
+        vector<string> allTitles = {"Min-Max Normalization", "Z-Score Normalization", "Decimal Scaling Normalization"};
+        vector<string> allFiles = {"minmax_normalized.csv", "zscore_normalized.csv", "decimalscaling_normalized.csv"};
         for (int m = 1; m <= 3; m++) {
-            auto normalizedRows = applyNormalization(m, header, rows, numCols);
-            printPreview(header, normalizedRows, titles[m-1]);
-            saveCSV(header, normalizedRows, outFiles[m-1]);
+            if (choice != 4 && choice != m) continue;
+            methods.push_back(m);
+            titles.push_back(choice == 4 ? allTitles[m - 1] : "Normalized Data");
+            outFiles.push_back(allFiles[m - 1]);
+        }
+
+        // One read pass for the statistics, one read + write pass for all methods
+        long long skipped = 0;
+        ColumnStats stats = scanStats(fileName, header.size(), numCols, skipped);
+        if (skipped)
+            cout << "\nSkipped " << skipped << " row(s) with an empty or non-numeric value in a selected column.\n";
+        if (stats.n == 0) {
+            cout << "No rows with numeric values in the selected columns. Exiting.\n";
+            return 1;
+        }
+        vector<vector<vector<string>>> preview;
+        writeNormalized(fileName, header, numCols, stats, methods, outFiles, preview);
+
+        for (int m = 0; m < (int)methods.size(); m++) {
+            printPreview(header, preview[m], titles[m]);
+            cout << "Normalized data saved to '" << outFiles[m] << "'\n";
         }
     } 
     else {
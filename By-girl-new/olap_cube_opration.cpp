@@ -1,101 +1,352 @@
 #include <bits/stdc++.h>
 using namespace std;
 
-// Read CSV
-vector<map<string,string>> readCSV(string fileName, vector<string> &header){
-    vector<map<string,string>> data;
-    ifstream file(fileName);
-    if(!file.is_open()){
-        cout << "Error opening file!" << endl;
-        return data;
+// ---------- Columnar Fact Table ----------
+// Copy of the fact table, selection and aggregation code (through pivotSums)
+// in By-vaibhav-new/2.olap/olap.cpp, which documents it. Each program is
+// built on its own, so fix both copies together.
+const size_t OLAP_PARALLEL_ROWS = 1 << 20;
+const uint32_t NO_CODE = UINT32_MAX;
+
+struct FactTable {
+    vector<string> header;
+    size_t rows = 0;
+    vector<char> isMeasure;
+    vector<int> decimals;               // measures: digits after the point
+    vector<vector<double>> measure;     // measures only
+    vector<vector<uint32_t>> code;      // dimensions (and encoded measures)
+    vector<vector<string>> dict;
+
+    int column(const string &name) const {
+        for (size_t c = 0; c < header.size(); c++)
+            if (header[c] == name) return c;
+        return -1;
+    }
+
+    void ensureCodes(int c) {
+        if (!code[c].empty() || rows == 0) return;
+        unordered_map<double, uint32_t> ids;
+        code[c].resize(rows);
+        for (size_t r = 0; r < rows; r++) {
+            auto it = ids.emplace(measure[c][r], dict[c].size());
+            if (it.second) dict[c].push_back(formatNumber(measure[c][r], decimals[c]));
+            code[c][r] = it.first->second;
+        }
     }
 
+    string text(int c, size_t r) const {
+        return code[c].empty() ? formatNumber(measure[c][r], decimals[c]) : dict[c][code[c][r]];
+    }
+
+    static string formatNumber(double v, int decimals) {
+        char buf[400];
+        auto res = to_chars(buf, buf + sizeof(buf), v, chars_format::fixed, decimals);
+        return string(buf, res.ptr);
+    }
+};
+
+bool parseNumber(const string &s, double &v) {
+    const char *b = s.data(), *e = b + s.size();
+    while (b < e && *b == ' ') b++;
+    while (e > b && e[-1] == ' ') e--;
+    if (b < e && *b == '+') b++;
+    if (b == e) return false;
+    auto r = from_chars(b, e, v);
+    return r.ec == errc() && r.ptr == e;
+}
+
+void splitLine(const string &line, size_t columns, vector<string> &cells) {
+    cells.assign(columns, string());
+    size_t c = 0, start = 0;
+    while (c < columns) {
+        size_t comma = line.find(',', start);
+        cells[c++].assign(line, start, comma == string::npos ? string::npos : comma - start);
+        if (comma == string::npos) break;
+        start = comma + 1;
+    }
+}
+
+bool loadFactTable(const string &fileName, FactTable &t) {
+    ifstream file(fileName);
+    if (!file.is_open()) return false;
     string line;
-    if(getline(file, line)){
-        stringstream ss(line);
-        string token;
-        while(getline(ss, token, ',')) header.push_back(token);
-    }
-
-    while(getline(file, line)){
-        stringstream ss(line);
-        string token;
-        map<string,string> row;
-        int i = 0;
-        while(getline(ss, token, ',')){
-            if(i < header.size()) row[header[i]] = token;
-            i++;
+    if (!getline(file, line)) return true;
+    if (!line.empty() && line.back() == '\r') line.pop_back();
+    stringstream ss(line);
+    string col;
+    while (getline(ss, col, ',')) t.header.push_back(col);
+    size_t m = t.header.size();
+
+    vector<string> cells;
+    vector<char> numeric(m, 1), exact(m, 1);
+    vector<int> decimals(m, -1);
+    double v;
+    size_t rows = 0;
+    while (getline(file, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty()) continue;
+        splitLine(line, m, cells);
+        for (size_t c = 0; c < m; c++) {
+            if (!numeric[c]) continue;
+            if (!parseNumber(cells[c], v)) {
+                numeric[c] = 0;
+                continue;
+            }
+            if (!exact[c]) continue;
+            size_t dot = cells[c].find('.');
+            int d = dot == string::npos ? 0 : cells[c].size() - dot - 1;
+            if (decimals[c] < 0) decimals[c] = d;
+            exact[c] = d == decimals[c] && d <= 30 && FactTable::formatNumber(v, d) == cells[c];
+        }
+        rows++;
+    }
+
+    t.rows = rows;
+    t.isMeasure = numeric;
+    t.decimals = decimals;
+    t.measure.assign(m, vector<double>());
+    t.code.assign(m, vector<uint32_t>());
+    t.dict.assign(m, vector<string>());
+    vector<unordered_map<string, uint32_t>> ids(m);
+    for (size_t c = 0; c < m; c++) {
+        if (numeric[c]) t.measure[c].reserve(rows);
+        if (!numeric[c] || !exact[c]) t.code[c].reserve(rows);
+    }
+    file.clear();
+    file.seekg(0);
+    getline(file, line);
+    while (getline(file, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty()) continue;
+        splitLine(line, m, cells);
+        for (size_t c = 0; c < m; c++) {
+            if (numeric[c]) {
+                parseNumber(cells[c], v);
+                t.measure[c].push_back(v);
+            }
+            if (!numeric[c] || !exact[c]) {
+                auto it = ids[c].emplace(cells[c], t.dict[c].size());
+                if (it.second) t.dict[c].push_back(cells[c]);
+                t.code[c].push_back(it.first->second);
+            }
+        }
+    }
+    return true;
+}
+
+template <class Fn>
+int parallelRows(size_t rows, Fn fn) {
+    int threads = rows < OLAP_PARALLEL_ROWS ? 1 : max(1, (int)thread::hardware_concurrency());
+    vector<thread> pool;
+    for (int t = 0; t < threads; t++) {
+        size_t b = rows * t / threads, e = rows * (t + 1) / threads;
+        if (t + 1 < threads) pool.emplace_back([=] { fn(t, b, e); });
+        else fn(t, b, e);
+    }
+    for (thread &th : pool) th.join();
+    return threads;
+}
+
+// ---------- Selection ----------
+struct Condition {
+    int col = -1;
+    uint32_t code = NO_CODE;
+    double number = 0;
+    bool never = false;
+};
+
+bool makeCondition(const FactTable &t, const string &field, const string &value, Condition &cond) {
+    cond.col = t.column(field);
+    if (cond.col < 0) {
+        cout << "Unknown field: " << field << endl;
+        return false;
+    }
+    if (t.isMeasure[cond.col]) {
+        cond.never = !parseNumber(value, cond.number);
+    } else {
+        const vector<string> &d = t.dict[cond.col];
+        auto it = find(d.begin(), d.end(), value);
+        cond.code = it - d.begin();
+        cond.never = it == d.end();
+    }
+    return true;
+}
+
+vector<uint32_t> selectRows(const FactTable &t, const vector<Condition> &conds) {
+    for (const Condition &c : conds)
+        if (c.never) return {};
+    vector<vector<uint32_t>> part(max(1, (int)thread::hardware_concurrency()));
+    int blocks = parallelRows(t.rows, [&](int th, size_t b, size_t e) {
+        vector<uint32_t> &sel = part[th];
+        for (size_t k = 0; k < conds.size(); k++) {
+            const Condition &c = conds[k];
+            size_t kept = 0;
+            if (t.isMeasure[c.col]) {
+                const double *x = t.measure[c.col].data();
+                if (k == 0) {
+                    for (size_t r = b; r < e; r++)
+                        if (x[r] == c.number) sel.push_back(r);
+                } else {
+                    for (uint32_t r : sel)
+                        if (x[r] == c.number) sel[kept++] = r;
+                    sel.resize(kept);
+                }
+            } else {
+                const uint32_t *x = t.code[c.col].data();
+                if (k == 0) {
+                    for (size_t r = b; r < e; r++)
+                        if (x[r] == c.code) sel.push_back(r);
+                } else {
+                    for (uint32_t r : sel)
+                        if (x[r] == c.code) sel[kept++] = r;
+                    sel.resize(kept);
+                }
+            }
         }
-        data.push_back(row);
+        if (conds.empty())
+            for (size_t r = b; r < e; r++) sel.push_back(r);
+    });
+    vector<uint32_t> rows = move(part[0]);
+    for (int th = 1; th < blocks; th++) rows.insert(rows.end(), part[th].begin(), part[th].end());
+    return rows;
+}
+
+// ---------- Aggregation ----------
+vector<pair<string, double>> groupSums(FactTable &t, int groupCol, int numCol) {
+    t.ensureCodes(groupCol);
+    size_t groups = t.dict[groupCol].size();
+    vector<vector<double>> part(max(1, (int)thread::hardware_concurrency()));
+    int blocks = parallelRows(t.rows, [&](int th, size_t b, size_t e) {
+        vector<double> &sum = part[th];
+        sum.assign(groups, 0.0);
+        const uint32_t *g = t.code[groupCol].data();
+        const double *x = t.measure[numCol].data();
+        for (size_t r = b; r < e; r++) sum[g[r]] += x[r];
+    });
+    vector<pair<string, double>> out;
+    for (size_t k = 0; k < groups; k++) {
+        double s = 0;
+        for (int th = 0; th < blocks; th++) s += part[th][k];
+        out.push_back({t.dict[groupCol][k], s});
     }
-    return data;
+    sort(out.begin(), out.end(), [](const pair<string, double> &a, const pair<string, double> &b) {
+        return a.first < b.first;
+    });
+    return out;
+}
+
+const size_t PIVOT_MAX_CELLS = 1 << 24;
+
+bool pivotSums(FactTable &t, int rowCol, int colCol, int numCol, vector<string> &rowLabels,
+               vector<string> &colLabels, vector<double> &cells) {
+    t.ensureCodes(rowCol);
+    t.ensureCodes(colCol);
+    size_t nr = t.dict[rowCol].size(), nc = t.dict[colCol].size();
+    if (nr * nc > PIVOT_MAX_CELLS) return false;
+    vector<vector<double>> part(max(1, (int)thread::hardware_concurrency()));
+    int blocks = parallelRows(t.rows, [&](int th, size_t b, size_t e) {
+        vector<double> &sum = part[th];
+        sum.assign(nr * nc, 0.0);
+        const uint32_t *rc = t.code[rowCol].data(), *cc = t.code[colCol].data();
+        const double *x = t.measure[numCol].data();
+        for (size_t r = b; r < e; r++) sum[(size_t)rc[r] * nc + cc[r]] += x[r];
+    });
+
+    auto sortedOrder = [](const vector<string> &d) {
+        vector<uint32_t> order(d.size());
+        iota(order.begin(), order.end(), 0);
+        sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return d[a] < d[b]; });
+        return order;
+    };
+    vector<uint32_t> ro = sortedOrder(t.dict[rowCol]), co = sortedOrder(t.dict[colCol]);
+    rowLabels.clear();
+    colLabels.clear();
+    for (uint32_t k : ro) rowLabels.push_back(t.dict[rowCol][k]);
+    for (uint32_t k : co) colLabels.push_back(t.dict[colCol][k]);
+    cells.assign(nr * nc, 0.0);
+    for (size_t i = 0; i < nr; i++)
+        for (size_t j = 0; j < nc; j++)
+            for (int th = 0; th < blocks; th++) cells[i * nc + j] += part[th][(size_t)ro[i] * nc + co[j]];
+    return true;
 }
 
 // Print a row
-void printRow(map<string,string> &row, vector<string> &header){
-    for(auto &h: header)
-        cout << row[h] << " | ";
-    cout << endl;
+void printRow(const FactTable &t, size_t r){
+    for(size_t c = 0; c < t.header.size(); c++)
+        cout << t.text(c, r) << " | ";
+    cout << '\n';
 }
 
 // Slice1
-void slice1(vector<map<string,string>> &data, string field, string value, vector<string> &header){
+void slice1(const FactTable &t, string field, string value){
+    Condition cond;
+    if(!makeCondition(t, field, value, cond)) return;
     cout << "\nResult:\n";
-    for(auto &row : data)
-        if(row[field] == value) printRow(row, header);
+    for(uint32_t r : selectRows(t, {cond})) printRow(t, r);
 }
 
 // Dice
-void dice(vector<map<string,string>> &data, map<string,string> &filters, vector<string> &header){
-    cout << "\nResult:\n";
-    for(auto &row : data){
-        bool ok = true;
-        for(auto &f : filters)
-            if(row[f.first] != f.second){ ok = false; break; }
-        if(ok) printRow(row, header);
+void dice(const FactTable &t, map<string,string> &filters){
+    vector<Condition> conds;
+    for(auto &f : filters){
+        Condition cond;
+        if(!makeCondition(t, f.first, f.second, cond)) return;
+        conds.push_back(cond);
     }
+    cout << "\nResult:\n";
+    for(uint32_t r : selectRows(t, conds)) printRow(t, r);
 }
 
 // Roll-Up
-void rollup(vector<map<string,string>> &data, string groupField, string numField){
-    cout << "\nResult:\n";
-    map<string,double> sum;
-    for(auto &row : data){
-        sum[row[groupField]] += stod(row[numField]);
+void rollup(FactTable &t, string groupField, string numField){
+    int g = t.column(groupField), x = t.column(numField);
+    if(g < 0 || x < 0){
+        cout << "Unknown field: " << (g < 0 ? groupField : numField) << endl;
+        return;
+    }
+    if(!t.isMeasure[x]){
+        cout << "Column not numeric!\n";
+        return;
     }
-    for(auto &p : sum)
+    cout << "\nResult:\n";
+    for(auto &p : groupSums(t, g, x))
         cout << p.first << " -> " << p.second << endl;
 }
 
 // Drill-Down
-void drilldown(vector<map<string,string>> &data, vector<string> &header){
+void drilldown(const FactTable &t){
     cout << "\nFull Data:\n";
-    for(auto &row : data) printRow(row, header);
+    for(size_t r = 0; r < t.rows; r++) printRow(t, r);
 }
 
 // Pivot
-void pivot(vector<map<string,string>> &data, string rowField, string colField, string numField){
+void pivot(FactTable &t, string rowField, string colField, string numField){
+    int rf = t.column(rowField), cf = t.column(colField), x = t.column(numField);
+    if(rf < 0 || cf < 0 || x < 0){
+        cout << "Unknown field: " << (rf < 0 ? rowField : cf < 0 ? colField : numField) << endl;
+        return;
+    }
+    if(!t.isMeasure[x]){
+        cout << "Column not numeric!\n";
+        return;
+    }
     cout << "\nPivot Result:\n";
 
-    set<string> colVals;
-    map<string,map<string,double>> table;
-
-    for(auto &row : data){
-        string r = row[rowField];
-        string c = row[colField];
-        double val = stod(row[numField]);
-        colVals.insert(c);
-        table[r][c] += val;
+    vector<string> rowVals, colVals;
+    vector<double> table;
+    if(!pivotSums(t, rf, cf, x, rowVals, colVals, table)){
+        cout << "Too many cells to pivot; slice or dice first.\n";
+        return;
     }
 
     cout << rowField << "\t";
     for(auto &c: colVals) cout << c << "\t";
     cout << "\n";
 
-    for(auto &r : table){
-        cout << r.first << "\t";
-        for(auto &c : colVals)
-            cout << r.second[c] << "\t";
+    for(size_t i = 0; i < rowVals.size(); i++){
+        cout << rowVals[i] << "\t";
+        for(size_t j = 0; j < colVals.size(); j++)
+            cout << table[i * colVals.size() + j] << "\t";
         cout << "\n";
     }
 }
@@ -105,14 +356,13 @@ int main(){
     cout << "Enter CSV file name (example: sales.csv): ";
     cin >> file;
 
-    vector<string> header;
-    vector<map<string,string>> data = readCSV(file, header);
+    FactTable data;
+    if(!loadFactTable(file, data)) cout << "Error opening file!" << endl;
 
-    if(data.empty()){
+    if(data.rows == 0){
         cout << "No Data Found!\n";
         return 0;
     }
-
     int ch;
     while(true){
         cout << "\n--- OLAP MENU ---\n"
@@ -127,14 +377,14 @@ int main(){
         cin >> ch;
 
         if(ch == 1){
-            drilldown(data, header);
+            drilldown(data);
 
         } else if(ch == 2){
             cout << "\nExample Input:\nField: Region\nValue: North\n";
             string f,v;
             cout << "Field: "; cin >> f;
             cout << "Value: "; cin >> v;
-            slice1(data, f, v, header);
+            slice1(data, f, v);
 
         } else if(ch == 3){
             cout << "\nExample: Region = North AND Product = TV\n";
@@ -146,7 +396,7 @@ int main(){
                 cout << "Value: "; cin >> v;
                 filters[f] = v;
             }
-            dice(data, filters, header);
+            dice(data, filters);
 
         } else if(ch == 4){
             cout << "\nExample: Group by = Region, Numeric = Sales\n";
@@ -156,7 +406,7 @@ int main(){
             rollup(data, g, nf);
 
         } else if(ch == 5){
-            drilldown(data, header);
+            drilldown(data);
 
         } else if(ch == 6){
             cout << "\nExample: Row=Region, Column=Month, Numeric=Sales\n";
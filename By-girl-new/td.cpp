@@ -5,8 +5,63 @@
 #include <vector>
 #include <map>
 #include <algorithm>
+#include <string>
+#include <charconv>
 using namespace std;
 
+// ---------- Buffered CSV Writer ----------
+// Copy of the CsvWriter in By-girl-new/normal.cpp, trimmed to the calls
+// this program makes.
+class CsvWriter {
+public:
+    explicit CsvWriter(const string &filename, size_t bufferSize = 1 << 20)
+        : out(filename), limit(bufferSize) {
+        buf.reserve(bufferSize + 4096);
+    }
+    ~CsvWriter() { flush(); }
+
+    CsvWriter &fixed(int digits) { fmt = chars_format::fixed; precision = digits; return *this; }
+
+    CsvWriter &cell(const string &s) { sep(); buf += s; return *this; }
+    CsvWriter &cell(double v) {
+        sep();
+        char tmp[400];
+        buf.append(tmp, to_chars(tmp, tmp + sizeof(tmp), v, fmt, precision).ptr);
+        return *this;
+    }
+
+    // Appends text to the current cell (e.g. a "%" after a number)
+    CsvWriter &raw(const string &s) { buf += s; return *this; }
+
+    CsvWriter &endRow() {
+        buf += '\n';
+        first = true;
+        if (buf.size() >= limit) {
+            out.write(buf.data(), buf.size());
+            buf.clear();
+        }
+        return *this;
+    }
+
+    void flush() {
+        if (!buf.empty()) out.write(buf.data(), buf.size());
+        buf.clear();
+        out.flush();
+    }
+
+private:
+    ofstream out;
+    string buf;
+    size_t limit;
+    bool first = true;
+    chars_format fmt = chars_format::general;
+    int precision = 6;
+
+    void sep() {
+        if (!first) buf += ',';
+        first = false;
+    }
+};
 
 string trim(const string &s) {
     size_t start = s.find_first_not_of(" \t\r\n");
@@ -73,42 +128,35 @@ int main() {
     }
 
    
-    ofstream out(outputFile);
-    out << headers[0];
+    CsvWriter out(outputFile);
+    out.fixed(2);
+    out.cell(headers[0]);
     for(size_t i=1;i<headers.size();i++)
-        out << "," << headers[i] << " Value," << headers[i] << " t-weight," << headers[i] << " d-weight";
-    out << ",Row Total,Row t-weight,Row d-weight\n";
+        out.cell(headers[i] + " Value").cell(headers[i] + " t-weight").cell(headers[i] + " d-weight");
+    out.cell("Row Total").cell("Row t-weight").cell("Row d-weight").endRow();
 
     for(auto &r: data){
-        out << r.first;
+        out.cell(r.first);
         for(size_t i=1;i<headers.size();i++){
             string col = headers[i];
             double val = r.second[col];
             double t = rowTotals[r.first]==0 ? 0 : val/rowTotals[r.first]*100;
             double d = colTotals[col]==0 ? 0 : val/colTotals[col]*100;
-            out << "," << fixed << setprecision(2) << val
-                << "," << fixed << setprecision(2) << t << "%"
-                << "," << fixed << setprecision(2) << d << "%";
+            out.cell(val).cell(t).raw("%").cell(d).raw("%");
         }
-        out << "," << fixed << setprecision(2) << rowTotals[r.first]
-            << "," << "100.00%"
-            << "," << fixed << setprecision(2) << rowTotals[r.first]/grandTotal*100 << "%" << endl;
+        out.cell(rowTotals[r.first]).cell("100.00%").cell(rowTotals[r.first]/grandTotal*100).raw("%").endRow();
     }
 
-    out << "Total";
+    out.cell("Total");
     for(size_t i=1;i<headers.size();i++){
         string col = headers[i];
         double val = colTotals[col];
         double t = val/grandTotal*100;
-        out << "," << fixed << setprecision(2) << val
-            << "," << fixed << setprecision(2) << t << "%"
-            << "," << "100.00%";
+        out.cell(val).cell(t).raw("%").cell("100.00%");
     }
-    out << "," << fixed << setprecision(2) << grandTotal
-        << "," << "100.00%"
-        << "," << "100.00%" << endl;
+    out.cell(grandTotal).cell("100.00%").cell("100.00%").endRow();
 
-    out.close();
+    out.flush();
     cout << "✅ " << outputFile << " is created successfully!\n";
     return 0;
 }
@@ -6,6 +6,9 @@
 #include <climits>
 #include <iomanip>
 #include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <algorithm>
 using namespace std;
 
 // ---------- Read CSV ----------
@@ -31,58 +34,78 @@ vector<vector<string>> read_csv(string &filename) {
     return data;
 }
 
-// ---------- Min-Max Normalization ----------
-vector<vector<double>> minMaxNormalize(vector<vector<double>> &data, double newMin, double newMax) {
+// ---------- Normalization Parameters ----------
+// Fitted once from the training file; the in-memory normalization and the
+// streaming transform of new files both scale values through these.
+struct NormParams {
+    vector<string> header;
+    vector<double> minVal, maxVal, mean, stddev;
+    vector<int> exponent;                    // decimal exponent k of each column
+    double newMin = 0, newMax = 1;
+
+    double minMaxValue(int j, double x) const {
+        if (maxVal[j] != minVal[j])
+            return (x - minVal[j]) / (maxVal[j] - minVal[j]) * (newMax - newMin) + newMin;
+        return 0;
+    }
+    double zScoreValue(int j, double x) const {
+        return stddev[j] != 0 ? (x - mean[j]) / stddev[j] : 0;
+    }
+};
+
+NormParams fitParams(vector<vector<double>> &data, vector<string> &header, double newMin, double newMax) {
     int rows = data.size();
     int cols = data[0].size();
 
-    vector<double> minVal(cols, INT_MAX), maxVal(cols, INT_MIN);
+    NormParams p;
+    p.header = header;
+    p.newMin = newMin;
+    p.newMax = newMax;
+    p.minVal.assign(cols, INT_MAX);
+    p.maxVal.assign(cols, INT_MIN);
+    p.mean.assign(cols, 0);
+    p.stddev.assign(cols, 0);
+    p.exponent.assign(cols, 1);
 
     for (int j = 0; j < cols; j++) {
+        double sum = 0, maxAbs = 0;
         for (int i = 0; i < rows; i++) {
-            if (data[i][j] < minVal[j]) minVal[j] = data[i][j];
-            if (data[i][j] > maxVal[j]) maxVal[j] = data[i][j];
+            if (data[i][j] < p.minVal[j]) p.minVal[j] = data[i][j];
+            if (data[i][j] > p.maxVal[j]) p.maxVal[j] = data[i][j];
+            maxAbs = max(maxAbs, fabs(data[i][j]));
+            sum += data[i][j];
         }
+        p.mean[j] = sum / rows;
+
+        double sq_sum = 0;
+        for (int i = 0; i < rows; i++) sq_sum += pow(data[i][j] - p.mean[j], 2);
+        p.stddev[j] = sqrt(sq_sum / rows);
+        if (maxAbs != 0) p.exponent[j] = ceil(log10(maxAbs + 1));
     }
+    return p;
+}
+
+// ---------- Min-Max Normalization ----------
+vector<vector<double>> minMaxNormalize(vector<vector<double>> &data, NormParams &p) {
+    int rows = data.size();
+    int cols = data[0].size();
 
     vector<vector<double>> normalized(rows, vector<double>(cols, 0));
-    for (int i = 0; i < rows; i++) {
-        for (int j = 0; j < cols; j++) {
-            if (maxVal[j] != minVal[j])
-                normalized[i][j] = (data[i][j] - minVal[j]) / (maxVal[j] - minVal[j]) * (newMax - newMin) + newMin;
-            else
-                normalized[i][j] = 0;
-        }
-    }
+    for (int i = 0; i < rows; i++)
+        for (int j = 0; j < cols; j++)
+            normalized[i][j] = p.minMaxValue(j, data[i][j]);
     return normalized;
 }
 
 // ---------- Z-Score Normalization ----------
-vector<vector<double>> zScoreNormalize(vector<vector<double>> &data) {
+vector<vector<double>> zScoreNormalize(vector<vector<double>> &data, NormParams &p) {
     int rows = data.size();
     int cols = data[0].size();
 
-    vector<double> mean(cols, 0), stddev(cols, 0);
-
-    for (int j = 0; j < cols; j++) {
-        double sum = 0;
-        for (int i = 0; i < rows; i++) sum += data[i][j];
-        mean[j] = sum / rows;
-
-        double sq_sum = 0;
-        for (int i = 0; i < rows; i++) sq_sum += pow(data[i][j] - mean[j], 2);
-        stddev[j] = sqrt(sq_sum / rows);
-    }
-
     vector<vector<double>> normalized(rows, vector<double>(cols, 0));
-    for (int i = 0; i < rows; i++) {
-        for (int j = 0; j < cols; j++) {
-            if (stddev[j] != 0)
-                normalized[i][j] = (data[i][j] - mean[j]) / stddev[j];
-            else
-                normalized[i][j] = 0;
-        }
-    }
+    for (int i = 0; i < rows; i++)
+        for (int j = 0; j < cols; j++)
+            normalized[i][j] = p.zScoreValue(j, data[i][j]);
     return normalized;
 }
 
@@ -107,8 +130,179 @@ void write_csv(string filename, vector<vector<string>> &header, vector<vector<do
     output.close();
 }
 
+// ---------- Parameter File ----------
+// Binary .nrm file: magic, column names, per column min/max/mean/stddev and
+// decimal exponent, the Min-Max range and the fitted methods (bit 0 Min-Max,
+// bit 1 Z-Score, bit 2 decimal scaling). Same layout as Normaliozation.cpp.
+const char NRM_MAGIC[4] = {'N', 'R', 'M', '1'};
+const string PARAM_FILE = "normalization_params.nrm";
+
+template <class T> void writePod(ostream &out, const T &x) { out.write((const char *)&x, sizeof(T)); }
+template <class T> bool readPod(istream &in, T &x) { return (bool)in.read((char *)&x, sizeof(T)); }
+
+void writeString(ostream &out, const string &s) {
+    writePod(out, (uint32_t)s.size());
+    out.write(s.data(), s.size());
+}
+
+bool readString(istream &in, string &s) {
+    uint32_t n;
+    if (!readPod(in, n)) return false;
+    s.resize(n);
+    return (bool)in.read(&s[0], n);
+}
+
+bool save_params(NormParams &p, const string &filename) {
+    ofstream out(filename, ios::binary);
+    if (!out.is_open()) return false;
+    out.write(NRM_MAGIC, 4);
+    size_t cols = p.mean.size();
+    writePod(out, (uint32_t)cols);
+    writePod(out, (uint8_t)(p.header.size() == cols));
+    if (p.header.size() == cols)
+        for (auto &h : p.header) writeString(out, h);
+    for (size_t j = 0; j < cols; j++) {
+        writePod(out, p.minVal[j]);
+        writePod(out, p.maxVal[j]);
+        writePod(out, p.mean[j]);
+        writePod(out, p.stddev[j]);
+        writePod(out, (int32_t)p.exponent[j]);
+    }
+    writePod(out, p.newMin);
+    writePod(out, p.newMax);
+    writePod(out, (uint8_t)3);               // Min-Max and Z-Score
+    return (bool)out;
+}
+
+bool is_param_file(const string &filename) {
+    ifstream in(filename, ios::binary);
+    char magic[4];
+    return in.read(magic, 4) && equal(magic, magic + 4, NRM_MAGIC);
+}
+
+bool load_params(NormParams &p, const string &filename) {
+    ifstream in(filename, ios::binary);
+    char magic[4];
+    if (!in.read(magic, 4) || !equal(magic, magic + 4, NRM_MAGIC)) return false;
+    uint32_t cols;
+    uint8_t hasHeader, methods;
+    if (!readPod(in, cols) || !readPod(in, hasHeader)) return false;
+    p.header.assign(hasHeader ? cols : 0, "");
+    for (auto &h : p.header)
+        if (!readString(in, h)) return false;
+    p.minVal.resize(cols);
+    p.maxVal.resize(cols);
+    p.mean.resize(cols);
+    p.stddev.resize(cols);
+    p.exponent.resize(cols);
+    for (uint32_t j = 0; j < cols; j++) {
+        int32_t k;
+        if (!readPod(in, p.minVal[j]) || !readPod(in, p.maxVal[j]) || !readPod(in, p.mean[j]) ||
+            !readPod(in, p.stddev[j]) || !readPod(in, k))
+            return false;
+        p.exponent[j] = k;
+    }
+    return readPod(in, p.newMin) && readPod(in, p.newMax) && readPod(in, methods);
+}
+
+// ---------- Streaming Transform ----------
+// Normalizes a new file with saved parameters in one pass: each line is
+// scaled and written to both output files as soon as it is read, so memory
+// does not grow with the file. The first line is the header, as in
+// read_csv, and must match the fitted header when one was saved. Rows with
+// a missing, extra or non-numeric cell are skipped and counted instead of
+// being written with made-up values. Returns -1 if nothing was transformed.
+long long transform_csv(string &filename, NormParams &p, string minmaxFile, string zscoreFile,
+                        long long &skipped) {
+    skipped = 0;
+    ifstream file(filename);
+    if (!file.is_open()) {
+        cout << "Error opening file!" << endl;
+        return -1;
+    }
+
+    string line;
+    if (!getline(file, line)) {
+        cout << "Empty file!" << endl;
+        return -1;
+    }
+    if (!line.empty() && line.back() == '\r') line.pop_back();
+    if (!p.header.empty()) {
+        vector<string> header;
+        stringstream ss(line);
+        string cell;
+        while (getline(ss, cell, ',')) header.push_back(cell);
+        vector<string> fitted = p.header;             // the training file may have had CRLF endings
+        if (!fitted.back().empty() && fitted.back().back() == '\r') fitted.back().pop_back();
+        if (header != fitted) {
+            cout << "Error: header of " << filename << " does not match the fitted columns (";
+            for (size_t j = 0; j < p.header.size(); j++) cout << (j ? "," : "") << p.header[j];
+            cout << ")." << endl;
+            return -1;
+        }
+    }
+
+    ofstream minmaxOut(minmaxFile), zscoreOut(zscoreFile);
+    minmaxOut << fixed << setprecision(2);
+    zscoreOut << fixed << setprecision(2);
+    minmaxOut << line << "\n";
+    zscoreOut << line << "\n";
+
+    int cols = p.mean.size();
+    long long rows = 0;
+    vector<double> x(cols);
+    while (getline(file, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        stringstream ss(line);
+        string cell;
+        bool ok = true;
+        for (int j = 0; j < cols && ok; j++) {
+            char *end = nullptr;
+            ok = getline(ss, cell, ',') && !cell.empty();
+            if (ok) x[j] = strtod(cell.c_str(), &end);
+            ok = ok && *end == '\0' && isfinite(x[j]);
+        }
+        if (!ok || getline(ss, cell, ',')) {
+            skipped++;
+            continue;
+        }
+        for (int j = 0; j < cols; j++) {
+            minmaxOut << p.minMaxValue(j, x[j]) << (j < cols - 1 ? "," : "\n");
+            zscoreOut << p.zScoreValue(j, x[j]) << (j < cols - 1 ? "," : "\n");
+        }
+        rows++;
+    }
+    return rows;
+}
+
 int main() {
-    string filename = "data.csv";
+    string filename;
+    cout << "Enter CSV file (e.g. data.csv) or saved .nrm parameter file: ";
+    if (!(cin >> filename)) filename = "data.csv";
+
+    // ----- Transform new data with saved parameters -----
+    if (is_param_file(filename)) {
+        NormParams p;
+        if (!load_params(p, filename)) {
+            cout << "Error reading " << filename << endl;
+            return 0;
+        }
+        string input, prefix;
+        cout << "Enter CSV file to transform: ";
+        cin >> input;
+        cout << "Enter output file prefix (e.g. day2_): ";
+        cin >> prefix;
+        long long skipped = 0;
+        long long rows = transform_csv(input, p, prefix + "normalized_minmax.csv", prefix + "normalized_zscore.csv",
+                                       skipped);
+        if (rows < 0) return 0;
+        cout << "✅ Transformed " << rows << " rows with saved parameters";
+        if (skipped) cout << " (" << skipped << " rows with missing or non-numeric cells skipped)";
+        cout << ".\n";
+        cout << "Files saved as '" << prefix << "normalized_minmax.csv' and '" << prefix << "normalized_zscore.csv'.\n";
+        return 0;
+    }
+
     vector<vector<string>> data = read_csv(filename);
 
     if (data.empty()) {
@@ -133,9 +327,10 @@ int main() {
         }
     }
 
-    // ----- Perform both normalizations -----
-    vector<vector<double>> minmax = minMaxNormalize(double_data, 0, 1);
-    vector<vector<double>> zscore = zScoreNormalize(double_data);
+    // ----- Fit parameters and perform both normalizations -----
+    NormParams params = fitParams(double_data, header, 0, 1);
+    vector<vector<double>> minmax = minMaxNormalize(double_data, params);
+    vector<vector<double>> zscore = zScoreNormalize(double_data, params);
 
     // ----- Write results -----
     vector<vector<string>> headerVec = { header };
@@ -145,5 +340,8 @@ int main() {
     cout << "✅ Min-Max and Z-Score normalization completed.\n";
     cout << "Files saved as 'normalized_minmax.csv' and 'normalized_zscore.csv'.\n";
 
+    if (save_params(params, PARAM_FILE))
+        cout << "Parameters saved as '" << PARAM_FILE << "' for transforming new files.\n";
+
     return 0;
 }
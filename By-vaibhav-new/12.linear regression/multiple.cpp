@@ -4,37 +4,605 @@
 #include <sstream>
 #include <vector>
 #include <iomanip>
+#include <algorithm>
+#include <thread>
+#include <cmath>
+#include <random>
+#include <chrono>
+#include <string>
+#include <charconv>
+#include <cstdint>
+#include <cstdio>
 using namespace std;
 
+// ---------- Dense Matrix ----------
+// Row-major matrix in one contiguous block: row i starts at data() + i * cols,
+// so a row is a plain array the compiler can vectorize over.
+struct Matrix {
+    int rows = 0, cols = 0;
+    vector<double> a;
+
+    Matrix() {}
+    Matrix(int r, int c, double v = 0) : rows(r), cols(c), a((size_t)r * c, v) {}
+
+    double *operator[](int i) { return a.data() + (size_t)i * cols; }
+    const double *operator[](int i) const { return a.data() + (size_t)i * cols; }
+    double *data() { return a.data(); }
+    const double *data() const { return a.data(); }
+};
+
+// ---------- Matrix Kernels ----------
+// C += A * B. Blocked over k and j: one GEMM_KB x GEMM_NB panel of B stays in
+// cache while every row of A streams past it, and the innermost loop runs
+// along a contiguous row of B and C (i-k-j order), so it vectorizes instead
+// of striding down a column of B.
+const int GEMM_KB = 128, GEMM_NB = 512;
+
+void gemm(const Matrix &A, const Matrix &B, Matrix &C) {
+    int r = A.rows, c = B.cols, k = A.cols;
+    for (int kk = 0; kk < k; kk += GEMM_KB) {
+        int kEnd = min(k, kk + GEMM_KB);
+        for (int jj = 0; jj < c; jj += GEMM_NB) {
+            int jEnd = min(c, jj + GEMM_NB);
+            for (int i = 0; i < r; ++i) {
+                const double *ai = A[i];
+                double *ci = C[i];
+                for (int t = kk; t < kEnd; ++t) {
+                    double at = ai[t];
+                    const double *bt = B[t];
+                    for (int j = jj; j < jEnd; ++j) ci[j] += at * bt[j];
+                }
+            }
+        }
+    }
+}
+
 // Function to multiply two matrices
-vector<vector<double>> multiply(const vector<vector<double>>& A, const vector<vector<double>>& B) {
-    int r = A.size(), c = B[0].size(), k = B.size();
-    vector<vector<double>> result(r, vector<double>(c, 0));
-    for (int i = 0; i < r; ++i)
-        for (int j = 0; j < c; ++j)
-            for (int t = 0; t < k; ++t)
-                result[i][j] += A[i][t] * B[t][j];
+Matrix multiply(const Matrix &A, const Matrix &B) {
+    Matrix result(A.rows, B.cols);
+    gemm(A, B, result);
     return result;
 }
 
-// Function to transpose a matrix
-vector<vector<double>> transpose(const vector<vector<double>>& A) {
-    int r = A.size(), c = A[0].size();
-    vector<vector<double>> T(c, vector<double>(r, 0));
-    for (int i = 0; i < r; ++i)
-        for (int j = 0; j < c; ++j)
-            T[j][i] = A[i][j];
-    return T;
+// Fused normal equations: adds X^T X (upper triangle only, SYRK) and X^T y
+// for n rows of X (row-major, p columns) without forming X^T. The kernel
+// works on 4 rows of X and 2 rows of G at a time: every x[j] loaded feeds
+// both G rows and every G element loaded takes four multiply-adds. The p x p
+// accumulator stays in cache while X streams through once.
+void gramAccumulate(const double *X, const double *y, size_t n, int p, double *G, double *g) {
+    size_t r = 0;
+    for (; r + 4 <= n; r += 4) {
+        const double *x0 = X + r * p, *x1 = x0 + p, *x2 = x1 + p, *x3 = x2 + p;
+        int i = 0;
+        for (; i + 2 <= p; i += 2) {
+            double a0 = x0[i], a1 = x1[i], a2 = x2[i], a3 = x3[i];
+            double b0 = x0[i + 1], b1 = x1[i + 1], b2 = x2[i + 1], b3 = x3[i + 1];
+            double *gi = G + (size_t)i * p, *gk = gi + p;
+            gi[i] += a0 * a0 + a1 * a1 + a2 * a2 + a3 * a3;
+            for (int j = i + 1; j < p; ++j) {
+                double v0 = x0[j], v1 = x1[j], v2 = x2[j], v3 = x3[j];
+                gi[j] += a0 * v0 + a1 * v1 + a2 * v2 + a3 * v3;
+                gk[j] += b0 * v0 + b1 * v1 + b2 * v2 + b3 * v3;
+            }
+            g[i] += a0 * y[r] + a1 * y[r + 1] + a2 * y[r + 2] + a3 * y[r + 3];
+            g[i + 1] += b0 * y[r] + b1 * y[r + 1] + b2 * y[r + 2] + b3 * y[r + 3];
+        }
+        for (; i < p; ++i) {
+            double a0 = x0[i], a1 = x1[i], a2 = x2[i], a3 = x3[i];
+            double *gi = G + (size_t)i * p;
+            for (int j = i; j < p; ++j) gi[j] += a0 * x0[j] + a1 * x1[j] + a2 * x2[j] + a3 * x3[j];
+            g[i] += a0 * y[r] + a1 * y[r + 1] + a2 * y[r + 2] + a3 * y[r + 3];
+        }
+    }
+    for (; r < n; ++r) {
+        const double *x = X + r * p;
+        for (int i = 0; i < p; ++i) {
+            double *gi = G + (size_t)i * p;
+            for (int j = i; j < p; ++j) gi[j] += x[i] * x[j];
+            g[i] += x[i] * y[r];
+        }
+    }
+}
+
+// ---------- Normal Equation Accumulator ----------
+// X^T X (upper triangle), X^T y and the row count of all rows added so far.
+// Single rows are buffered GRAM_BLOCK_ROWS at a time for gramAccumulate.
+// Two accumulators over different rows merge by adding, so every thread (or
+// every file) can fill its own and the results combine into the full fit.
+const size_t GRAM_BLOCK_ROWS = 256;
+
+struct GramStats {
+    int p = 0;
+    long long n = 0, skipped = 0;
+    Matrix G, g;
+    vector<double> blockX, blockY;   // rows not yet accumulated
+    vector<double> row;              // scratch for the reader
+
+    void init(int cols) {
+        p = cols;
+        n = skipped = 0;
+        G = Matrix(p, p);
+        g = Matrix(p, 1);
+        blockX.clear();
+        blockY.clear();
+    }
+
+    void flush() {
+        if (blockY.empty()) return;
+        gramAccumulate(blockX.data(), blockY.data(), blockY.size(), p, G.data(), g.data());
+        n += blockY.size();
+        blockX.clear();
+        blockY.clear();
+    }
+
+    void addRow(const double *x, double y) {
+        blockX.insert(blockX.end(), x, x + p);
+        blockY.push_back(y);
+        if (blockY.size() == GRAM_BLOCK_ROWS) flush();
+    }
+
+    void addRows(const double *X, const double *y, size_t rows) {
+        flush();
+        gramAccumulate(X, y, rows, p, G.data(), g.data());
+        n += rows;
+    }
+
+    void merge(const GramStats &o) {
+        for (size_t e = 0; e < G.a.size(); ++e) G.a[e] += o.G.a[e];
+        for (int i = 0; i < p; ++i) g.a[i] += o.g.a[i];
+        n += o.n;
+        skipped += o.skipped;
+        for (size_t r = 0; r < o.blockY.size(); ++r) addRow(o.blockX.data() + r * p, o.blockY[r]);
+    }
+
+    // Full X^T X (lower triangle mirrored) and X^T Y
+    void result(Matrix &XtX, Matrix &XtY) {
+        flush();
+        XtX = G;
+        for (int i = 0; i < p; ++i)
+            for (int j = 0; j < i; ++j) XtX[i][j] = XtX[j][i];
+        XtY = g;
+    }
+};
+
+// X^T X and X^T Y of a matrix in memory. Large inputs are split into one
+// contiguous block of rows per thread, each with its own accumulator; the
+// partial sums are added in block order.
+const size_t GRAM_PARALLEL_ROWS = 50000;
+
+void normalEquations(const Matrix &X, const vector<double> &Y, Matrix &XtX, Matrix &XtY) {
+    size_t n = X.rows;
+    int p = X.cols;
+    int threads = n < GRAM_PARALLEL_ROWS ? 1 : max(1, (int)thread::hardware_concurrency());
+    vector<GramStats> part(threads);
+    vector<thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        auto work = [&, t] {
+            size_t begin = n * t / threads, end = n * (t + 1) / threads;
+            part[t].init(p);
+            part[t].addRows(X.data() + begin * p, Y.data() + begin, end - begin);
+        };
+        if (t + 1 < threads) workers.emplace_back(work);
+        else work();
+    }
+    for (thread &w : workers) w.join();
+    for (int t = 1; t < threads; ++t) part[0].merge(part[t]);
+    part[0].result(XtX, XtY);
+}
+
+// ---------- Parallel Streaming Reader ----------
+// The data part of the file (after the header) is cut into one byte range
+// per thread. A thread seeks to its range, drops the line that started
+// before it (the previous range owns that one) and hands every line that
+// starts inside its range to onLine(acc, begin, end), reading through a
+// fixed 1 MB buffer. Each thread fills its own accumulator; they are merged
+// in file order. Memory use does not depend on the file size.
+// Regression.cpp and corelation.cpp carry copies of this reader.
+const long long STREAM_PARALLEL_BYTES = 1 << 22;
+
+template <class Acc, class LineFn>
+void streamRange(const string &filename, long long begin, long long end, Acc &acc, LineFn onLine) {
+    ifstream in(filename, ios::binary);
+    bool skipFirst = begin > 0;
+    in.seekg(skipFirst ? begin - 1 : begin);
+    long long pos = skipFirst ? begin - 1 : begin;    // file offset of buf[0]
+    long long lineStart = pos;
+    vector<char> buf(1 << 20);
+    string carry;
+    while (lineStart < end) {
+        in.read(buf.data(), buf.size());
+        size_t got = in.gcount();
+        if (got == 0) {
+            if (!carry.empty() && carry.back() == '\r') carry.pop_back();
+            if (!carry.empty() && !skipFirst) onLine(acc, carry.data(), carry.data() + carry.size());
+            break;
+        }
+        size_t from = 0;
+        for (size_t i = 0; i < got && lineStart < end; i++) {
+            if (buf[i] != '\n') continue;
+            const char *b = buf.data() + from, *e = buf.data() + i;
+            if (!carry.empty()) {
+                carry.append(b, e);
+                b = carry.data();
+                e = b + carry.size();
+            }
+            if (e > b && e[-1] == '\r') e--;
+            if (skipFirst) skipFirst = false;
+            else onLine(acc, b, e);
+            carry.clear();
+            from = i + 1;
+            lineStart = pos + i + 1;
+        }
+        if (lineStart < end) carry.append(buf.data() + from, buf.data() + got);
+        pos += got;
+    }
 }
 
-// Function to invert a 2x2 or 3x3 matrix (for small examples)
-vector<vector<double>> inverse(const vector<vector<double>>& A) {
-    int n = A.size();
-    vector<vector<double>> I(n, vector<double>(n, 0));
+template <class Acc, class LineFn>
+Acc streamCSV(const string &filename, long long dataStart, const Acc &empty, LineFn onLine) {
+    ifstream probe(filename, ios::binary | ios::ate);
+    long long size = probe.tellg();
+    long long bytes = max(0LL, size - dataStart);
+    int threads = bytes < STREAM_PARALLEL_BYTES ? 1 : max(1, (int)thread::hardware_concurrency());
+    vector<Acc> part(threads, empty);
+    vector<thread> workers;
+    for (int t = 0; t < threads; t++) {
+        auto work = [&, t] {
+            streamRange(filename, dataStart + bytes * t / threads, dataStart + bytes * (t + 1) / threads,
+                        part[t], onLine);
+        };
+        if (t + 1 < threads) workers.emplace_back(work);
+        else work();
+    }
+    for (thread &w : workers) w.join();
+    for (int t = 1; t < threads; t++) part[0].merge(part[t]);
+    return part[0];
+}
+
+// One CSV line as numbers: stod-style cells, at least one character each.
+// Returns false for an empty line or a cell that is not a number.
+bool parseRow(const char *b, const char *e, vector<double> &row) {
+    row.clear();
+    if (b == e) return false;
+    string cell;
+    for (const char *c = b;; ) {
+        const char *comma = find(c, e, ',');
+        cell.assign(c, comma);
+        char *stop;
+        double v = strtod(cell.c_str(), &stop);
+        if (stop == cell.c_str()) return false;
+        row.push_back(v);
+        if (comma == e) break;
+        c = comma + 1;
+    }
+    return true;
+}
+
+// ---------- Coefficient File ----------
+// Binary .rgm file: magic, target name, feature names and the coefficients
+// (intercept first). Regression.cpp and multiple.cpp share the layout, so
+// either program can score with a model fitted by the other; Regression.cpp
+// carries a copy of this code.
+const char RGM_MAGIC[4] = {'R', 'G', 'M', '1'};
+
+struct RegressionModel {
+    string target;
+    vector<string> features;
+    vector<double> coef;    // b0, b1 .. bk
+};
+
+template <class T> void writePod(ostream &out, const T &x) { out.write((const char *)&x, sizeof(T)); }
+template <class T> bool readPod(istream &in, T &x) { return (bool)in.read((char *)&x, sizeof(T)); }
+
+void writeString(ostream &out, const string &s) {
+    writePod(out, (uint32_t)s.size());
+    out.write(s.data(), s.size());
+}
+
+bool readString(istream &in, string &s) {
+    uint32_t n;
+    if (!readPod(in, n)) return false;
+    s.resize(n);
+    return (bool)in.read(&s[0], n);
+}
+
+bool saveCoefficients(const RegressionModel &m, const string &filename) {
+    ofstream out(filename, ios::binary);
+    if (!out.is_open()) return false;
+    out.write(RGM_MAGIC, 4);
+    writeString(out, m.target);
+    writePod(out, (uint32_t)m.features.size());
+    for (auto &f : m.features) writeString(out, f);
+    out.write((const char *)m.coef.data(), m.coef.size() * sizeof(double));
+    return (bool)out;
+}
+
+bool isCoefficientFile(const string &filename) {
+    ifstream in(filename, ios::binary);
+    char magic[4];
+    return in.read(magic, 4) && equal(magic, magic + 4, RGM_MAGIC);
+}
+
+bool loadCoefficients(RegressionModel &m, const string &filename) {
+    ifstream in(filename, ios::binary);
+    char magic[4];
+    uint32_t k;
+    if (!in.read(magic, 4) || !equal(magic, magic + 4, RGM_MAGIC)) return false;
+    if (!readString(in, m.target) || !readPod(in, k)) return false;
+    m.features.resize(k);
+    for (auto &f : m.features)
+        if (!readString(in, f)) return false;
+    m.coef.resize(k + 1);
+    return (bool)in.read((char *)m.coef.data(), m.coef.size() * sizeof(double));
+}
+
+// ---------- Batch Scoring ----------
+// Scores a CSV with a saved model in one streaming pass. Each thread takes a
+// byte range of the file (streamRange) and collects up to SCORE_BLOCK_ROWS
+// lines as typed columns: one double array per feature plus the target.
+// A block is then scored column by column,
+//     pred[r] = b0 + b1 * x1[r] + ... + bk * xk[r],
+// with plain loops over contiguous arrays that the compiler vectorizes, and
+// the residuals feed the error sums. Lines go to the output with the
+// prediction (and residual) appended; each thread writes its own part file
+// and the parts are joined in file order, so rows keep the input order.
+// Rows with a missing or non-numeric feature keep empty prediction cells.
+// Regression.cpp carries a copy of this scorer.
+const int SCORE_BLOCK_ROWS = 4096;
+
+// Error sums of the scored rows; two partial results merge exactly
+struct ScoreMetrics {
+    long long n = 0, skipped = 0;
+    double sse = 0, sae = 0;     // sum of squared / absolute residuals
+    double yMean = 0, yM2 = 0;   // target mean and centred sum of squares, for R^2
+
+    void merge(long long bn, double bMean, double bM2) {
+        if (bn == 0) return;
+        long long total = n + bn;
+        double d = bMean - yMean;
+        yM2 += bM2 + d * d * ((double)n * bn / total);
+        yMean += d * bn / total;
+        n = total;
+    }
+
+    void merge(const ScoreMetrics &o) {
+        sse += o.sse;
+        sae += o.sae;
+        skipped += o.skipped;
+        merge(o.n, o.yMean, o.yM2);
+    }
+};
+
+// Number cell: spaces and a leading '+' skipped, then from_chars
+bool parseCell(const char *b, const char *e, double &v) {
+    while (b < e && *b == ' ') b++;
+    if (b < e && *b == '+') b++;
+    if (b == e) return false;
+    return from_chars(b, e, v).ec == errc();
+}
+
+struct ScoreWorker {
+    const RegressionModel *model = nullptr;
+    vector<int> featureCol;       // CSV column of each feature
+    int targetCol = -1, lastCol = 0;
+    vector<vector<double>> x;     // [feature][row of block]
+    vector<double> y, pred;
+    vector<int> slot;             // per block line: typed row, or -1 if skipped
+    int typed = 0;                // rows of the block in the typed columns
+    string lines;                 // block lines, each ended by '\n'
+    string buf;
+    vector<const char *> cellB, cellE;
+    ofstream out;
+    bool writing = false;
+    ScoreMetrics metrics;
+
+    // outFile empty: metrics only. append: keep what is already in the file.
+    void init(const RegressionModel &m, const vector<int> &cols, int target, const string &outFile, bool append) {
+        model = &m;
+        featureCol = cols;
+        targetCol = target;
+        lastCol = target;
+        for (int c : cols) lastCol = max(lastCol, c);
+        x.assign(cols.size(), vector<double>(SCORE_BLOCK_ROWS));
+        y.resize(SCORE_BLOCK_ROWS);
+        pred.resize(SCORE_BLOCK_ROWS);
+        cellB.resize(lastCol + 1);
+        cellE.resize(lastCol + 1);
+        writing = !outFile.empty();
+        if (writing) out.open(outFile, append ? ios::binary | ios::app : ios::binary | ios::trunc);
+    }
+
+    void addLine(const char *b, const char *e) {
+        int r = typed;
+        fill(cellB.begin(), cellB.end(), nullptr);
+        int col = 0;
+        for (const char *c = b; col <= lastCol; col++) {
+            const char *comma = find(c, e, ',');
+            cellB[col] = c;
+            cellE[col] = comma;
+            if (comma == e) break;
+            c = comma + 1;
+        }
+        bool ok = b != e;
+        for (size_t f = 0; ok && f < featureCol.size(); f++)
+            ok = cellB[featureCol[f]] && parseCell(cellB[featureCol[f]], cellE[featureCol[f]], x[f][r]);
+        if (ok && targetCol >= 0) ok = cellB[targetCol] && parseCell(cellB[targetCol], cellE[targetCol], y[r]);
+        if (!ok && b != e) metrics.skipped++;
+        slot.push_back(ok ? r : -1);
+        typed += ok;
+        if (writing) {
+            lines.append(b, e);
+            lines += '\n';
+        }
+        if ((int)slot.size() == SCORE_BLOCK_ROWS) flushBlock();
+    }
+
+    void flushBlock() {
+        int n = typed;
+        const vector<double> &coef = model->coef;
+        double *p = pred.data();
+        for (int r = 0; r < n; r++) p[r] = coef[0];
+        for (size_t f = 0; f < x.size(); f++) {
+            const double *xf = x[f].data();
+            double bf = coef[f + 1];
+            for (int r = 0; r < n; r++) p[r] += bf * xf[r];
+        }
+        if (targetCol >= 0 && n > 0) {
+            const double *yv = y.data();
+            double sse = 0, sae = 0, sum = 0, m2 = 0;
+            for (int r = 0; r < n; r++) {
+                double d = yv[r] - p[r];
+                sse += d * d;
+                sae += fabs(d);
+                sum += yv[r];
+            }
+            double mean = sum / n;
+            for (int r = 0; r < n; r++) m2 += (yv[r] - mean) * (yv[r] - mean);
+            metrics.sse += sse;
+            metrics.sae += sae;
+            metrics.merge(n, mean, m2);
+        } else {
+            metrics.n += n;
+        }
+
+        if (writing) {
+            buf.clear();
+            char num[64];
+            size_t pos = 0;
+            for (int s : slot) {
+                size_t end = lines.find('\n', pos);
+                buf.append(lines, pos, end - pos);
+                pos = end + 1;
+                buf += ',';
+                if (s >= 0) buf.append(num, to_chars(num, num + sizeof(num), p[s], chars_format::fixed, 4).ptr);
+                if (targetCol >= 0) {
+                    buf += ',';
+                    if (s >= 0)
+                        buf.append(num, to_chars(num, num + sizeof(num), y[s] - p[s], chars_format::fixed, 4).ptr);
+                }
+                buf += '\n';
+            }
+            out.write(buf.data(), buf.size());
+        }
+        slot.clear();
+        typed = 0;
+        lines.clear();
+    }
+};
+
+// Splits a header line into trimmed column names
+vector<string> headerNames(string line) {
+    if (!line.empty() && line.back() == '\r') line.pop_back();
+    vector<string> names;
+    stringstream ss(line);
+    string cell;
+    while (getline(ss, cell, ',')) {
+        while (!cell.empty() && cell.front() == ' ') cell.erase(cell.begin());
+        while (!cell.empty() && cell.back() == ' ') cell.pop_back();
+        names.push_back(cell);
+    }
+    return names;
+}
+
+// Asks for a test CSV and an output file, scores every row and prints the
+// metrics. Feature and target columns are found by header name.
+void runScoring(const string &modelFile) {
+    RegressionModel m;
+    if (!loadCoefficients(m, modelFile)) {
+        cout << "Error: Cannot read coefficient file " << modelFile << "\n";
+        return;
+    }
+    string testFile, outFile;
+    cout << "Enter CSV file to score: ";
+    cin >> testFile;
+    cout << "Write predictions to (CSV file, or - to skip): ";
+    cin >> outFile;
+    if (outFile == "-") outFile.clear();
+
+    ifstream file(testFile, ios::binary);
+    string headerLine;
+    if (!file.is_open() || !getline(file, headerLine)) {
+        cout << "Error: Cannot open file " << testFile << "\n";
+        return;
+    }
+    long long dataStart = file.tellg();
+    file.close();
+    vector<string> names = headerNames(headerLine);
+    auto column = [&](const string &name) { return (int)(find(names.begin(), names.end(), name) - names.begin()); };
+    vector<int> featureCol;
+    for (auto &f : m.features) {
+        int c = column(f);
+        if (c == (int)names.size()) {
+            cout << "Error: Column " << f << " not found in " << testFile << "\n";
+            return;
+        }
+        featureCol.push_back(c);
+    }
+    int targetCol = column(m.target);
+    if (targetCol == (int)names.size()) targetCol = -1;
+
+    auto t0 = chrono::steady_clock::now();
+    ifstream probe(testFile, ios::binary | ios::ate);
+    long long size = probe.tellg();
+    long long bytes = max(0LL, size - dataStart);
+    int threads = bytes < STREAM_PARALLEL_BYTES ? 1 : max(1, (int)thread::hardware_concurrency());
+    if (!outFile.empty()) {
+        ofstream head(outFile, ios::binary);
+        if (!headerLine.empty() && headerLine.back() == '\r') headerLine.pop_back();
+        head << headerLine << ",Predicted_" << m.target << (targetCol >= 0 ? ",Residual" : "") << "\n";
+    }
+    vector<ScoreWorker> part(threads);
+    vector<thread> workers;
+    for (int t = 0; t < threads; t++) {
+        auto work = [&, t] {
+            part[t].init(m, featureCol, targetCol,
+                         outFile.empty() ? "" : t == 0 ? outFile : outFile + ".part" + to_string(t), t == 0);
+            streamRange(testFile, dataStart + bytes * t / threads, dataStart + bytes * (t + 1) / threads, part[t],
+                        [](ScoreWorker &w, const char *b, const char *e) { w.addLine(b, e); });
+            part[t].flushBlock();
+            part[t].out.close();
+        };
+        if (t + 1 < threads) workers.emplace_back(work);
+        else work();
+    }
+    for (thread &w : workers) w.join();
+    for (int t = 1; t < threads; t++) {
+        part[0].metrics.merge(part[t].metrics);
+        if (outFile.empty()) continue;
+        string partFile = outFile + ".part" + to_string(t);
+        ofstream all(outFile, ios::binary | ios::app);
+        ifstream in(partFile, ios::binary);
+        all << in.rdbuf();
+        in.close();
+        remove(partFile.c_str());
+    }
+    double secs = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+
+    const ScoreMetrics &s = part[0].metrics;
+    cout << fixed << setprecision(4);
+    cout << "\nScored " << s.n << " records in " << setprecision(2) << secs << " s";
+    if (secs > 0) cout << " (" << (long long)(s.n / secs) << " records/s)";
+    cout << "\n" << setprecision(4);
+    if (s.skipped) cout << s.skipped << " rows with a missing or non-numeric value left unscored\n";
+    if (!outFile.empty()) cout << "Predictions written to " << outFile << "\n";
+    if (targetCol >= 0 && s.n > 0) {
+        cout << "R^2  = " << (s.yM2 > 0 ? 1 - s.sse / s.yM2 : 0.0) << "\n";
+        cout << "RMSE = " << sqrt(s.sse / s.n) << "\n";
+        cout << "MAE  = " << s.sae / s.n << "\n";
+    } else if (targetCol < 0) {
+        cout << "No " << m.target << " column in " << testFile << ", so no error metrics\n";
+    }
+}
+
+// Function to invert a 2x2 or 3x3 matrix (for small examples). Not used for
+// fitting any more; the benchmark keeps it as the baseline.
+Matrix inverse(const Matrix &A) {
+    int n = A.rows;
+    Matrix I(n, n);
     for (int i = 0; i < n; ++i) I[i][i] = 1;
 
     // Simple Gauss-Jordan elimination
-    vector<vector<double>> M = A;
+    Matrix M = A;
     for (int i = 0; i < n; ++i) {
         double diag = M[i][i];
         for (int j = 0; j < n; ++j) {
@@ -53,67 +621,369 @@ vector<vector<double>> inverse(const vector<vector<double>>& A) {
     return I;
 }
 
+// ---------- Normal Equation Solvers ----------
+// (X^T X + lambda I) b = X^T y is solved by factorization, never by forming
+// an inverse. Cholesky (p^3/3 multiply-adds, no pivoting needed for a
+// positive definite matrix) is tried first. When a pivot is not clearly
+// positive the design is singular or too ill-conditioned for it, and the
+// symmetric LDL^T with diagonal pivoting takes over: it picks the largest
+// remaining diagonal each step and stops at the numerical rank, so columns
+// that are linear combinations of earlier ones get coefficient 0 instead of
+// blowing up. Both work on X^T X alone, so X itself need not be kept.
+const double PIVOT_TOL = 1e-12;
+
+// A = L L^T (L lower triangular). Returns false if a pivot falls below
+// PIVOT_TOL times the largest diagonal.
+bool cholesky(const Matrix &A, Matrix &L) {
+    int n = A.rows;
+    L = Matrix(n, n);
+    double maxDiag = 0;
+    for (int i = 0; i < n; ++i) maxDiag = max(maxDiag, A[i][i]);
+    for (int j = 0; j < n; ++j) {
+        const double *lj = L[j];
+        double d = A[j][j];
+        for (int k = 0; k < j; ++k) d -= lj[k] * lj[k];
+        if (!(d > PIVOT_TOL * maxDiag)) return false;
+        double ljj = sqrt(d);
+        L[j][j] = ljj;
+        for (int i = j + 1; i < n; ++i) {
+            const double *li = L[i];
+            double s = A[i][j];
+            for (int k = 0; k < j; ++k) s -= li[k] * lj[k];
+            L[i][j] = s / ljj;
+        }
+    }
+    return true;
+}
+
+// Solves L L^T x = b
+vector<double> choleskySolve(const Matrix &L, vector<double> b) {
+    int n = L.rows;
+    for (int i = 0; i < n; ++i) {
+        for (int k = 0; k < i; ++k) b[i] -= L[i][k] * b[k];
+        b[i] /= L[i][i];
+    }
+    for (int i = n - 1; i >= 0; --i) {
+        for (int k = i + 1; k < n; ++k) b[i] -= L[k][i] * b[k];
+        b[i] /= L[i][i];
+    }
+    return b;
+}
+
+// P A P^T = L D L^T with diagonal pivoting (perm[k] = original column of
+// pivot k). Returns the numerical rank r; only the first r columns of L and
+// entries of D are meaningful.
+int ldltPivoted(const Matrix &A, Matrix &L, vector<double> &D, vector<int> &perm) {
+    int n = A.rows;
+    Matrix W = A;
+    L = Matrix(n, n);
+    D.assign(n, 0);
+    perm.resize(n);
+    for (int i = 0; i < n; ++i) perm[i] = i;
+    double maxDiag = 0;
+    for (int i = 0; i < n; ++i) maxDiag = max(maxDiag, fabs(A[i][i]));
+
+    for (int k = 0; k < n; ++k) {
+        int piv = k;
+        for (int j = k + 1; j < n; ++j)
+            if (W[j][j] > W[piv][piv]) piv = j;
+        if (!(W[piv][piv] > PIVOT_TOL * maxDiag)) return k;
+        if (piv != k) {
+            swap(perm[k], perm[piv]);
+            for (int j = 0; j < n; ++j) swap(W[k][j], W[piv][j]);
+            for (int j = 0; j < n; ++j) swap(W[j][k], W[j][piv]);
+            for (int j = 0; j < k; ++j) swap(L[k][j], L[piv][j]);
+        }
+        double d = W[k][k];
+        D[k] = d;
+        L[k][k] = 1;
+        for (int i = k + 1; i < n; ++i) L[i][k] = W[i][k] / d;
+        // Schur complement update of the trailing block
+        for (int i = k + 1; i < n; ++i) {
+            double f = L[i][k] * d;
+            double *wi = W[i];
+            for (int j = k + 1; j < n; ++j) wi[j] -= f * L[j][k];
+        }
+    }
+    return n;
+}
+
+// Basic solution of A x = b from the pivoted factors: the first 'rank'
+// pivoted unknowns are solved, the dependent ones are set to 0.
+vector<double> ldltSolve(const Matrix &L, const vector<double> &D, const vector<int> &perm, int rank,
+                         const vector<double> &b) {
+    int n = L.rows;
+    vector<double> z(rank), x(n, 0);
+    for (int i = 0; i < rank; ++i) {
+        z[i] = b[perm[i]];
+        for (int k = 0; k < i; ++k) z[i] -= L[i][k] * z[k];
+    }
+    for (int i = 0; i < rank; ++i) z[i] /= D[i];
+    for (int i = rank - 1; i >= 0; --i)
+        for (int k = i + 1; k < rank; ++k) z[i] -= L[k][i] * z[k];
+    for (int i = 0; i < rank; ++i) x[perm[i]] = z[i];
+    return x;
+}
+
+struct Solution {
+    vector<double> b;
+    string method;
+    int rank = 0;
+    vector<int> dropped;    // columns given coefficient 0 (LDL^T fallback)
+    Matrix factor;          // L of the factorization that was used
+};
+
+// Coefficients of the (ridge) normal equations. lambda is added to every
+// diagonal entry except the intercept's (column 0), which is not penalized.
+Solution solveNormalEquations(const Matrix &XtX, const Matrix &XtY, double lambda) {
+    int p = XtX.rows;
+    Matrix A = XtX;
+    for (int i = 1; i < p; ++i) A[i][i] += lambda;
+    vector<double> rhs(XtY.a.begin(), XtY.a.end());
+
+    Solution s;
+    if (cholesky(A, s.factor)) {
+        s.method = "Cholesky";
+        s.rank = p;
+        s.b = choleskySolve(s.factor, rhs);
+        return s;
+    }
+    vector<double> D;
+    vector<int> perm;
+    s.rank = ldltPivoted(A, s.factor, D, perm);
+    s.method = "pivoted LDL^T";
+    s.b = ldltSolve(s.factor, D, perm, s.rank, rhs);
+    for (int k = s.rank; k < p; ++k) s.dropped.push_back(perm[k]);
+    sort(s.dropped.begin(), s.dropped.end());
+    return s;
+}
+
+// ---------- Solver Benchmark ----------
+// Synthetic designs with known coefficients (y = X b exactly), from well
+// conditioned to exactly singular. For each one the old Gauss-Jordan
+// inverse and solveNormalEquations are timed and checked:
+//   residual  = |X b - y| / |y|       (0 up to rounding for a good solve)
+//   coef err  = max |b - b*| / max |b*|  (not unique when X is singular)
+struct BenchCase {
+    string name;
+    int n, p;
+    int kind;   // 0 random, 1 near-collinear, 2 polynomial, 3 duplicate column
+};
+
+Matrix benchDesign(const BenchCase &c, mt19937_64 &rng) {
+    normal_distribution<double> gauss;
+    uniform_real_distribution<double> unit(0, 1);
+    Matrix X(c.n, c.p);
+    for (int i = 0; i < c.n; ++i) {
+        double *x = X[i];
+        x[0] = 1;
+        double t = unit(rng);
+        for (int j = 1; j < c.p; ++j) x[j] = c.kind == 2 ? x[j - 1] * t : gauss(rng);
+        if (c.kind == 1) x[c.p - 1] = x[1] + 1e-7 * gauss(rng);
+        if (c.kind == 3) x[c.p - 1] = x[1];
+    }
+    return X;
+}
+
+double relResidual(const Matrix &X, const vector<double> &b, const vector<double> &y) {
+    double num = 0, den = 0;
+    for (int i = 0; i < X.rows; ++i) {
+        double f = 0;
+        for (int j = 0; j < X.cols; ++j) f += X[i][j] * b[j];
+        num += (f - y[i]) * (f - y[i]);
+        den += y[i] * y[i];
+    }
+    return sqrt(num / den);
+}
+
+void runBenchmark() {
+    vector<BenchCase> cases = {
+        {"random", 20000, 20, 0},
+        {"random", 20000, 200, 0},
+        {"random", 5000, 400, 0},
+        {"near-collinear", 20000, 100, 1},
+        {"polynomial deg 9", 20000, 10, 2},
+        {"polynomial deg 15", 20000, 16, 2},
+        {"duplicate column", 20000, 100, 3},
+    };
+    mt19937_64 rng(42);
+    normal_distribution<double> gauss;
+    cout << "\n" << left << setw(20) << "Case" << right << setw(7) << "n" << setw(6) << "p" << "  "
+         << left << setw(20) << "Solver" << right << setw(11) << "time ms" << setw(13) << "residual"
+         << setw(13) << "coef err" << "\n";
+    cout << scientific << setprecision(2);
+
+    for (const BenchCase &c : cases) {
+        Matrix X = benchDesign(c, rng);
+        vector<double> bTrue(c.p), y(c.n, 0);
+        for (auto &v : bTrue) v = gauss(rng);
+        for (int i = 0; i < c.n; ++i)
+            for (int j = 0; j < c.p; ++j) y[i] += X[i][j] * bTrue[j];
+        Matrix XtX, XtY;
+        normalEquations(X, y, XtX, XtY);
+
+        auto report = [&](const string &solver, double ms, const vector<double> &b) {
+            double err = 0, scale = 0;
+            for (int j = 0; j < c.p; ++j) {
+                err = max(err, fabs(b[j] - bTrue[j]));
+                scale = max(scale, fabs(bTrue[j]));
+            }
+            cout << left << setw(20) << c.name << right << setw(7) << c.n << setw(6) << c.p << "  " << left
+                 << setw(20) << solver << right << fixed << setprecision(2) << setw(11) << ms << scientific
+                 << setw(13) << relResidual(X, b, y);
+            if (c.kind == 3) cout << setw(13) << "-";
+            else cout << setw(13) << err / scale;
+            cout << "\n";
+        };
+
+        auto t0 = chrono::steady_clock::now();
+        Matrix B = multiply(inverse(XtX), XtY);
+        double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+        report("Gauss-Jordan", ms, B.a);
+
+        t0 = chrono::steady_clock::now();
+        Solution s = solveNormalEquations(XtX, XtY, 0);
+        ms = chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+        report(s.method + (s.rank < c.p ? " r=" + to_string(s.rank) : ""), ms, s.b);
+    }
+    cout << defaultfloat;
+}
+
+// Prints a matrix; large ones are cut after maxRows rows
+void printMatrix(const Matrix &A, int maxRows = 20) {
+    for (int i = 0; i < min(A.rows, maxRows); ++i) {
+        for (int j = 0; j < A.cols; ++j) cout << A[i][j] << " ";
+        cout << endl;
+    }
+    if (A.rows > maxRows) cout << "... (" << A.rows << " rows)" << endl;
+}
+
 int main() {
-    string filename = "house.csv"; // CSV with features + price
-    ifstream file(filename);
+    string filename;
+    cout << "Enter CSV file name (e.g. house.csv), or bench to benchmark the solvers: ";
+    if (!(cin >> filename)) filename = "house.csv"; // CSV with features + price
+    if (filename == "bench") {
+        runBenchmark();
+        return 0;
+    }
+    if (isCoefficientFile(filename)) {
+        runScoring(filename);
+        return 0;
+    }
+    ifstream file(filename, ios::binary);
     if (!file.is_open()) {
         cout << "Error opening file!" << endl;
         return 0;
     }
-
-    vector<vector<double>> X; // Features + intercept
-    vector<vector<double>> Y; // Dependent variable
     string line;
-    getline(file, line); // skip header
+    getline(file, line); // header: feature names, then the price column
+    vector<string> names = headerNames(line);
+    long long dataStart = file.tellg();
 
-    while (getline(file, line)) {
-        stringstream ss(line);
-        string val;
-        vector<double> row = {1}; // Add intercept term
-        while (getline(ss, val, ',')) {
-            row.push_back(stod(val));
-        }
-        Y.push_back({row.back()}); // last column is price
-        row.pop_back();
-        X.push_back(row);
+    // The first rows are kept for display only; the fit streams the file
+    Matrix head;
+    vector<double> headY, row;
+    int p = 0;
+    while ((int)headY.size() < 20 && getline(file, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (!parseRow(line.data(), line.data() + line.size(), row)) continue;
+        if (p == 0) p = row.size(); // features + price = intercept + features
+        if ((int)row.size() != p) continue;
+        headY.push_back(row.back()); // last column is price
+        row.back() = 1;              // Add intercept term
+        rotate(row.begin(), row.end() - 1, row.end());
+        head.a.insert(head.a.end(), row.begin(), row.end());
     }
     file.close();
+    if (p == 0) {
+        cout << "No data found!" << endl;
+        return 0;
+    }
+    head.rows = headY.size();
+    head.cols = p;
+
+    // One pass over the whole file fills X^T X and X^T Y
+    GramStats empty;
+    empty.init(p);
+    GramStats stats = streamCSV(filename, dataStart, empty, [p](GramStats &acc, const char *b, const char *e) {
+        if (b == e) return;
+        if (!parseRow(b, e, acc.row) || (int)acc.row.size() != p) {
+            acc.skipped++;
+            return;
+        }
+        double y = acc.row.back();
+        acc.row.back() = 1;
+        rotate(acc.row.begin(), acc.row.end() - 1, acc.row.end());
+        acc.addRow(acc.row.data(), y);
+    });
+    Matrix XtX, XtY;
+    stats.result(XtX, XtY);
 
     cout << fixed << setprecision(4);
     cout << "\nStep 1: Feature Matrix X and Y\n";
     cout << "X Matrix:\n";
-    for (auto &r : X) { for (auto &v : r) cout << v << " "; cout << endl; }
+    printMatrix(head);
+    if (stats.n > head.rows) cout << "... (" << stats.n << " rows)" << endl;
     cout << "Y Vector:\n";
-    for (auto &r : Y) { cout << r[0] << endl; }
+    for (double v : headY) cout << v << endl;
+    if (stats.n > head.rows) cout << "... (" << stats.n << " rows)" << endl;
+    if (stats.skipped) cout << stats.skipped << " rows with a bad cell or a different column count skipped" << endl;
+
+    double lambda = 0;
+    cout << "\nEnter ridge penalty lambda (0 for ordinary least squares): ";
+    cin >> lambda;
 
-    // Step 2: Compute b = (X^T X)^-1 X^T Y
-    auto Xt = transpose(X);
-    auto XtX = multiply(Xt, X);
+    // Step 2: Solve (X^T X + lambda I) b = X^T Y
     cout << "\nStep 2: X^T * X\n";
-    for (auto &r : XtX) { for (auto &v : r) cout << v << " "; cout << endl; }
+    printMatrix(XtX, XtX.rows);
 
-    auto XtX_inv = inverse(XtX);
-    cout << "\nStep 3: (X^T * X)^-1\n";
-    for (auto &r : XtX_inv) { for (auto &v : r) cout << v << " "; cout << endl; }
+    Solution sol = solveNormalEquations(XtX, XtY, lambda);
+    cout << "\nStep 3: " << sol.method << " factor L of X^T * X";
+    if (lambda > 0) cout << " + " << lambda << " I";
+    cout << "\n";
+    printMatrix(sol.factor, sol.factor.rows);
+    if (!sol.dropped.empty()) {
+        cout << "X^T * X is singular or ill-conditioned (rank " << sol.rank << " of " << XtX.rows
+             << "); coefficients set to 0 for dependent columns:";
+        for (int j : sol.dropped) cout << " b" << j;
+        cout << endl;
+    }
 
-    auto XtY = multiply(Xt, Y);
     cout << "\nStep 4: X^T * Y\n";
-    for (auto &r : XtY) cout << r[0] << endl;
+    for (int i = 0; i < XtY.rows; ++i) cout << XtY[i][0] << endl;
 
-    auto B = multiply(XtX_inv, XtY);
+    Matrix B(sol.b.size(), 1);
+    B.a = sol.b;
     cout << "\nStep 5: Regression Coefficients (b0, b1, ...)\n";
-    for (int i = 0; i < B.size(); ++i) {
+    for (int i = 0; i < B.rows; ++i) {
         cout << "b" << i << " = " << B[i][0] << endl;
     }
 
+    string coefFile;
+    cout << "\nSave coefficients as (.rgm file for batch scoring, or - to skip): ";
+    if (cin >> coefFile && coefFile != "-") {
+        RegressionModel model;
+        if ((int)names.size() != p) {
+            names.clear();
+            for (int j = 1; j < p; ++j) names.push_back("X" + to_string(j));
+            names.push_back("Y");
+        }
+        model.target = names.back();
+        model.features.assign(names.begin(), names.end() - 1);
+        model.coef = sol.b;
+        if (saveCoefficients(model, coefFile)) cout << "Coefficients saved to " << coefFile << endl;
+        else cout << "Error: Cannot write " << coefFile << endl;
+    }
+
     // Step 6: Predict
     vector<double> input;
     cout << "\nEnter feature values separated by space (Size Bedrooms Location): ";
     double val;
     input.push_back(1); // intercept
     while (cin >> val) input.push_back(val);
+    input.resize(B.rows);
     double predicted = 0;
-    for (int i = 0; i < B.size(); ++i) predicted += B[i][0] * input[i];
+    for (int i = 0; i < B.rows; ++i) predicted += B[i][0] * input[i];
     cout << "Predicted Price = " << predicted << endl;
 
     return 0;
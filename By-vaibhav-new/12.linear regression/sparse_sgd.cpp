@@ -0,0 +1,476 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <iomanip>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <charconv>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <chrono>
+using namespace std;
+
+// Linear / logistic regression for very wide, very sparse data, trained by
+// mini-batch SGD or Adam. Nothing of size p x p is ever formed: a row only
+// touches the weights of its own non-zero features.
+//
+// Features come from a CSV. A numeric cell is one feature with its value;
+// any other cell is one-hot encoded as "column=value" with value 1. Names are
+// hashed into 2^bits weight slots (the hashing trick), so a column with a
+// million distinct values needs no dictionary and any thread can encode any
+// row. Numeric columns should be normalized first (Normaliozation.cpp), as
+// SGD is sensitive to feature scale.
+
+// ---------- CSR Mini-Batch ----------
+// Rows of a batch in compressed sparse row form: the features of row r are
+// col[rowPtr[r] .. rowPtr[r+1]) with values val[...], and its target is y[r].
+struct SparseBatch {
+    vector<uint32_t> rowPtr{0};
+    vector<uint32_t> col;
+    vector<float> val;
+    vector<double> y;
+
+    int rows() const { return y.size(); }
+    void clear() {
+        rowPtr.assign(1, 0);
+        col.clear();
+        val.clear();
+        y.clear();
+    }
+};
+
+// ---------- Feature Hashing ----------
+// FNV-1a over the column number and the cell text; numeric cells hash the
+// column alone so every value of the column shares one weight.
+uint32_t hashFeature(int column, const char *b, const char *e, uint32_t mask) {
+    uint64_t h = 1469598103934665603ULL;
+    for (int i = 0; i < 4; i++) {
+        h ^= (column >> (8 * i)) & 0xff;
+        h *= 1099511628211ULL;
+    }
+    for (const char *c = b; c < e; c++) {
+        h ^= (unsigned char)*c;
+        h *= 1099511628211ULL;
+    }
+    return (uint32_t)(h ^ (h >> 32)) & mask;
+}
+
+bool parseNumber(const char *b, const char *e, double &v) {
+    while (b < e && *b == ' ') b++;
+    while (e > b && e[-1] == ' ') e--;
+    if (b < e && *b == '+') b++;
+    if (b == e) return false;
+    auto r = from_chars(b, e, v);
+    return r.ec == errc() && r.ptr == e;
+}
+
+struct Encoding {
+    int targetCol = 0;
+    bool logistic = false;
+    string positive;      // logistic: target value counted as 1
+    uint32_t mask = 0;    // 2^bits - 1
+};
+
+// One CSV line into the batch. Returns false (batch untouched) if the
+// target is missing or, for linear regression, not numeric.
+bool encodeRow(const Encoding &enc, const char *b, const char *e, SparseBatch &batch) {
+    size_t start = batch.col.size();
+    double y = 0;
+    bool haveY = false;
+    int column = 0;
+    for (const char *c = b;; column++) {
+        const char *comma = find(c, e, ',');
+        const char *cb = c, *ce = comma;
+        while (cb < ce && *cb == ' ') cb++;
+        while (ce > cb && ce[-1] == ' ') ce--;
+        if (column == enc.targetCol) {
+            if (enc.logistic) {
+                y = (size_t)(ce - cb) == enc.positive.size() && equal(cb, ce, enc.positive.begin());
+                haveY = true;
+            } else {
+                haveY = parseNumber(cb, ce, y);
+            }
+        } else if (cb < ce) {
+            double v;
+            if (parseNumber(cb, ce, v)) {
+                if (v != 0) {
+                    batch.col.push_back(hashFeature(column, nullptr, nullptr, enc.mask));
+                    batch.val.push_back(v);
+                }
+            } else {
+                batch.col.push_back(hashFeature(column, cb, ce, enc.mask));
+                batch.val.push_back(1);
+            }
+        }
+        if (comma == e) break;
+        c = comma + 1;
+    }
+    if (!haveY) {
+        batch.col.resize(start);
+        batch.val.resize(start);
+        return false;
+    }
+    batch.y.push_back(y);
+    batch.rowPtr.push_back(batch.col.size());
+    return true;
+}
+
+// ---------- Streaming Loader ----------
+// A loader thread reads the file once per epoch and fills CSR batches into a
+// bounded queue; training threads take batches from it. At most 'capacity'
+// batches are in memory, whatever the file size. An empty pointer from
+// pop() means the epoch is over.
+class BatchQueue {
+public:
+    explicit BatchQueue(size_t capacity) : capacity(capacity) {}
+
+    void push(unique_ptr<SparseBatch> b) {
+        unique_lock<mutex> lock(m);
+        notFull.wait(lock, [&] { return q.size() < capacity; });
+        q.push_back(move(b));
+        notEmpty.notify_one();
+    }
+
+    unique_ptr<SparseBatch> pop() {
+        unique_lock<mutex> lock(m);
+        notEmpty.wait(lock, [&] { return !q.empty() || done; });
+        if (q.empty()) return nullptr;
+        unique_ptr<SparseBatch> b = move(q.front());
+        q.pop_front();
+        notFull.notify_one();
+        return b;
+    }
+
+    void finish() {
+        lock_guard<mutex> lock(m);
+        done = true;
+        notEmpty.notify_all();
+    }
+
+private:
+    size_t capacity;
+    deque<unique_ptr<SparseBatch>> q;
+    bool done = false;
+    mutex m;
+    condition_variable notEmpty, notFull;
+};
+
+// Reads every data line of the file into batches of batchSize rows.
+// Returns the number of lines skipped for a bad target.
+long long loadBatches(const string &filename, const Encoding &enc, int batchSize, BatchQueue &queue) {
+    ifstream file(filename, ios::binary);
+    vector<char> buffer(1 << 20);
+    file.rdbuf()->pubsetbuf(buffer.data(), buffer.size());
+    string line;
+    getline(file, line);                          // header
+    long long skipped = 0;
+    unique_ptr<SparseBatch> batch(new SparseBatch);
+    while (getline(file, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty()) continue;
+        if (!encodeRow(enc, line.data(), line.data() + line.size(), *batch)) skipped++;
+        if (batch->rows() == batchSize) {
+            queue.push(move(batch));
+            batch.reset(new SparseBatch);
+        }
+    }
+    if (batch->rows() > 0) queue.push(move(batch));
+    queue.finish();
+    return skipped;
+}
+
+// ---------- Sparse Model ----------
+// Weights (plus Adam's moment estimates) shared by all training threads.
+// Updates follow Hogwild: threads write without locks, each touching only
+// the features of its batch; with sparse rows collisions are rare and a lost
+// update only costs a little progress. Relaxed atomics keep that well defined
+// and compile to plain loads and stores.
+struct TrainOptions {
+    bool logistic = false;
+    bool adam = true;
+    double rate = 0.01, l1 = 0, l2 = 0;
+    double beta1 = 0.9, beta2 = 0.999, eps = 1e-8;
+};
+
+struct SparseModel {
+    size_t dim = 0;
+    unique_ptr<atomic<double>[]> w, m, v;   // slot dim is the intercept
+    atomic<long long> step{0};
+
+    void init(size_t features) {
+        dim = features;
+        w.reset(new atomic<double>[dim + 1]);
+        m.reset(new atomic<double>[dim + 1]);
+        v.reset(new atomic<double>[dim + 1]);
+        for (size_t j = 0; j <= dim; j++) {
+            w[j].store(0, memory_order_relaxed);
+            m[j].store(0, memory_order_relaxed);
+            v[j].store(0, memory_order_relaxed);
+        }
+    }
+
+    double weight(size_t j) const { return w[j].load(memory_order_relaxed); }
+
+    // Raw score of row r of the batch
+    double score(const SparseBatch &b, int r) const {
+        double s = weight(dim);
+        for (uint32_t k = b.rowPtr[r]; k < b.rowPtr[r + 1]; k++) s += weight(b.col[k]) * b.val[k];
+        return s;
+    }
+};
+
+double sigmoid(double z) { return z >= 0 ? 1 / (1 + exp(-z)) : exp(z) / (1 + exp(z)); }
+
+// Loss and error totals of the rows seen; one per thread, added at the end
+struct EpochStats {
+    long long rows = 0, correct = 0;
+    double loss = 0, absErr = 0;
+
+    void merge(const EpochStats &o) {
+        rows += o.rows;
+        correct += o.correct;
+        loss += o.loss;
+        absErr += o.absErr;
+    }
+};
+
+// Adds the loss of a row predicted before the update (progressive
+// validation: every row is scored by a model that has not yet seen it).
+void addLoss(EpochStats &st, bool logistic, double z, double y) {
+    st.rows++;
+    if (logistic) {
+        double p = min(max(sigmoid(z), 1e-15), 1 - 1e-15);
+        st.loss -= y * log(p) + (1 - y) * log(1 - p);
+        st.correct += (p >= 0.5) == (y == 1);
+    } else {
+        st.loss += (z - y) * (z - y);
+        st.absErr += fabs(z - y);
+    }
+}
+
+// ---------- Mini-Batch Update ----------
+// Gradient of the mean loss over the batch, gathered in a dense per-thread
+// buffer with the list of touched slots, then applied only to those slots.
+// For both losses the row gradient is (prediction - y) * x. L2 adds
+// l2 * w to the gradient; L1 is applied as a proximal step that shrinks a
+// weight towards 0 and clamps it there (so unused one-hot features become
+// exactly 0). The intercept is not regularized.
+struct Worker {
+    vector<double> grad;
+    vector<char> touched;
+    vector<uint32_t> list;
+    EpochStats stats;
+
+    void init(size_t dim) {
+        grad.assign(dim + 1, 0);
+        touched.assign(dim + 1, 0);
+        list.clear();
+    }
+
+    void train(SparseModel &model, const TrainOptions &o, double rate, const SparseBatch &b) {
+        int n = b.rows();
+        if (n == 0) return;
+        size_t bias = model.dim;
+        for (int r = 0; r < n; r++) {
+            double z = model.score(b, r);
+            addLoss(stats, o.logistic, z, b.y[r]);
+            double g = ((o.logistic ? sigmoid(z) : z) - b.y[r]) / n;
+            for (uint32_t k = b.rowPtr[r]; k < b.rowPtr[r + 1]; k++) {
+                uint32_t j = b.col[k];
+                if (!touched[j]) {
+                    touched[j] = 1;
+                    list.push_back(j);
+                }
+                grad[j] += g * b.val[k];
+            }
+            grad[bias] += g;
+        }
+        list.push_back(bias);
+
+        long long t = model.step.fetch_add(1, memory_order_relaxed) + 1;
+        double c1 = 1 - pow(o.beta1, (double)t), c2 = 1 - pow(o.beta2, (double)t);
+        for (uint32_t j : list) {
+            double w = model.weight(j);
+            bool reg = j != bias;
+            double gj = grad[j] + (reg ? o.l2 * w : 0);
+            double stepSize = rate;
+            if (o.adam) {
+                double m = o.beta1 * model.m[j].load(memory_order_relaxed) + (1 - o.beta1) * gj;
+                double v = o.beta2 * model.v[j].load(memory_order_relaxed) + (1 - o.beta2) * gj * gj;
+                model.m[j].store(m, memory_order_relaxed);
+                model.v[j].store(v, memory_order_relaxed);
+                stepSize = rate / (sqrt(v / c2) + o.eps);
+                w -= stepSize * (m / c1);
+            } else {
+                w -= rate * gj;
+            }
+            if (reg && o.l1 > 0) {
+                double shrink = stepSize * o.l1;
+                w = w > shrink ? w - shrink : w < -shrink ? w + shrink : 0;
+            }
+            model.w[j].store(w, memory_order_relaxed);
+            grad[j] = 0;
+            touched[j] = 0;
+        }
+        list.clear();
+    }
+};
+
+// ---------- Training Loop ----------
+// One epoch: the loader thread streams the file into the queue while every
+// worker thread trains on whatever batch comes next. Plain SGD uses the
+// rate rate / sqrt(epoch); Adam keeps the given rate and adapts per weight.
+EpochStats runEpoch(const string &filename, const Encoding &enc, int batchSize, SparseModel &model,
+                    const TrainOptions &o, double rate, vector<Worker> &workers, long long &skipped) {
+    BatchQueue queue(2 * workers.size() + 2);
+    thread loader([&] { skipped = loadBatches(filename, enc, batchSize, queue); });
+    vector<thread> threads;
+    for (size_t t = 0; t < workers.size(); t++) {
+        workers[t].stats = EpochStats();
+        threads.emplace_back([&, t] {
+            while (unique_ptr<SparseBatch> b = queue.pop()) workers[t].train(model, o, rate, *b);
+        });
+    }
+    for (thread &t : threads) t.join();
+    loader.join();
+    EpochStats total;
+    for (Worker &w : workers) total.merge(w.stats);
+    return total;
+}
+
+// Loss on a held-out file under the final weights (no updates)
+EpochStats evaluate(const string &filename, const Encoding &enc, const SparseModel &model, bool logistic) {
+    ifstream file(filename, ios::binary);
+    string line;
+    getline(file, line);
+    EpochStats st;
+    SparseBatch b;
+    while (getline(file, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty()) continue;
+        b.clear();
+        if (encodeRow(enc, line.data(), line.data() + line.size(), b)) addLoss(st, logistic, model.score(b, 0), b.y[0]);
+    }
+    return st;
+}
+
+void printStats(const EpochStats &st, bool logistic) {
+    if (st.rows == 0) return;
+    if (logistic)
+        cout << "log-loss = " << st.loss / st.rows << ", accuracy = " << 100.0 * st.correct / st.rows << "%";
+    else
+        cout << "RMSE = " << sqrt(st.loss / st.rows) << ", MAE = " << st.absErr / st.rows;
+}
+
+// ---------- Main ----------
+int main() {
+    string filename;
+    cout << "Enter training CSV file: ";
+    cin >> filename;
+    ifstream file(filename);
+    string headerLine;
+    if (!file.is_open() || !getline(file, headerLine)) {
+        cout << "Error opening file!" << endl;
+        return 0;
+    }
+    file.close();
+    if (!headerLine.empty() && headerLine.back() == '\r') headerLine.pop_back();
+    vector<string> headers;
+    stringstream hs(headerLine);
+    string cell;
+    while (getline(hs, cell, ',')) headers.push_back(cell);
+
+    cout << "\nColumns:\n";
+    for (size_t i = 0; i < headers.size(); i++) cout << i + 1 << ". " << headers[i] << endl;
+
+    Encoding enc;
+    TrainOptions o;
+    int model = 1, optimizer = 2, batchSize = 256, epochs = 5, bits = 20;
+    cout << "Select target column number: ";
+    cin >> enc.targetCol;
+    enc.targetCol--;
+    if (enc.targetCol < 0 || enc.targetCol >= (int)headers.size()) {
+        cout << "Invalid column number." << endl;
+        return 0;
+    }
+    cout << "Model: (1) linear regression or (2) logistic regression: ";
+    cin >> model;
+    o.logistic = enc.logistic = model == 2;
+    if (o.logistic) {
+        cout << "Target value of the positive class (e.g. 1 or yes): ";
+        cin >> enc.positive;
+    }
+    cout << "Optimizer: (1) SGD or (2) Adam: ";
+    cin >> optimizer;
+    o.adam = optimizer != 1;
+    cout << "Learning rate (e.g. 0.01): ";
+    cin >> o.rate;
+    cout << "L1 penalty (0 for none): ";
+    cin >> o.l1;
+    cout << "L2 penalty (0 for none): ";
+    cin >> o.l2;
+    cout << "Mini-batch size: ";
+    cin >> batchSize;
+    cout << "Epochs: ";
+    cin >> epochs;
+    cout << "Hash bits for features (20 gives 1048576 weights): ";
+    cin >> bits;
+    bits = min(max(bits, 4), 30);
+    batchSize = max(1, batchSize);
+    enc.mask = (1u << bits) - 1;
+
+    SparseModel sm;
+    sm.init((size_t)enc.mask + 1);
+    int threads = max(1, (int)thread::hardware_concurrency());
+    vector<Worker> workers(threads);
+    for (Worker &w : workers) w.init(sm.dim);
+
+    cout << fixed << setprecision(4);
+    cout << "\nTraining " << (o.logistic ? "logistic" : "linear") << " regression with "
+         << (o.adam ? "Adam" : "SGD") << " on " << threads << " thread(s), " << sm.dim << " weights\n";
+    cout << "(loss of each row measured before the model trains on it)\n";
+    for (int e = 1; e <= epochs; e++) {
+        double rate = o.adam ? o.rate : o.rate / sqrt((double)e);
+        long long skipped = 0;
+        auto t0 = chrono::steady_clock::now();
+        EpochStats st = runEpoch(filename, enc, batchSize, sm, o, rate, workers, skipped);
+        double secs = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+        cout << "Epoch " << e << ": " << st.rows << " rows, ";
+        printStats(st, o.logistic);
+        cout << " (" << setprecision(2) << secs << " s, " << (long long)(st.rows / max(secs, 1e-9)) << " rows/s)"
+             << setprecision(4) << endl;
+        if (skipped) cout << "  " << skipped << " rows skipped for a missing or invalid target" << endl;
+    }
+
+    size_t nonZero = 0;
+    vector<pair<double, uint32_t>> top;
+    for (size_t j = 0; j < sm.dim; j++) {
+        double w = sm.weight(j);
+        if (w == 0) continue;
+        nonZero++;
+        top.push_back({fabs(w), (uint32_t)j});
+    }
+    size_t k = min<size_t>(10, top.size());
+    partial_sort(top.begin(), top.begin() + k, top.end(), greater<pair<double, uint32_t>>());
+    cout << "\nIntercept = " << sm.weight(sm.dim) << "\n";
+    cout << "Non-zero weights: " << nonZero << " of " << sm.dim << "\n";
+    cout << "Largest weights (hashed feature slot: weight):\n";
+    for (size_t i = 0; i < k; i++) cout << "  " << top[i].second << ": " << sm.weight(top[i].second) << "\n";
+
+    string testFile;
+    cout << "\nEnter test CSV to evaluate (or - to skip): ";
+    if (cin >> testFile && testFile != "-") {
+        EpochStats st = evaluate(testFile, enc, sm, o.logistic);
+        cout << "Test: " << st.rows << " rows, ";
+        printStats(st, o.logistic);
+        cout << endl;
+    }
+    return 0;
+}
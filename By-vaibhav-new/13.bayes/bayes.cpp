@@ -1,43 +1,371 @@
 #include<bits/stdc++.h>
 using namespace std;
 
-int main() {
-    // --- Step 1: Read CSV file ---
-    ifstream file("data.csv");
-    if (!file.is_open()) {
-        cout << "Error: Unable to open data.csv!" << endl;
-        return 0;
+// Split CSV line by delimiter
+vector<string> split(const string &s, char d) {
+    vector<string> tokens; string temp; stringstream ss(s);
+    while (getline(ss, temp, d)) tokens.push_back(temp);
+    return tokens;
+}
+
+// ---------- Single-Pass Naive Bayes Trainer ----------
+// Copy of the trainer, .nbm persistence and merge code (through buildModel)
+// in NaiveNumeric.cpp, which documents it. Each program is built on its own,
+// so fix NaiveNumeric.cpp, NaiveB.cpp and bayes.cpp together.
+struct RunningStats {
+    long long n = 0;
+    double mean = 0.0, m2 = 0.0;
+
+    void add(double x) {
+        n++;
+        double d = x - mean;
+        mean += d / n;
+        m2 += d * (x - mean);
     }
+    double stddev() const { return n > 0 ? sqrt(m2 / n) : 0.0; }   // population
 
-    string line;
-    getline(file, line); // header
-    stringstream header(line);
+    void merge(const RunningStats &o) {
+        if (o.n == 0) return;
+        long long total = n + o.n;
+        double d = o.mean - mean;
+        mean += d * o.n / total;
+        m2 += o.m2 + d * d * ((double)n * o.n / total);
+        n = total;
+    }
+};
+
+struct NaiveBayesModel {
     vector<string> headers;
-    string col;
-    while (getline(header, col, ',')) headers.push_back(col);
+    int featureCount = 0;
+    vector<bool> isNum;                          // per feature
+    vector<string> classNames;                   // class code -> label
+    unordered_map<string, int> classIndex;
+    vector<long long> classCount;                // per class code
+    vector<vector<string>> valueNames;           // [feature][value code] -> value
+    vector<unordered_map<string, int>> valueIndex;
+    vector<vector<long long>> counts;            // [feature][value * numClasses + class]
+    vector<vector<RunningStats>> stats;          // [feature][class], numeric features
+    long long total = 0;
+    long long skippedCells = 0;                  // non-numeric cells of numeric features (not saved)
+
+    int numClasses() const { return classNames.size(); }
+};
+
+void initModel(NaiveBayesModel &m, const vector<string> &headers, const vector<bool> &isNum) {
+    m.headers = headers;
+    m.featureCount = headers.size() - 1;         // Last column = Class
+    m.isNum = isNum;
+    m.valueNames.assign(m.featureCount, {});
+    m.valueIndex.assign(m.featureCount, {});
+    m.counts.assign(m.featureCount, {});
+    m.stats.assign(m.featureCount, {});
+}
+
+int classCode(NaiveBayesModel &m, const string &label) {
+    auto it = m.classIndex.find(label);
+    if (it != m.classIndex.end()) return it->second;
+
+    int K = m.numClasses();
+    for (int f = 0; f < m.featureCount; f++) {
+        if (m.isNum[f]) {
+            m.stats[f].push_back(RunningStats());
+            continue;
+        }
+        int V = m.valueNames[f].size();
+        vector<long long> wider((size_t)V * (K + 1), 0);
+        for (int v = 0; v < V; v++)
+            copy(m.counts[f].begin() + (size_t)v * K, m.counts[f].begin() + (size_t)(v + 1) * K,
+                 wider.begin() + (size_t)v * (K + 1));
+        m.counts[f].swap(wider);
+    }
+    m.classNames.push_back(label);
+    m.classCount.push_back(0);
+    m.classIndex[label] = K;
+    return K;
+}
+
+int valueCode(NaiveBayesModel &m, int f, const string &value) {
+    auto it = m.valueIndex[f].find(value);
+    if (it != m.valueIndex[f].end()) return it->second;
+    int code = m.valueNames[f].size();
+    m.valueNames[f].push_back(value);
+    m.valueIndex[f][value] = code;
+    m.counts[f].resize(m.counts[f].size() + m.numClasses(), 0);
+    return code;
+}
+
+int findValue(const NaiveBayesModel &m, int f, const string &value) {
+    auto it = m.valueIndex[f].find(value);
+    return it == m.valueIndex[f].end() ? -1 : it->second;
+}
+
+long long valueCount(const NaiveBayesModel &m, int f, int value, int cls) {
+    return m.counts[f][(size_t)value * m.numClasses() + cls];
+}
 
-    int nAttr = headers.size() - 1;    // last column is class
-    string classCol = headers.back();
+void makeNumeric(NaiveBayesModel &m, int f) {
+    for (long long n : m.counts[f]) m.skippedCells += n;
+    m.isNum[f] = true;
+    m.counts[f].clear();
+    m.valueNames[f].clear();
+    m.valueIndex[f].clear();
+    m.stats[f].assign(m.numClasses(), RunningStats());
+}
 
-    vector<vector<string>> data;
-    while (getline(file, line)) {
-        stringstream ss(line);
-        vector<string> row;
-        string value;
-        while (getline(ss, value, ',')) row.push_back(value);
-        if (!row.empty()) data.push_back(row);
+void addRecord(NaiveBayesModel &m, const vector<string> &row, bool (*numericTest)(const string &)) {
+    int c = classCode(m, row.back());
+    int K = m.numClasses();
+    m.classCount[c]++;
+    m.total++;
+    for (int f = 0; f < m.featureCount; f++) {
+        if (numericTest && numericTest(row[f])) {
+            if (!m.isNum[f]) makeNumeric(m, f);
+            m.stats[f][c].add(strtod(row[f].c_str(), nullptr));
+        } else if (m.isNum[f]) {
+            m.skippedCells++;
+        } else {
+            m.counts[f][(size_t)valueCode(m, f, row[f]) * K + c]++;
+        }
     }
-    file.close();
+}
 
-    int totalRecords = data.size();
+bool trainNaiveBayes(istream &in, NaiveBayesModel &m, bool (*numericTest)(const string &)) {
+    string line;
+    if (!getline(in, line)) return false;
+    vector<string> headers = split(line, ',');
+    if (headers.size() < 2) return false;
 
-    // --- Step 2: Identify all possible classes ---
-    vector<string> classes;
-    for (auto &row : data) {
-        string cls = row[nAttr];
-        if (find(classes.begin(), classes.end(), cls) == classes.end())
-            classes.push_back(cls);
+    initModel(m, headers, vector<bool>(headers.size() - 1, false));
+    while (getline(in, line)) {
+        vector<string> row = split(line, ',');
+        if (row.size() != headers.size()) continue;
+        addRecord(m, row, numericTest);
     }
+    return true;
+}
+
+vector<int> sortedClasses(const NaiveBayesModel &m) {
+    vector<int> order(m.numClasses());
+    iota(order.begin(), order.end(), 0);
+    sort(order.begin(), order.end(),
+         [&](int a, int b) { return m.classNames[a] < m.classNames[b]; });
+    return order;
+}
+
+vector<int> sortedValues(const NaiveBayesModel &m, int f) {
+    vector<int> order(m.valueNames[f].size());
+    iota(order.begin(), order.end(), 0);
+    sort(order.begin(), order.end(),
+         [&](int a, int b) { return m.valueNames[f][a] < m.valueNames[f][b]; });
+    return order;
+}
+
+// ---------- Model Persistence and Merging ----------
+const char NB_MAGIC[4] = {'N', 'B', 'M', '1'};
+
+template <class T> void writePod(ostream &out, const T &x) { out.write((const char *)&x, sizeof(T)); }
+template <class T> bool readPod(istream &in, T &x) { return (bool)in.read((char *)&x, sizeof(T)); }
+
+void writeString(ostream &out, const string &s) {
+    writePod(out, (uint32_t)s.size());
+    out.write(s.data(), s.size());
+}
+
+bool readCount(istream &in, uint32_t &n, uint64_t size, uint64_t each) {
+    return readPod(in, n) && n <= size / each;
+}
+
+bool readString(istream &in, string &s, uint64_t size) {
+    uint32_t n;
+    if (!readCount(in, n, size, 1)) return false;
+    s.resize(n);
+    return (bool)in.read(&s[0], n);
+}
+
+bool saveModel(const NaiveBayesModel &m, const string &filename) {
+    ofstream out(filename, ios::binary);
+    if (!out.is_open()) return false;
+    out.write(NB_MAGIC, 4);
+    writePod(out, (uint32_t)m.headers.size());
+    for (auto &h : m.headers) writeString(out, h);
+    for (int f = 0; f < m.featureCount; f++) writePod(out, (uint8_t)m.isNum[f]);
+
+    int K = m.numClasses();
+    writePod(out, (uint32_t)K);
+    for (auto &c : m.classNames) writeString(out, c);
+    out.write((const char *)m.classCount.data(), K * sizeof(long long));
+    writePod(out, m.total);
+
+    for (int f = 0; f < m.featureCount; f++) {
+        if (m.isNum[f]) {
+            for (auto &s : m.stats[f]) {
+                writePod(out, s.n);
+                writePod(out, s.mean);
+                writePod(out, s.m2);
+            }
+        } else {
+            writePod(out, (uint32_t)m.valueNames[f].size());
+            for (auto &v : m.valueNames[f]) writeString(out, v);
+            out.write((const char *)m.counts[f].data(), m.counts[f].size() * sizeof(long long));
+        }
+    }
+    return (bool)out;
+}
+
+bool isModelFile(const string &filename) {
+    ifstream in(filename, ios::binary);
+    char magic[4];
+    return in.read(magic, 4) && equal(magic, magic + 4, NB_MAGIC);
+}
+
+bool loadModel(NaiveBayesModel &m, const string &filename) {
+    ifstream in(filename, ios::binary | ios::ate);
+    uint64_t size = max(0LL, (long long)in.tellg());
+    in.seekg(0);
+    char magic[4];
+    if (!in.read(magic, 4) || !equal(magic, magic + 4, NB_MAGIC)) return false;
+
+    uint32_t numHeaders;
+    if (!readCount(in, numHeaders, size, sizeof(uint32_t)) || numHeaders < 2) return false;
+    vector<string> headers(numHeaders);
+    for (auto &h : headers)
+        if (!readString(in, h, size)) return false;
+    vector<bool> isNum(numHeaders - 1);
+    for (size_t f = 0; f < isNum.size(); f++) {
+        uint8_t b;
+        if (!readPod(in, b)) return false;
+        isNum[f] = b;
+    }
+    initModel(m, headers, isNum);
+
+    uint32_t K;
+    if (!readCount(in, K, size, sizeof(long long))) return false;
+    m.classNames.resize(K);
+    for (uint32_t c = 0; c < K; c++) {
+        if (!readString(in, m.classNames[c], size)) return false;
+        m.classIndex[m.classNames[c]] = c;
+    }
+    m.classCount.resize(K);
+    if (!in.read((char *)m.classCount.data(), K * sizeof(long long)) || !readPod(in, m.total)) return false;
+
+    for (int f = 0; f < m.featureCount; f++) {
+        if (m.isNum[f]) {
+            m.stats[f].resize(K);
+            for (auto &s : m.stats[f])
+                if (!readPod(in, s.n) || !readPod(in, s.mean) || !readPod(in, s.m2)) return false;
+        } else {
+            uint32_t V;
+            if (!readCount(in, V, size, sizeof(uint32_t)) || (uint64_t)V * K > size / sizeof(long long)) return false;
+            m.valueNames[f].resize(V);
+            m.valueIndex[f].reserve(V);
+            for (uint32_t v = 0; v < V; v++) {
+                if (!readString(in, m.valueNames[f][v], size)) return false;
+                m.valueIndex[f][m.valueNames[f][v]] = v;
+            }
+            m.counts[f].resize((size_t)V * K);
+            if (!in.read((char *)m.counts[f].data(), m.counts[f].size() * sizeof(long long))) return false;
+        }
+    }
+    return true;
+}
+
+bool mergeModel(NaiveBayesModel &dst, const NaiveBayesModel &src) {
+    if (src.headers.empty()) return true;
+    if (dst.headers.empty()) {
+        dst = src;
+        return true;
+    }
+    if (dst.headers != src.headers) return false;
+
+    int srcK = src.numClasses();
+    vector<int> classMap(srcK);
+    for (int c = 0; c < srcK; c++) classMap[c] = classCode(dst, src.classNames[c]);
+    int K = dst.numClasses();
+
+    for (int c = 0; c < srcK; c++) dst.classCount[classMap[c]] += src.classCount[c];
+    dst.total += src.total;
+    dst.skippedCells += src.skippedCells;
+
+    for (int f = 0; f < dst.featureCount; f++) {
+        if (src.isNum[f] && !dst.isNum[f]) makeNumeric(dst, f);
+        if (dst.isNum[f]) {
+            if (!src.isNum[f]) {
+                for (long long n : src.counts[f]) dst.skippedCells += n;
+                continue;
+            }
+            for (int c = 0; c < srcK; c++) dst.stats[f][classMap[c]].merge(src.stats[f][c]);
+            continue;
+        }
+        for (int v = 0; v < (int)src.valueNames[f].size(); v++) {
+            size_t row = (size_t)valueCode(dst, f, src.valueNames[f][v]) * K;
+            for (int c = 0; c < srcK; c++)
+                dst.counts[f][row + classMap[c]] += src.counts[f][(size_t)v * srcK + c];
+        }
+    }
+    return true;
+}
+
+bool buildModel(const vector<string> &sources, NaiveBayesModel &m, bool (*numericTest)(const string &)) {
+    int n = sources.size();
+    if (n == 0) return false;
+    vector<NaiveBayesModel> parts(n);
+    vector<char> ok(n, 0);
+    vector<thread> threads;
+    for (int i = 0; i < n; i++)
+        threads.emplace_back([&, i] {
+            if (isModelFile(sources[i])) {
+                ok[i] = loadModel(parts[i], sources[i]);
+            } else {
+                ifstream in(sources[i]);
+                ok[i] = in.is_open() && trainNaiveBayes(in, parts[i], numericTest);
+            }
+        });
+    for (thread &th : threads) th.join();
+    for (int i = 0; i < n; i++)
+        if (!ok[i]) {
+            cout << "Error: Cannot read " << sources[i] << "\n";
+            return false;
+        }
+
+    for (int step = 1; step < n; step *= 2) {
+        threads.clear();
+        for (int i = 0; i + step < n; i += 2 * step)
+            threads.emplace_back([&, i, step] { ok[i] = mergeModel(parts[i], parts[i + step]); });
+        for (thread &th : threads) th.join();
+        for (int i = 0; i + step < n; i += 2 * step)
+            if (!ok[i]) {
+                cout << "Error: " << sources[i + step] << " does not have the same columns\n";
+                return false;
+            }
+    }
+    m = move(parts[0]);
+    return true;
+}
+
+int main() {
+    // --- Step 1: Build the model from CSV file(s) and/or saved models ---
+    // A saved model plus a new CSV batch only costs a pass over the batch.
+    string sources;
+    cout << "Enter CSV file(s) or saved .nbm model(s), comma separated: ";
+    cin >> sources;
+
+    NaiveBayesModel model;
+    if (!buildModel(split(sources, ','), model, nullptr)) return 0;
+
+    string modelFile;
+    cout << "Save model as (.nbm file, or - to skip): ";
+    cin >> modelFile;
+    if (modelFile != "-") {
+        if (saveModel(model, modelFile)) cout << "Model saved to " << modelFile << "\n";
+        else cout << "Error: Cannot write " << modelFile << "\n";
+    }
+
+    const vector<string> &headers = model.headers;
+    int nAttr = model.featureCount;    // last column is class
+    long long totalRecords = model.total;
+
+    // --- Step 2: Classes, in order of first appearance ---
+    const vector<string> &classes = model.classNames;
 
     // --- Step 3: Input new record ---
     vector<string> newRecord(nAttr);
@@ -54,12 +382,7 @@ int main() {
     cout << "\n--- Step-by-step Posterior Probabilities ---\n";
     for (int c = 0; c < classes.size(); c++) {
         string classVal = classes[c];
-        int classCount = 0;
-
-        // Count how many records belong to this class
-        for (auto &row : data)
-            if (row[nAttr] == classVal)
-                classCount++;
+        long long classCount = model.classCount[c];
 
         double prior = (double)classCount / totalRecords;
         double prob = prior;
@@ -69,11 +392,8 @@ int main() {
 
         // Multiply conditional probabilities for each attribute
         for (int j = 0; j < nAttr; j++) {
-            int match = 0;
-            for (auto &row : data) {
-                if (row[nAttr] == classVal && row[j] == newRecord[j])
-                    match++;
-            }
+            int v = findValue(model, j, newRecord[j]);
+            long long match = v >= 0 ? valueCount(model, j, v, c) : 0;
 
             double condProb = 0.0;
             if (classCount > 0)
@@ -1,113 +1,394 @@
 #include <bits/stdc++.h>
 using namespace std;
 
-// Read CSV file
-vector<map<string, string>> readCSV(const string& fileName, vector<string>& header) {
-    vector<map<string, string>> records;
-    ifstream file(fileName);
-    if (!file.is_open()) {
-        cout << "Error opening file!" << endl;
-        return records;
+// ---------- Columnar Fact Table ----------
+// The CSV is held column by column instead of as one map per row. A column
+// whose every cell is a number is a measure: one contiguous double array.
+// Any other column is a dimension, dictionary-encoded: dict holds each
+// distinct text once (in order of first appearance) and code[r] is the
+// row's index into it, 4 bytes per cell. Comparing a cell with a value is
+// then an integer compare, and a scan reads a flat array at memory speed.
+// When a measure is used as a dimension (grouped or pivoted on), its
+// values are encoded the same way on first use. A measure prints with the
+// number of decimals its cells had in the file (all cells of a measure
+// share one), so cells print as they were written; a numeric column
+// written in any other way (mixed decimals, "007", "1e3") also keeps its
+// texts in a dictionary.
+//
+// Row numbers are 32-bit (up to 4G facts). Scans over more than
+// OLAP_PARALLEL_ROWS rows are split into one contiguous block per thread,
+// each with its own partial result; the partials are combined in block
+// order, so selections keep the row order.
+// By-girl-new/olap_cube_opration.cpp carries a copy of this code down to
+// pivotSums(); change both together.
+const size_t OLAP_PARALLEL_ROWS = 1 << 20;
+const uint32_t NO_CODE = UINT32_MAX;
+
+struct FactTable {
+    vector<string> header;
+    size_t rows = 0;
+    vector<char> isMeasure;
+    vector<int> decimals;               // measures: digits after the point
+    vector<vector<double>> measure;     // measures only
+    vector<vector<uint32_t>> code;      // dimensions (and encoded measures)
+    vector<vector<string>> dict;
+
+    // Index of the named column, -1 if there is none
+    int column(const string &name) const {
+        for (size_t c = 0; c < header.size(); c++)
+            if (header[c] == name) return c;
+        return -1;
+    }
+
+    // Encodes a measure column for grouping; the labels are the numbers
+    // as printed
+    void ensureCodes(int c) {
+        if (!code[c].empty() || rows == 0) return;
+        unordered_map<double, uint32_t> ids;
+        code[c].resize(rows);
+        for (size_t r = 0; r < rows; r++) {
+            auto it = ids.emplace(measure[c][r], dict[c].size());
+            if (it.second) dict[c].push_back(formatNumber(measure[c][r], decimals[c]));
+            code[c][r] = it.first->second;
+        }
+    }
+
+    // Text of one cell
+    string text(int c, size_t r) const {
+        return code[c].empty() ? formatNumber(measure[c][r], decimals[c]) : dict[c][code[c][r]];
+    }
+
+    static string formatNumber(double v, int decimals) {
+        char buf[400];
+        auto res = to_chars(buf, buf + sizeof(buf), v, chars_format::fixed, decimals);
+        return string(buf, res.ptr);
+    }
+};
+
+// Number cell: the whole text must parse (spaces and a leading '+' allowed)
+bool parseNumber(const string &s, double &v) {
+    const char *b = s.data(), *e = b + s.size();
+    while (b < e && *b == ' ') b++;
+    while (e > b && e[-1] == ' ') e--;
+    if (b < e && *b == '+') b++;
+    if (b == e) return false;
+    auto r = from_chars(b, e, v);
+    return r.ec == errc() && r.ptr == e;
+}
+
+// Splits a CSV line into cells (missing trailing cells are empty)
+void splitLine(const string &line, size_t columns, vector<string> &cells) {
+    cells.assign(columns, string());
+    size_t c = 0, start = 0;
+    while (c < columns) {
+        size_t comma = line.find(',', start);
+        cells[c++].assign(line, start, comma == string::npos ? string::npos : comma - start);
+        if (comma == string::npos) break;
+        start = comma + 1;
     }
+}
+
+// Loads the CSV in two passes: the first finds which columns are numeric
+// (and whether they print back exactly), the second fills the measure
+// arrays and dictionaries.
+bool loadFactTable(const string &fileName, FactTable &t) {
+    ifstream file(fileName);
+    if (!file.is_open()) return false;
     string line;
-    if (!getline(file, line)) return records;
+    if (!getline(file, line)) return true;
+    if (!line.empty() && line.back() == '\r') line.pop_back();
     stringstream ss(line);
     string col;
-    while (getline(ss, col, ',')) header.push_back(col);
+    while (getline(ss, col, ',')) t.header.push_back(col);
+    size_t m = t.header.size();
+
+    vector<string> cells;
+    vector<char> numeric(m, 1), exact(m, 1);
+    vector<int> decimals(m, -1);
+    double v;
+    size_t rows = 0;
+    while (getline(file, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty()) continue;
+        splitLine(line, m, cells);
+        for (size_t c = 0; c < m; c++) {
+            if (!numeric[c]) continue;
+            if (!parseNumber(cells[c], v)) {
+                numeric[c] = 0;
+                continue;
+            }
+            if (!exact[c]) continue;
+            size_t dot = cells[c].find('.');
+            int d = dot == string::npos ? 0 : cells[c].size() - dot - 1;
+            if (decimals[c] < 0) decimals[c] = d;
+            exact[c] = d == decimals[c] && d <= 30 && FactTable::formatNumber(v, d) == cells[c];
+        }
+        rows++;
+    }
 
+    t.rows = rows;
+    t.isMeasure = numeric;
+    t.decimals = decimals;
+    t.measure.assign(m, vector<double>());
+    t.code.assign(m, vector<uint32_t>());
+    t.dict.assign(m, vector<string>());
+    vector<unordered_map<string, uint32_t>> ids(m);
+    for (size_t c = 0; c < m; c++) {
+        if (numeric[c]) t.measure[c].reserve(rows);
+        if (!numeric[c] || !exact[c]) t.code[c].reserve(rows);
+    }
+    file.clear();
+    file.seekg(0);
+    getline(file, line);
     while (getline(file, line)) {
-        stringstream row(line);
-        string value;
-        map<string, string> record;
-        for (int i = 0; i < header.size(); i++) {
-            getline(row, value, ',');
-            record[header[i]] = value;
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty()) continue;
+        splitLine(line, m, cells);
+        for (size_t c = 0; c < m; c++) {
+            if (numeric[c]) {
+                parseNumber(cells[c], v);
+                t.measure[c].push_back(v);
+            }
+            if (!numeric[c] || !exact[c]) {
+                auto it = ids[c].emplace(cells[c], t.dict[c].size());
+                if (it.second) t.dict[c].push_back(cells[c]);
+                t.code[c].push_back(it.first->second);
+            }
         }
-        records.push_back(record);
     }
-    return records;
+    return true;
+}
+
+// Runs fn(t, begin, end) on one contiguous block of rows per thread and
+// returns the number of blocks
+template <class Fn>
+int parallelRows(size_t rows, Fn fn) {
+    int threads = rows < OLAP_PARALLEL_ROWS ? 1 : max(1, (int)thread::hardware_concurrency());
+    vector<thread> pool;
+    for (int t = 0; t < threads; t++) {
+        size_t b = rows * t / threads, e = rows * (t + 1) / threads;
+        if (t + 1 < threads) pool.emplace_back([=] { fn(t, b, e); });
+        else fn(t, b, e);
+    }
+    for (thread &th : pool) th.join();
+    return threads;
+}
+
+// ---------- Selection ----------
+// A filter "column = value" resolved once against the table: the value's
+// dictionary code, or its number for a measure. A value that never occurs
+// matches nothing without a scan.
+struct Condition {
+    int col = -1;
+    uint32_t code = NO_CODE;
+    double number = 0;
+    bool never = false;
+};
+
+// Returns false (with a message) if the field does not exist
+bool makeCondition(const FactTable &t, const string &field, const string &value, Condition &cond) {
+    cond.col = t.column(field);
+    if (cond.col < 0) {
+        cout << "Unknown field: " << field << endl;
+        return false;
+    }
+    if (t.isMeasure[cond.col]) {
+        cond.never = !parseNumber(value, cond.number);
+    } else {
+        const vector<string> &d = t.dict[cond.col];
+        auto it = find(d.begin(), d.end(), value);
+        cond.code = it - d.begin();
+        cond.never = it == d.end();
+    }
+    return true;
+}
+
+// Rows meeting every condition, in row order. Column at a time: the first
+// condition scans its whole column, each further one only keeps the rows
+// still selected.
+vector<uint32_t> selectRows(const FactTable &t, const vector<Condition> &conds) {
+    for (const Condition &c : conds)
+        if (c.never) return {};
+    vector<vector<uint32_t>> part(max(1, (int)thread::hardware_concurrency()));
+    int blocks = parallelRows(t.rows, [&](int th, size_t b, size_t e) {
+        vector<uint32_t> &sel = part[th];
+        for (size_t k = 0; k < conds.size(); k++) {
+            const Condition &c = conds[k];
+            size_t kept = 0;
+            if (t.isMeasure[c.col]) {
+                const double *x = t.measure[c.col].data();
+                if (k == 0) {
+                    for (size_t r = b; r < e; r++)
+                        if (x[r] == c.number) sel.push_back(r);
+                } else {
+                    for (uint32_t r : sel)
+                        if (x[r] == c.number) sel[kept++] = r;
+                    sel.resize(kept);
+                }
+            } else {
+                const uint32_t *x = t.code[c.col].data();
+                if (k == 0) {
+                    for (size_t r = b; r < e; r++)
+                        if (x[r] == c.code) sel.push_back(r);
+                } else {
+                    for (uint32_t r : sel)
+                        if (x[r] == c.code) sel[kept++] = r;
+                    sel.resize(kept);
+                }
+            }
+        }
+        if (conds.empty())
+            for (size_t r = b; r < e; r++) sel.push_back(r);
+    });
+    vector<uint32_t> rows = move(part[0]);
+    for (int th = 1; th < blocks; th++) rows.insert(rows.end(), part[th].begin(), part[th].end());
+    return rows;
+}
+
+// ---------- Aggregation ----------
+// Sum of a measure per group: sums[code] += value over flat arrays, one
+// partial sum array per thread. Groups come back ordered by label.
+vector<pair<string, double>> groupSums(FactTable &t, int groupCol, int numCol) {
+    t.ensureCodes(groupCol);
+    size_t groups = t.dict[groupCol].size();
+    vector<vector<double>> part(max(1, (int)thread::hardware_concurrency()));
+    int blocks = parallelRows(t.rows, [&](int th, size_t b, size_t e) {
+        vector<double> &sum = part[th];
+        sum.assign(groups, 0.0);
+        const uint32_t *g = t.code[groupCol].data();
+        const double *x = t.measure[numCol].data();
+        for (size_t r = b; r < e; r++) sum[g[r]] += x[r];
+    });
+    vector<pair<string, double>> out;
+    for (size_t k = 0; k < groups; k++) {
+        double s = 0;
+        for (int th = 0; th < blocks; th++) s += part[th][k];
+        out.push_back({t.dict[groupCol][k], s});
+    }
+    sort(out.begin(), out.end(), [](const pair<string, double> &a, const pair<string, double> &b) {
+        return a.first < b.first;
+    });
+    return out;
+}
+
+// Sum of a measure per (row value, column value) cell, as a dense
+// rowLabels x colLabels table (labels sorted); cells with no facts are 0.
+// Returns false if the table would exceed PIVOT_MAX_CELLS.
+const size_t PIVOT_MAX_CELLS = 1 << 24;
+
+bool pivotSums(FactTable &t, int rowCol, int colCol, int numCol, vector<string> &rowLabels,
+               vector<string> &colLabels, vector<double> &cells) {
+    t.ensureCodes(rowCol);
+    t.ensureCodes(colCol);
+    size_t nr = t.dict[rowCol].size(), nc = t.dict[colCol].size();
+    if (nr * nc > PIVOT_MAX_CELLS) return false;
+    vector<vector<double>> part(max(1, (int)thread::hardware_concurrency()));
+    int blocks = parallelRows(t.rows, [&](int th, size_t b, size_t e) {
+        vector<double> &sum = part[th];
+        sum.assign(nr * nc, 0.0);
+        const uint32_t *rc = t.code[rowCol].data(), *cc = t.code[colCol].data();
+        const double *x = t.measure[numCol].data();
+        for (size_t r = b; r < e; r++) sum[(size_t)rc[r] * nc + cc[r]] += x[r];
+    });
+
+    // Sorted label order, then the table in that order
+    auto sortedOrder = [](const vector<string> &d) {
+        vector<uint32_t> order(d.size());
+        iota(order.begin(), order.end(), 0);
+        sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return d[a] < d[b]; });
+        return order;
+    };
+    vector<uint32_t> ro = sortedOrder(t.dict[rowCol]), co = sortedOrder(t.dict[colCol]);
+    rowLabels.clear();
+    colLabels.clear();
+    for (uint32_t k : ro) rowLabels.push_back(t.dict[rowCol][k]);
+    for (uint32_t k : co) colLabels.push_back(t.dict[colCol][k]);
+    cells.assign(nr * nc, 0.0);
+    for (size_t i = 0; i < nr; i++)
+        for (size_t j = 0; j < nc; j++)
+            for (int th = 0; th < blocks; th++) cells[i * nc + j] += part[th][(size_t)ro[i] * nc + co[j]];
+    return true;
 }
 
 // Print record
-void printRecord(const map<string, string>& r, const vector<string>& header) {
-    for (const string& h : header)
-        cout << r.at(h) << " | ";
-    cout << endl;
+void printRecord(const FactTable& t, size_t r) {
+    for (size_t c = 0; c < t.header.size(); c++)
+        cout << t.text(c, r) << " | ";
+    cout << '\n';
 }
 
 // ✅ Renamed from 'slice' to 'sliceData'
-void sliceData(const vector<map<string, string>>& data, const string& field,
-               const string& value, const vector<string>& header) {
+void sliceData(const FactTable& t, const string& field, const string& value) {
+    Condition cond;
+    if (!makeCondition(t, field, value, cond)) return;
     cout << "\nSlice: " << field << " = " << value << endl;
-    for (const auto& r : data)
-        if (r.at(field) == value)
-            printRecord(r, header);
+    for (uint32_t r : selectRows(t, {cond}))
+        printRecord(t, r);
 }
 
 // Dice
-void dice(const vector<map<string, string>>& data, const map<string, string>& filters,
-          const vector<string>& header) {
-    cout << "\nDice result:\n";
-    for (const auto& r : data) {
-        bool match = true;
-        for (const auto& f : filters)
-            if (r.at(f.first) != f.second) { match = false; break; }
-        if (match) printRecord(r, header);
+void dice(const FactTable& t, const map<string, string>& filters) {
+    vector<Condition> conds;
+    for (const auto& f : filters) {
+        Condition cond;
+        if (!makeCondition(t, f.first, f.second, cond)) return;
+        conds.push_back(cond);
     }
+    cout << "\nDice result:\n";
+    for (uint32_t r : selectRows(t, conds))
+        printRecord(t, r);
 }
 
 // Roll-up
-void rollup(const vector<map<string, string>>& data, const string& groupField, const string& numericField) {
+void rollup(FactTable& t, const string& groupField, const string& numericField) {
+    int g = t.column(groupField), x = t.column(numericField);
+    if (g < 0 || x < 0) {
+        cout << "Unknown field: " << (g < 0 ? groupField : numericField) << endl;
+        return;
+    }
     cout << "\nRoll-Up by " << groupField << " (sum of " << numericField << ")\n";
-    map<string, double> totals;
-    for (const auto& r : data) {
-        try {
-            double val = stod(r.at(numericField));
-            totals[r.at(groupField)] += val;
-        } catch (...) {
-            cout << "Column not numeric!\n";
-            return;
-        }
+    if (!t.isMeasure[x]) {
+        cout << "Column not numeric!\n";
+        return;
     }
-    for (auto& t : totals)
-        cout << t.first << " → " << t.second << endl;
+    for (auto& total : groupSums(t, g, x))
+        cout << total.first << " → " << total.second << endl;
 }
 
 // Drill-down
-void drilldown(const vector<map<string, string>>& data, const vector<string>& header) {
+void drilldown(const FactTable& t) {
     cout << "\nDrill-down view:\n";
-    for (const auto& r : data)
-        printRecord(r, header);
+    for (size_t r = 0; r < t.rows; r++)
+        printRecord(t, r);
 }
 
 // Pivot
-void pivot(const vector<map<string, string>>& data, const string& rowField,
-           const string& colField, const string& numericField) {
+void pivot(FactTable& t, const string& rowField, const string& colField, const string& numericField) {
+    int rf = t.column(rowField), cf = t.column(colField), x = t.column(numericField);
+    if (rf < 0 || cf < 0 || x < 0) {
+        cout << "Unknown field: " << (rf < 0 ? rowField : cf < 0 ? colField : numericField) << endl;
+        return;
+    }
     cout << "\nPivot (" << rowField << " vs " << colField << ")\n";
-    map<string, map<string, double>> pivot;
-    set<string> colValues;
-
-    for (const auto& r : data) {
-        try {
-            double val = stod(r.at(numericField));
-            string row = r.at(rowField);
-            string col = r.at(colField);
-            colValues.insert(col);
-            pivot[row][col] += val;
-        } catch (...) {
-            cout << "Column not numeric!\n";
-            return;
-        }
+    if (!t.isMeasure[x]) {
+        cout << "Column not numeric!\n";
+        return;
+    }
+    vector<string> rowValues, colValues;
+    vector<double> cells;
+    if (!pivotSums(t, rf, cf, x, rowValues, colValues, cells)) {
+        cout << "Too many cells to pivot; slice or dice first.\n";
+        return;
     }
 
     cout << rowField << "\t";
     for (const string& col : colValues) cout << col << "\t";
     cout << endl;
 
-    for (const auto& rowPair : pivot) {
-        cout << rowPair.first << "\t";
-        for (const string& col : colValues)
-            cout << rowPair.second.at(col) << "\t";
+    for (size_t i = 0; i < rowValues.size(); i++) {
+        cout << rowValues[i] << "\t";
+        for (size_t j = 0; j < colValues.size(); j++)
+            cout << cells[i * colValues.size() + j] << "\t";
         cout << endl;
     }
 }
@@ -117,16 +398,16 @@ int main() {
     cout << "Enter CSV file name: ";
     getline(cin, fileName);
 
-    vector<string> header;
-    vector<map<string, string>> data = readCSV(fileName, header);
+    FactTable data;
+    if (!loadFactTable(fileName, data)) cout << "Error opening file!" << endl;
 
-    if (data.empty()) {
+    if (data.rows == 0) {
         cout << "No data found!\n";
         return 0;
     }
 
     cout << "\nColumns: ";
-    for (auto& h : header) cout << h << " ";
+    for (auto& h : data.header) cout << h << " ";
     cout << endl;
 
     while (true) {
@@ -135,13 +416,13 @@ int main() {
         int ch; cin >> ch; cin.ignore();
 
         if (ch == 1) {
-            for (auto& r : data) printRecord(r, header);
+            for (size_t r = 0; r < data.rows; r++) printRecord(data, r);
 
         } else if (ch == 2) {
             string field, value;
             cout << "Field: "; getline(cin, field);
             cout << "Value: "; getline(cin, value);
-            sliceData(data, field, value, header);  // ✅ renamed
+            sliceData(data, field, value);  // ✅ renamed
 
         } else if (ch == 3) {
             int n;
@@ -153,7 +434,7 @@ int main() {
                 cout << "Value: "; getline(cin, v);
                 filters[f] = v;
             }
-            dice(data, filters, header);
+            dice(data, filters);
 
         } else if (ch == 4) {
             string group, num;
@@ -162,7 +443,7 @@ int main() {
             rollup(data, group, num);
 
         } else if (ch == 5) {
-            drilldown(data, header);
+            drilldown(data);
 
         } else if (ch == 6) {
             string row, col, num;
@@ -179,4 +460,4 @@ int main() {
         }
     }
     return 0;
-}
\ No newline at end of file
+}
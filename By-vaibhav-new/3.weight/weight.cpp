@@ -2,8 +2,66 @@
 #include <fstream>
 #include <sstream>
 #include <vector>
+#include <string>
+#include <charconv>
 using namespace std;
 
+// ---------- Buffered CSV Writer ----------
+// Copy of the CsvWriter in By-girl-new/normal.cpp, trimmed to the calls
+// this program makes (numbers in the default %g, 6-digit form).
+class CsvWriter {
+public:
+    explicit CsvWriter(const string &filename, size_t bufferSize = 1 << 20)
+        : out(filename), limit(bufferSize) {
+        buf.reserve(bufferSize + 4096);
+    }
+    ~CsvWriter() { flush(); }
+
+    CsvWriter &cell(const string &s) { sep(); buf += s; return *this; }
+    CsvWriter &cell(int v) {
+        sep();
+        char tmp[16];
+        buf.append(tmp, to_chars(tmp, tmp + sizeof(tmp), v).ptr);
+        return *this;
+    }
+    CsvWriter &cell(double v) {
+        sep();
+        char tmp[400];
+        buf.append(tmp, to_chars(tmp, tmp + sizeof(tmp), v, chars_format::general, 6).ptr);
+        return *this;
+    }
+
+    // Appends text to the current cell (e.g. a "%" after a number)
+    CsvWriter &raw(const string &s) { buf += s; return *this; }
+
+    CsvWriter &endRow() {
+        buf += '\n';
+        first = true;
+        if (buf.size() >= limit) {
+            out.write(buf.data(), buf.size());
+            buf.clear();
+        }
+        return *this;
+    }
+
+    void flush() {
+        if (!buf.empty()) out.write(buf.data(), buf.size());
+        buf.clear();
+        out.flush();
+    }
+
+private:
+    ofstream out;
+    string buf;
+    size_t limit;
+    bool first = true;
+
+    void sep() {
+        if (!first) buf += ',';
+        first = false;
+    }
+};
+
 struct Row {
     string class_name;
     int cat1;
@@ -44,8 +102,9 @@ int main() {
     }
     file.close();
 
-    ofstream out("twt_dwt_output.csv");
-    out << "Class,Category1,Twt,Dwt,Category2,Twt,Dwt,Total\n";
+    CsvWriter out("twt_dwt_output.csv");
+    for (const char *h : {"Class", "Category1", "Twt", "Dwt", "Category2", "Twt", "Dwt", "Total"}) out.cell(h);
+    out.endRow();
 
     cout << "\nTwt and Dwt Results:\n\n";
     cout << "Class         Cat1   Twt%   Dwt%   Cat2   Twt%   Dwt%   Total\n";
@@ -65,17 +124,17 @@ int main() {
              << "   " << cat2 << "   " << cat2Twt << "   " << cat2Dwt
              << "   " << total << endl;
 
-        out << name << "," << cat1 << "," << cat1Twt << "%," << cat1Dwt << "%,"
-            << cat2 << "," << cat2Twt << "%," << cat2Dwt << "%," << total << "\n";
+        out.cell(name).cell(cat1).cell(cat1Twt).raw("%").cell(cat1Dwt).raw("%");
+        out.cell(cat2).cell(cat2Twt).raw("%").cell(cat2Dwt).raw("%").cell(total).endRow();
     }
 
     cout << "Total         " << totalCat1 << "   100   100   " << totalCat2
          << "   100   100   " << totalCat1 + totalCat2 << endl;
 
-    out << "Total," << totalCat1 << ",100%,100%," << totalCat2
-        << ",100%,100%," << totalCat1 + totalCat2 << "\n";
+    out.cell("Total").cell(totalCat1).cell("100%").cell("100%").cell(totalCat2);
+    out.cell("100%").cell("100%").cell(totalCat1 + totalCat2).endRow();
 
-    out.close();
+    out.flush();
 
     cout << "\nSaved to twt_dwt_output.csv\n";
     return 0;
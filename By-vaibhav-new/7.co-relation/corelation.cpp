@@ -1,50 +1,899 @@
 #include<bits/stdc++.h>
 using namespace std;
 
+// ---------- Correlation Matrix Engine ----------
+// Every column is standardized once, z = (x - mean) / sqrt(sum (x - mean)^2),
+// so that Z^T Z is the Pearson matrix itself: one symmetric matrix product
+// instead of a pass over all rows for every pair of columns. Covariance
+// follows from the same product, cov(i,j) = r(i,j) * s_i * s_j.
+//
+// The data is one contiguous row-major n x m block. Only the upper triangle
+// of Z^T Z is computed, in CORR_TILE x CORR_TILE output tiles; threads take
+// tiles one at a time, so no two threads write the same element and the
+// result does not depend on the thread count. Inside a tile the kernel works
+// on 4 rows of Z and 2 rows of the tile at a time, with the innermost loop
+// running along a contiguous row (it vectorizes).
+const int CORR_TILE = 128;
+const double CORR_PARALLEL_WORK = 1e7;   // n * m * m below this: one thread
+
+struct CorrelationResult {
+    int m = 0;
+    size_t n = 0;
+    vector<double> mean, sd;      // sd: sample standard deviation (n - 1)
+    vector<double> corr, cov;     // m x m, row-major
+};
+
+// T[i - i0][j - j0] += sum of Z[r][i] * Z[r][j] over all rows, for i in
+// [i0, i1), j in [j0, j1) and j >= i; ldt is the row length of T
+void tileAccumulate(const double *Z, size_t n, int m, int i0, int i1, int j0, int j1, double *T, size_t ldt) {
+    size_t r = 0;
+    for (; r + 4 <= n; r += 4) {
+        const double *z0 = Z + r * m, *z1 = z0 + m, *z2 = z1 + m, *z3 = z2 + m;
+        int i = i0;
+        for (; i + 2 <= i1; i += 2) {
+            double a0 = z0[i], a1 = z1[i], a2 = z2[i], a3 = z3[i];
+            double b0 = z0[i + 1], b1 = z1[i + 1], b2 = z2[i + 1], b3 = z3[i + 1];
+            double *gi = T + (size_t)(i - i0) * ldt, *gk = gi + ldt;
+            if (j0 <= i) gi[i - j0] += a0 * a0 + a1 * a1 + a2 * a2 + a3 * a3;
+            for (int j = max(j0, i + 1); j < j1; ++j) {
+                double v0 = z0[j], v1 = z1[j], v2 = z2[j], v3 = z3[j];
+                gi[j - j0] += a0 * v0 + a1 * v1 + a2 * v2 + a3 * v3;
+                gk[j - j0] += b0 * v0 + b1 * v1 + b2 * v2 + b3 * v3;
+            }
+        }
+        for (; i < i1; ++i) {
+            double a0 = z0[i], a1 = z1[i], a2 = z2[i], a3 = z3[i];
+            double *gi = T + (size_t)(i - i0) * ldt;
+            for (int j = max(j0, i); j < j1; ++j) gi[j - j0] += a0 * z0[j] + a1 * z1[j] + a2 * z2[j] + a3 * z3[j];
+        }
+    }
+    for (; r < n; ++r) {
+        const double *z = Z + r * m;
+        for (int i = i0; i < i1; ++i) {
+            double *gi = T + (size_t)(i - i0) * ldt;
+            for (int j = max(j0, i); j < j1; ++j) gi[j - j0] += z[i] * z[j];
+        }
+    }
+}
+
+// Runs fn(t, begin, end) on one contiguous block of [0, n) per thread
+template <class Fn>
+void parallelBlocks(size_t n, int threads, Fn fn) {
+    vector<thread> pool;
+    for (int t = 0; t < threads; t++) {
+        size_t b = n * t / threads, e = n * (t + 1) / threads;
+        pool.emplace_back([=] { fn(t, b, e); });
+    }
+    for (thread &th : pool) th.join();
+}
+
+// Runs fn(t, k) for every k in [0, count), handing out one k at a time to
+// each of the threads (t is the thread's number)
+template <class Fn>
+void parallelFor(size_t count, int threads, Fn fn) {
+    atomic<size_t> next(0);
+    threads = (int)min<size_t>(threads, max<size_t>(count, 1));
+    parallelBlocks(threads, threads, [&](int t, size_t, size_t) {
+        for (size_t k; (k = next++) < count;) fn(t, k);
+    });
+}
+
+// Overwrites the n x m row-major data with its standardized columns and
+// fills the column means and sums of squared deviations
+void standardize(vector<double> &data, size_t n, int m, int threads, vector<double> &mean, vector<double> &ss) {
+    // Column means, then sums of squared deviations: per-thread partial
+    // sums over row blocks, added in block order
+    vector<vector<double>> part(threads, vector<double>(m, 0.0));
+    parallelBlocks(n, threads, [&](int t, size_t b, size_t e) {
+        double *s = part[t].data();
+        for (size_t r = b; r < e; r++) {
+            const double *x = &data[r * m];
+            for (int j = 0; j < m; j++) s[j] += x[j];
+        }
+    });
+    mean.assign(m, 0.0);
+    for (int t = 0; t < threads; t++)
+        for (int j = 0; j < m; j++) mean[j] += part[t][j];
+    for (int j = 0; j < m; j++) mean[j] /= n;
+
+    for (auto &p : part) fill(p.begin(), p.end(), 0.0);
+    parallelBlocks(n, threads, [&](int t, size_t b, size_t e) {
+        double *s = part[t].data();
+        const double *mu = mean.data();
+        for (size_t r = b; r < e; r++) {
+            const double *x = &data[r * m];
+            for (int j = 0; j < m; j++) s[j] += (x[j] - mu[j]) * (x[j] - mu[j]);
+        }
+    });
+    ss.assign(m, 0.0);
+    vector<double> scale(m, 0.0);
+    for (int t = 0; t < threads; t++)
+        for (int j = 0; j < m; j++) ss[j] += part[t][j];
+    for (int j = 0; j < m; j++)
+        if (ss[j] > 0) scale[j] = 1 / sqrt(ss[j]);
+
+    parallelBlocks(n, threads, [&](int, size_t b, size_t e) {
+        const double *mu = mean.data(), *sc = scale.data();
+        for (size_t r = b; r < e; r++) {
+            double *x = &data[r * m];
+            for (int j = 0; j < m; j++) x[j] = (x[j] - mu[j]) * sc[j];
+        }
+    });
+}
+
+// Pearson and covariance matrices of the n x m row-major data, which is
+// overwritten with the standardized values. Needs n >= 2. A constant
+// column has correlation 0 with every column, as before.
+CorrelationResult correlationMatrix(vector<double> &data, size_t n, int m) {
+    CorrelationResult R;
+    R.n = n;
+    R.m = m;
+    int threads = (double)n * m * m < CORR_PARALLEL_WORK ? 1 : max(1, (int)thread::hardware_concurrency());
+    vector<double> ss;
+    standardize(data, n, m, threads, R.mean, ss);
+    R.sd.assign(m, 0.0);
+    for (int j = 0; j < m; j++) R.sd[j] = sqrt(ss[j] / (n - 1));
+
+    // Z^T Z, upper triangle, tile by tile
+    vector<pair<int, int>> tiles;
+    for (int i0 = 0; i0 < m; i0 += CORR_TILE)
+        for (int j0 = i0; j0 < m; j0 += CORR_TILE) tiles.push_back({i0, j0});
+    R.corr.assign((size_t)m * m, 0.0);
+    parallelFor(tiles.size(), threads, [&](int, size_t k) {
+        int i0 = tiles[k].first, j0 = tiles[k].second;
+        tileAccumulate(data.data(), n, m, i0, min(m, i0 + CORR_TILE), j0, min(m, j0 + CORR_TILE),
+                       &R.corr[(size_t)i0 * m + j0], m);
+    });
+
+    // Mirror, clamp rounding past +-1, and scale to covariance
+    R.cov.assign((size_t)m * m, 0.0);
+    for (int i = 0; i < m; i++) {
+        for (int j = i; j < m; j++) {
+            double r = i == j ? (ss[i] > 0 ? 1.0 : 0.0) : min(1.0, max(-1.0, R.corr[(size_t)i * m + j]));
+            R.corr[(size_t)i * m + j] = R.corr[(size_t)j * m + i] = r;
+            R.cov[(size_t)i * m + j] = R.cov[(size_t)j * m + i] = i == j ? ss[i] / (n - 1) : r * R.sd[i] * R.sd[j];
+        }
+    }
+    return R;
+}
+
+// ---------- Rank Correlation ----------
+// Spearman's rho is Pearson's r on the ranks (ties get their average rank),
+// so every column is ranked once, columns in parallel, and the ranks go
+// through correlationMatrix. Kendall's tau-b uses Knight's algorithm: with
+// the rows ordered by x (then y), every discordant pair is an inversion of
+// the y sequence, and a merge sort counts those in O(n log n) instead of
+// comparing all n^2 pairs. Tied pairs are left out as in tau-b; a constant
+// column gives 0, as for Pearson.
+
+// A column's rows in ascending order, the dense rank (0, 1, ...) of each
+// row, and the number of pairs tied on it
+struct RankedColumn {
+    vector<int> order, dense;
+    long long ties = 0;
+};
+
+RankedColumn rankColumn(const double *x, size_t n, int stride) {
+    vector<double> v(n);
+    for (size_t r = 0; r < n; r++) v[r] = x[r * stride];
+    RankedColumn c;
+    c.order.resize(n);
+    c.dense.resize(n);
+    iota(c.order.begin(), c.order.end(), 0);
+    sort(c.order.begin(), c.order.end(), [&](int a, int b) { return v[a] < v[b] || (v[a] == v[b] && a < b); });
+    int rank = -1;
+    size_t run = 0;
+    for (size_t k = 0; k < n; k++) {
+        if (k == 0 || v[c.order[k]] != v[c.order[k - 1]]) {
+            c.ties += (long long)run * (run - 1) / 2;
+            run = 0;
+            rank++;
+        }
+        run++;
+        c.dense[c.order[k]] = rank;
+    }
+    c.ties += (long long)run * (run - 1) / 2;
+    return c;
+}
+
+// Replaces each value of the column by its average rank (1-based)
+void averageRanks(double *x, size_t n, int stride) {
+    RankedColumn c = rankColumn(x, n, stride);
+    for (size_t k = 0; k < n;) {
+        size_t e = k;
+        while (e < n && c.dense[c.order[e]] == c.dense[c.order[k]]) e++;
+        double r = (k + 1 + e) / 2.0;
+        for (size_t t = k; t < e; t++) x[(size_t)c.order[t] * stride] = r;
+        k = e;
+    }
+}
+
+// Sorts a[0, n) and returns the number of pairs i < j with a[i] > a[j]
+// (bottom-up merge sort; tmp needs n elements)
+long long countInversions(int *a, int *tmp, size_t n) {
+    long long inv = 0;
+    for (size_t w = 1; w < n; w *= 2) {
+        for (size_t lo = 0; lo < n; lo += 2 * w) {
+            size_t mid = min(n, lo + w), hi = min(n, lo + 2 * w), i = lo, j = mid, k = lo;
+            while (i < mid && j < hi) {
+                if (a[j] < a[i]) {
+                    inv += mid - i;
+                    tmp[k++] = a[j++];
+                } else {
+                    tmp[k++] = a[i++];
+                }
+            }
+            while (i < mid) tmp[k++] = a[i++];
+            while (j < hi) tmp[k++] = a[j++];
+        }
+        copy(tmp, tmp + n, a);
+    }
+    return inv;
+}
+
+struct KendallCounts {
+    long long pairs = 0, tiesX = 0, tiesY = 0, tiesXY = 0, discordant = 0;
+
+    long long concordant() const { return pairs - tiesX - tiesY + tiesXY - discordant; }
+    double tau() const {
+        if (pairs == tiesX || pairs == tiesY) return 0;
+        return (concordant() - discordant) / sqrt((double)(pairs - tiesX) * (pairs - tiesY));
+    }
+};
+
+// Knight's algorithm on two ranked columns; seq and tmp are scratch space
+KendallCounts kendallCounts(const RankedColumn &X, const RankedColumn &Y, vector<int> &seq, vector<int> &tmp) {
+    size_t n = X.order.size();
+    KendallCounts k;
+    k.pairs = (long long)n * (n - 1) / 2;
+    k.tiesX = X.ties;
+    k.tiesY = Y.ties;
+    seq.resize(n);
+    tmp.resize(n);
+    for (size_t s = 0; s < n;) {
+        size_t e = s;
+        while (e < n && X.dense[X.order[e]] == X.dense[X.order[s]]) {
+            seq[e] = Y.dense[X.order[e]];
+            e++;
+        }
+        if (e - s > 1) {
+            sort(seq.begin() + s, seq.begin() + e);
+            for (size_t a = s; a < e;) {
+                size_t b = a;
+                while (b < e && seq[b] == seq[a]) b++;
+                k.tiesXY += (long long)(b - a) * (b - a - 1) / 2;
+                a = b;
+            }
+        }
+        s = e;
+    }
+    k.discordant = countInversions(seq.data(), tmp.data(), n);
+    return k;
+}
+
+// Spearman matrix; the data (n x m) is replaced by its column ranks
+CorrelationResult spearmanMatrix(vector<double> &data, size_t n, int m) {
+    int threads = (double)n * m < CORR_PARALLEL_WORK ? 1 : max(1, (int)thread::hardware_concurrency());
+    parallelFor(m, threads, [&](int, size_t j) { averageRanks(&data[j], n, m); });
+    return correlationMatrix(data, n, m);
+}
+
+// Kendall's tau-b of every pair of columns (m x m, row-major); each column
+// is ranked once and the pairs are shared out among the threads
+vector<double> kendallMatrix(const vector<double> &data, size_t n, int m) {
+    int threads = (double)n * m * m < CORR_PARALLEL_WORK ? 1 : max(1, (int)thread::hardware_concurrency());
+    vector<RankedColumn> cols(m);
+    parallelFor(m, threads, [&](int, size_t j) { cols[j] = rankColumn(&data[j], n, m); });
+
+    vector<pair<int, int>> pairs;
+    for (int i = 0; i < m; i++)
+        for (int j = i + 1; j < m; j++) pairs.push_back({i, j});
+    vector<double> tau((size_t)m * m, 0.0);
+    vector<vector<int>> seq(threads), tmp(threads);
+    parallelFor(pairs.size(), threads, [&](int t, size_t k) {
+        int i = pairs[k].first, j = pairs[k].second;
+        tau[(size_t)i * m + j] = tau[(size_t)j * m + i] = kendallCounts(cols[i], cols[j], seq[t], tmp[t]).tau();
+    });
+    long long allPairs = (long long)n * (n - 1) / 2;
+    for (int i = 0; i < m; i++) tau[(size_t)i * m + i] = cols[i].ties < allPairs ? 1.0 : 0.0;
+    return tau;
+}
+
+// ---------- Strongest Pairs ----------
+// With tens of thousands of columns the m x m matrix does not fit (50k
+// columns: 20 GB) and nobody reads a line for each of its pairs. This mode
+// keeps only the pairs asked for: every pair with |r| >= threshold, or the
+// k strongest partners of each column. Z^T Z is computed tile by tile into
+// a per-thread CORR_TILE x CORR_TILE buffer that is filtered at once and
+// reused, so memory is the data plus the hits (or the per-thread bounded
+// heaps, k entries per column), never m x m.
+//
+// The threshold search can first screen pairs by random projection
+// (SimHash): each standardized column is projected on PAIR_SIGNATURE_BITS
+// random +-1 directions and keeps only the signs. Two columns at angle
+// theta (r = cos theta) disagree on a sign with probability about
+// theta / pi, so a few popcounts estimate r. A pair goes on to the exact
+// n-row dot product unless its estimate is PAIR_SIGNATURE_SIGMAS standard
+// deviations short of the threshold. Every reported r is exact; the
+// screen may, rarely, miss a pair near the threshold.
+const int PAIR_SIGNATURE_BITS = 256;
+const double PAIR_SIGNATURE_SIGMAS = 4;
+
+struct PairHit {
+    double r;
+    int i, j;
+};
+
+// Stronger first; equally strong pairs by column number, so that the
+// result does not depend on the thread count
+bool strongerPair(const PairHit &a, const PairHit &b) {
+    if (fabs(a.r) != fabs(b.r)) return fabs(a.r) > fabs(b.r);
+    return a.i != b.i ? a.i < b.i : a.j < b.j;
+}
+
+bool byColumns(const PairHit &a, const PairHit &b) { return a.i != b.i ? a.i < b.i : a.j < b.j; }
+
+// Calls onPair(t, i, j, r) for every pair i < j of the standardized n x m
+// data, one output tile at a time
+template <class Fn>
+void forEachPair(const vector<double> &Z, size_t n, int m, int threads, Fn onPair) {
+    vector<pair<int, int>> tiles;
+    for (int i0 = 0; i0 < m; i0 += CORR_TILE)
+        for (int j0 = i0; j0 < m; j0 += CORR_TILE) tiles.push_back({i0, j0});
+    vector<vector<double>> buffer(threads, vector<double>((size_t)CORR_TILE * CORR_TILE));
+    parallelFor(tiles.size(), threads, [&](int t, size_t k) {
+        int i0 = tiles[k].first, j0 = tiles[k].second;
+        int i1 = min(m, i0 + CORR_TILE), j1 = min(m, j0 + CORR_TILE);
+        double *T = buffer[t].data();
+        fill(buffer[t].begin(), buffer[t].end(), 0.0);
+        tileAccumulate(Z.data(), n, m, i0, i1, j0, j1, T, CORR_TILE);
+        for (int i = i0; i < i1; i++)
+            for (int j = max(j0, i + 1); j < j1; j++)
+                onPair(t, i, j, min(1.0, max(-1.0, T[(size_t)(i - i0) * CORR_TILE + (j - j0)])));
+    });
+}
+
+// Largest |cos theta| for a Hamming distance h of b signature bits, with
+// the estimate widened by PAIR_SIGNATURE_SIGMAS standard deviations
+double signatureBound(int h, int b) {
+    double p = (double)h / b, margin = PAIR_SIGNATURE_SIGMAS * 0.5 / sqrt((double)b);
+    double lo = max(0.0, p - margin), hi = min(1.0, p + margin);
+    if (lo == 0 || hi == 1) return 1;
+    return max(fabs(cos(M_PI * lo)), fabs(cos(M_PI * hi)));
+}
+
+// All pairs with |r| >= threshold, ordered by column numbers. The data
+// must be standardized; with screening it is replaced by its transpose.
+vector<PairHit> thresholdPairs(vector<double> &Z, size_t n, int m, double threshold, bool screen) {
+    int threads = (double)n * m * m < CORR_PARALLEL_WORK ? 1 : max(1, (int)thread::hardware_concurrency());
+    vector<vector<PairHit>> hits(threads);
+    if (!screen) {
+        forEachPair(Z, n, m, threads, [&](int t, int i, int j, double r) {
+            if (fabs(r) >= threshold) hits[t].push_back({r, i, j});
+        });
+    } else {
+        // Random +-1 directions, one bit each (fixed seed: runs repeat
+        // exactly). Signatures are built 64 columns at a time: the bits of
+        // a panel of rows are expanded to +-1 and every row of the panel
+        // adds z * direction to the column's projections (a vectorized
+        // row update, as in tileAccumulate).
+        const int W = PAIR_SIGNATURE_BITS / 64, BLOCK = 64, PANEL = 256;
+        vector<uint64_t> dir(n * W);
+        mt19937_64 rng(20240613);
+        for (uint64_t &w : dir) w = rng();
+        vector<uint64_t> sig((size_t)m * W, 0);
+        vector<char> constant(m, 0);
+        vector<vector<double>> proj(threads, vector<double>((size_t)BLOCK * PAIR_SIGNATURE_BITS));
+        vector<vector<double>> panel(threads, vector<double>((size_t)PANEL * PAIR_SIGNATURE_BITS));
+        parallelFor((m + BLOCK - 1) / BLOCK, threads, [&](int t, size_t blk) {
+            int c0 = blk * BLOCK, c1 = min(m, c0 + BLOCK);
+            double *P = proj[t].data(), *D = panel[t].data();
+            fill(proj[t].begin(), proj[t].end(), 0.0);
+            for (size_t r0 = 0; r0 < n; r0 += PANEL) {
+                size_t r1 = min(n, r0 + PANEL);
+                for (size_t r = r0; r < r1; r++)
+                    for (int k = 0; k < PAIR_SIGNATURE_BITS; k++)
+                        D[(r - r0) * PAIR_SIGNATURE_BITS + k] = (dir[r * W + k / 64] >> (k % 64) & 1) ? 1.0 : -1.0;
+                for (size_t r = r0; r < r1; r++) {
+                    const double *z = &Z[r * m], *d = &D[(r - r0) * PAIR_SIGNATURE_BITS];
+                    for (int j = c0; j < c1; j++) {
+                        double zj = z[j];
+                        if (zj == 0) continue;
+                        double *pj = P + (size_t)(j - c0) * PAIR_SIGNATURE_BITS;
+                        for (int k = 0; k < PAIR_SIGNATURE_BITS; k++) pj[k] += zj * d[k];
+                    }
+                }
+            }
+            for (int j = c0; j < c1; j++) {
+                const double *pj = P + (size_t)(j - c0) * PAIR_SIGNATURE_BITS;
+                bool zero = true;
+                for (int k = 0; k < PAIR_SIGNATURE_BITS; k++) {
+                    if (pj[k] != 0) zero = false;
+                    if (pj[k] >= 0) sig[(size_t)j * W + k / 64] |= 1ULL << (k % 64);
+                }
+                constant[j] = zero;
+            }
+        });
+
+        // Column-major copy for the exact check, so a column's values are
+        // contiguous
+        vector<double> Zt((size_t)m * n);
+        for (size_t r = 0; r < n; r++)
+            for (int j = 0; j < m; j++) Zt[(size_t)j * n + r] = Z[r * m + j];
+        vector<double>().swap(Z);
+
+        // Bound for every possible distance, then screen and verify
+        vector<char> candidate(PAIR_SIGNATURE_BITS + 1);
+        for (int h = 0; h <= PAIR_SIGNATURE_BITS; h++)
+            candidate[h] = signatureBound(h, PAIR_SIGNATURE_BITS) >= threshold;
+        parallelFor(m, threads, [&](int t, size_t i) {
+            if (constant[i]) return;
+            const uint64_t *si = &sig[i * W];
+            const double *zi = &Zt[i * n];
+            for (int j = i + 1; j < m; j++) {
+                const uint64_t *sj = &sig[(size_t)j * W];
+                int h = 0;
+                for (int w = 0; w < W; w++) h += __builtin_popcountll(si[w] ^ sj[w]);
+                if (!candidate[h] || constant[j]) continue;
+                const double *zj = &Zt[(size_t)j * n];
+                double d0 = 0, d1 = 0, d2 = 0, d3 = 0;
+                size_t r = 0;
+                for (; r + 4 <= n; r += 4) {
+                    d0 += zi[r] * zj[r];
+                    d1 += zi[r + 1] * zj[r + 1];
+                    d2 += zi[r + 2] * zj[r + 2];
+                    d3 += zi[r + 3] * zj[r + 3];
+                }
+                for (; r < n; r++) d0 += zi[r] * zj[r];
+                double v = min(1.0, max(-1.0, (d0 + d1) + (d2 + d3)));
+                if (fabs(v) >= threshold) hits[t].push_back({v, (int)i, j});
+            }
+        });
+    }
+    vector<PairHit> all;
+    for (auto &h : hits) all.insert(all.end(), h.begin(), h.end());
+    sort(all.begin(), all.end(), byColumns);
+    return all;
+}
+
+// The k strongest partners of every column (best first). Each thread
+// keeps a bounded heap per column, weakest on top; the heaps of all
+// threads are combined per column at the end.
+vector<vector<PairHit>> topPairs(const vector<double> &Z, size_t n, int m, int k) {
+    int threads = (double)n * m * m < CORR_PARALLEL_WORK ? 1 : max(1, (int)thread::hardware_concurrency());
+    vector<vector<vector<PairHit>>> heaps(threads, vector<vector<PairHit>>(m));
+    auto offer = [&](vector<PairHit> &h, const PairHit &p) {
+        if ((int)h.size() < k) {
+            h.push_back(p);
+            push_heap(h.begin(), h.end(), strongerPair);
+        } else if (strongerPair(p, h.front())) {
+            pop_heap(h.begin(), h.end(), strongerPair);
+            h.back() = p;
+            push_heap(h.begin(), h.end(), strongerPair);
+        }
+    };
+    forEachPair(Z, n, m, threads, [&](int t, int i, int j, double r) {
+        offer(heaps[t][i], {r, i, j});
+        offer(heaps[t][j], {r, i, j});
+    });
+    vector<vector<PairHit>> best(m);
+    for (int c = 0; c < m; c++) {
+        for (int t = 0; t < threads; t++) best[c].insert(best[c].end(), heaps[t][c].begin(), heaps[t][c].end());
+        sort(best[c].begin(), best[c].end(), strongerPair);
+        if ((int)best[c].size() > k) best[c].resize(k);
+    }
+    return best;
+}
+
+// ---------- Read Data ----------
+// One CSV line into the row: every cell must be a number. Returns false for
+// an empty line or a cell that is not.
+bool parseRow(const char *p, const char *end, vector<double> &row) {
+    row.clear();
+    if (p == end) return false;
+    while (true) {
+        const char *comma = find(p, end, ',');
+        const char *b = p, *e = comma;
+        while (b < e && isspace((unsigned char)*b)) b++;
+        while (e > b && isspace((unsigned char)e[-1])) e--;
+        if (b < e && *b == '+') b++;
+        double v;
+        auto r = from_chars(b, e, v);
+        if (b == e || r.ec != errc() || r.ptr != e) return false;
+        row.push_back(v);
+        if (comma == end) return true;
+        p = comma + 1;
+    }
+}
+
+// ---------- Streaming Co-Moments ----------
+// Pearson and covariance in one pass at constant memory. The accumulator
+// keeps the weight n, the column means and the co-moments
+// C[i][j] = sum (x_i - mean_i)(x_j - mean_j) (upper triangle), updated per
+// row by the pairwise Welford step
+//     d = x - mean,  mean += d / n,  C[i][j] += d_i * (x_j - mean_j),
+// which works on deviations from the running mean, so large values with a
+// small spread lose no precision (unlike n * sum xy - sum x * sum y).
+// Two accumulators over different rows merge exactly (Chan et al.):
+//     C = C_a + C_b + (mean_b - mean_a)_i (mean_b - mean_a)_j * n_a n_b / n,
+// so threads and shards each fill their own and combine at the end.
+//
+// decay < 1 turns it into an exponentially weighted accumulator: old weight
+// and co-moments shrink by 'decay' before each row, so recent rows count
+// most (effective memory about 1 / (1 - decay) rows).
+struct CoMoments {
+    int m = 0;
+    double n = 0;
+    vector<double> mean, C;
+    vector<double> d;             // scratch: deviations of the current row
+
+    void init(int cols) {
+        m = cols;
+        n = 0;
+        mean.assign(m, 0.0);
+        C.assign((size_t)m * m, 0.0);
+        d.assign(m, 0.0);
+    }
+
+    void add(const double *x, double decay = 1) {
+        if (decay != 1) {
+            n *= decay;
+            for (double &c : C) c *= decay;
+        }
+        n += 1;
+        for (int j = 0; j < m; j++) {
+            d[j] = x[j] - mean[j];
+            mean[j] += d[j] / n;
+        }
+        for (int i = 0; i < m; i++) {
+            double *ci = &C[(size_t)i * m];
+            double di = d[i];
+            for (int j = i; j < m; j++) ci[j] += di * (x[j] - mean[j]);
+        }
+    }
+
+    void merge(const CoMoments &o) {
+        if (o.n == 0) return;
+        if (n == 0) {
+            *this = o;
+            return;
+        }
+        double total = n + o.n, f = n * o.n / total;
+        for (int j = 0; j < m; j++) d[j] = o.mean[j] - mean[j];
+        for (int i = 0; i < m; i++)
+            for (int j = i; j < m; j++) C[(size_t)i * m + j] += o.C[(size_t)i * m + j] + d[i] * d[j] * f;
+        for (int j = 0; j < m; j++) mean[j] += d[j] * o.n / total;
+        n = total;
+    }
+
+    double covariance(int i, int j) const {
+        if (i > j) swap(i, j);
+        return n > 1 ? C[(size_t)i * m + j] / (n - 1) : 0;
+    }
+
+    // A constant column has correlation 0, as in correlationMatrix
+    double correlation(int i, int j) const {
+        if (i > j) swap(i, j);
+        double den = C[(size_t)i * m + i] * C[(size_t)j * m + j];
+        return den > 0 ? min(1.0, max(-1.0, C[(size_t)i * m + j] / sqrt(den))) : 0;
+    }
+};
+
+// Correlation over (about) the last 'window' rows, for live monitoring.
+// The stream is cut into panes of window / panes rows, each with its own
+// accumulator; the window is the current pane merged with the previous
+// full ones, and the oldest pane is dropped whole when a new one fills.
+// Nothing is ever subtracted, so the statistics do not drift however long
+// the stream runs. The window covers between (panes - 1) and panes panes.
+struct WindowedCoMoments {
+    int m = 0, panes = 8;
+    long long paneRows = 1;
+    deque<CoMoments> full;
+    CoMoments current;
+
+    void init(int cols, long long window, int numPanes = 8) {
+        m = cols;
+        panes = max(2, numPanes);
+        paneRows = max(1LL, window / panes);
+        full.clear();
+        current.init(m);
+    }
+
+    void add(const double *x) {
+        current.add(x);
+        if (current.n < paneRows) return;
+        full.push_back(current);
+        if ((int)full.size() > panes - 1) full.pop_front();
+        current.init(m);
+    }
+
+    CoMoments window() const {
+        CoMoments w;
+        w.init(m);
+        for (const CoMoments &p : full) w.merge(p);
+        w.merge(current);
+        return w;
+    }
+};
+
+// ---------- Parallel Streaming Reader ----------
+// Copy of streamRange / streamCSV in By-vaibhav-new/12.linear regression/multiple.cpp
+// (each program is built on its own); fix both copies together.
+const long long STREAM_PARALLEL_BYTES = 1 << 22;
+
+template <class Acc, class LineFn>
+void streamRange(const string &filename, long long begin, long long end, Acc &acc, LineFn onLine) {
+    ifstream in(filename, ios::binary);
+    bool skipFirst = begin > 0;
+    in.seekg(skipFirst ? begin - 1 : begin);
+    long long pos = skipFirst ? begin - 1 : begin;    // file offset of buf[0]
+    long long lineStart = pos;
+    vector<char> buf(1 << 20);
+    string carry;
+    while (lineStart < end) {
+        in.read(buf.data(), buf.size());
+        size_t got = in.gcount();
+        if (got == 0) {
+            if (!carry.empty() && carry.back() == '\r') carry.pop_back();
+            if (!carry.empty() && !skipFirst) onLine(acc, carry.data(), carry.data() + carry.size());
+            break;
+        }
+        size_t from = 0;
+        for (size_t i = 0; i < got && lineStart < end; i++) {
+            if (buf[i] != '\n') continue;
+            const char *b = buf.data() + from, *e = buf.data() + i;
+            if (!carry.empty()) {
+                carry.append(b, e);
+                b = carry.data();
+                e = b + carry.size();
+            }
+            if (e > b && e[-1] == '\r') e--;
+            if (skipFirst) skipFirst = false;
+            else onLine(acc, b, e);
+            carry.clear();
+            from = i + 1;
+            lineStart = pos + i + 1;
+        }
+        if (lineStart < end) carry.append(buf.data() + from, buf.data() + got);
+        pos += got;
+    }
+}
+
+template <class Acc, class LineFn>
+Acc streamCSV(const string &filename, long long dataStart, const Acc &empty, LineFn onLine) {
+    ifstream probe(filename, ios::binary | ios::ate);
+    long long size = probe.tellg();
+    long long bytes = max(0LL, size - dataStart);
+    int threads = bytes < STREAM_PARALLEL_BYTES ? 1 : max(1, (int)thread::hardware_concurrency());
+    vector<Acc> part(threads, empty);
+    vector<thread> workers;
+    for (int t = 0; t < threads; t++) {
+        auto work = [&, t] {
+            streamRange(filename, dataStart + bytes * t / threads, dataStart + bytes * (t + 1) / threads,
+                        part[t], onLine);
+        };
+        if (t + 1 < threads) workers.emplace_back(work);
+        else work();
+    }
+    for (thread &w : workers) w.join();
+    for (int t = 1; t < threads; t++) part[0].merge(part[t]);
+    return part[0];
+}
+
+// Co-moments of the rows of one byte range, plus the rows that were not
+// m numbers
+struct StreamStats {
+    CoMoments cm;
+    size_t skipped = 0;
+    vector<double> row;
+
+    void merge(const StreamStats &o) {
+        cm.merge(o.cm);
+        skipped += o.skipped;
+    }
+};
+
+// Width of the first data row (0 if there is none)
+int firstRowWidth(const string &filename) {
+    ifstream file(filename);
+    string line;
+    vector<double> row;
+    while (getline(file, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (parseRow(line.data(), line.data() + line.size(), row)) return row.size();
+    }
+    return 0;
+}
+
+// Pearson and covariance of the file in one parallel streaming pass; the
+// output is the same as for the in-memory method
+void runStreaming(const string &filename) {
+    int m = firstRowWidth(filename);
+    StreamStats empty;
+    empty.cm.init(m);
+    StreamStats st = streamCSV(filename, 0, empty, [m](StreamStats &acc, const char *b, const char *e) {
+        if (b == e) return;
+        if (!parseRow(b, e, acc.row) || (int)acc.row.size() != m) acc.skipped++;
+        else acc.cm.add(acc.row.data());
+    });
+    if (st.skipped > 0) cout << "Skipped " << st.skipped << " row(s) with a non-numeric cell or a different column count" << endl;
+    if (st.cm.n < 2) {
+        cout << "Need at least 2 rows of numeric data." << endl;
+        return;
+    }
+    for (int i = 0; i < m; i++)
+        for (int j = i + 1; j < m; j++)
+            cout << "Correlation between column " << i + 1
+                 << " and column " << j + 1 << " = " << st.cm.correlation(i, j) << '\n';
+    cout << '\n';
+    for (int i = 0; i < m; i++)
+        cout << "Variance of column " << i + 1 << " = " << st.cm.covariance(i, i) << '\n';
+    for (int i = 0; i < m; i++)
+        for (int j = i + 1; j < m; j++)
+            cout << "Covariance between column " << i + 1
+                 << " and column " << j + 1 << " = " << st.cm.covariance(i, j) << '\n';
+}
+
+// Reads the rows in order, as a live feed would arrive, and every 'every'
+// rows prints the correlations of a sliding window or of an exponentially
+// decayed history
+void runMonitor(const string &filename) {
+    long long window = 0, every = 1000;
+    double decay = 0.99;
+    cout << "Window in rows (0 for exponential decay instead): ";
+    cin >> window;
+    if (window <= 0) {
+        cout << "Decay factor per row (e.g. 0.99): ";
+        cin >> decay;
+        decay = min(max(decay, 0.0), 1.0);
+    }
+    cout << "Report every how many rows: ";
+    cin >> every;
+    every = max(1LL, every);
+    cout << '\n';
+
+    ifstream file(filename);
+    string line;
+    vector<double> row;
+    int m = 0;
+    long long rows = 0;
+    CoMoments decayed;
+    WindowedCoMoments windowed;
+    while (getline(file, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (!parseRow(line.data(), line.data() + line.size(), row)) continue;
+        if (m == 0) {
+            m = row.size();
+            decayed.init(m);
+            windowed.init(m, window);
+        }
+        if ((int)row.size() != m) continue;
+        if (window > 0) windowed.add(row.data());
+        else decayed.add(row.data(), decay);
+        if (++rows % every != 0) continue;
+
+        CoMoments cm = window > 0 ? windowed.window() : decayed;
+        cout << "After row " << rows << " (" << (window > 0 ? "window of " : "effective weight ") << cm.n
+             << (window > 0 ? " rows" : "") << "):\n";
+        for (int i = 0; i < m; i++)
+            for (int j = i + 1; j < m; j++)
+                cout << "Correlation between column " << i + 1
+                     << " and column " << j + 1 << " = " << cm.correlation(i, j) << '\n';
+    }
+}
+
 int main() {
+    // Pearson by default (also when no choice is typed)
+    int method = 1;
+    cout << "Correlation method: (1) Pearson  (2) Spearman  (3) Kendall tau-b\n"
+         << "                    (4) Pearson, streamed in one pass  (5) Live monitor (window / decay)\n"
+         << "                    (6) Strongest pairs only (threshold or top k per column): ";
+    cin >> method;
+    cout << '\n';
+    if (method == 4) {
+        runStreaming("data.csv");
+        return 0;
+    }
+    if (method == 5) {
+        runMonitor("data.csv");
+        return 0;
+    }
+
     ifstream file("data.csv");
     string line;
-    vector<vector<double>> data;
+    vector<double> data;          // n x m, row-major
+    vector<double> row;
+    size_t n = 0, skipped = 0;
+    int m = 0;
 
     // Read CSV data
     while (getline(file, line)) {
-        stringstream ss(line);
-        string val;
-        vector<double> row;
-        while (getline(ss, val, ',')) {
-            row.push_back(stod(val));
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty()) continue;
+        if (!parseRow(line.data(), line.data() + line.size(), row) || (m > 0 && (int)row.size() != m)) {
+            skipped++;
+            continue;
         }
-        if (!row.empty()) data.push_back(row);
+        if (m == 0) m = row.size();
+        data.insert(data.end(), row.begin(), row.end());
+        n++;
     }
     file.close();
 
-    int n = data.size();
-    int m = data[0].size();
-
-    // Compute correlation for each pair of columns
-    for (int i = 0; i < m; i++) {
-        for (int j = i + 1; j < m; j++) {
-            double sumx = 0, sumy = 0, sumxy = 0, sumx2 = 0, sumy2 = 0;
-
-            for (int k = 0; k < n; k++) {
-                double x = data[k][i];
-                double y = data[k][j];
-                sumx += x;
-                sumy += y;
-                sumxy += x * y;
-                sumx2 += x * x;
-                sumy2 += y * y;
-            }
+    if (skipped > 0) cout << "Skipped " << skipped << " row(s) with a non-numeric cell or a different column count" << endl;
+    if (n < 2) {
+        cout << "Need at least 2 rows of numeric data." << endl;
+        return 0;
+    }
 
-            double num = (n * sumxy) - (sumx * sumy);
-            double den = sqrt((n * sumx2 - sumx * sumx) * (n * sumy2 - sumy * sumy));
+    if (method == 6) {
+        int mode = 1;
+        cout << "(1) All pairs with |r| >= threshold  (2) Top k pairs per column: ";
+        cin >> mode;
+        vector<double> mean, ss;
+        int threads = (double)n * m * m < CORR_PARALLEL_WORK ? 1 : max(1, (int)thread::hardware_concurrency());
+        if (mode == 2) {
+            int k = 5;
+            cout << "k: ";
+            cin >> k;
+            k = max(1, k);
+            cout << '\n';
+            standardize(data, n, m, threads, mean, ss);
+            vector<vector<PairHit>> best = topPairs(data, n, m, k);
+            for (int c = 0; c < m; c++)
+                for (const PairHit &h : best[c])
+                    cout << "Correlation between column " << c + 1
+                         << " and column " << (h.i == c ? h.j : h.i) + 1 << " = " << h.r << '\n';
+            return 0;
+        }
+        double threshold = 0.9;
+        string screen = "n";
+        cout << "Threshold |r|: ";
+        cin >> threshold;
+        cout << "Screen pairs by random projection first (faster for many rows, may rarely miss a pair)? (y/n): ";
+        cin >> screen;
+        cout << '\n';
+        standardize(data, n, m, threads, mean, ss);
+        vector<PairHit> hits = thresholdPairs(data, n, m, threshold, screen == "y" || screen == "Y");
+        for (const PairHit &h : hits)
+            cout << "Correlation between column " << h.i + 1
+                 << " and column " << h.j + 1 << " = " << h.r << '\n';
+        cout << hits.size() << " pair(s) with |r| >= " << threshold << '\n';
+        return 0;
+    }
+    if (method == 3) {
+        vector<double> tau = kendallMatrix(data, n, m);
+        for (int i = 0; i < m; i++)
+            for (int j = i + 1; j < m; j++)
+                cout << "Kendall tau between column " << i + 1
+                     << " and column " << j + 1 << " = " << tau[(size_t)i * m + j] << '\n';
+        return 0;
+    }
+    if (method == 2) {
+        CorrelationResult R = spearmanMatrix(data, n, m);
+        for (int i = 0; i < m; i++)
+            for (int j = i + 1; j < m; j++)
+                cout << "Spearman correlation between column " << i + 1
+                     << " and column " << j + 1 << " = " << R.corr[(size_t)i * m + j] << '\n';
+        return 0;
+    }
 
-            double corr = (den != 0) ? num / den : 0;
+    CorrelationResult R = correlationMatrix(data, n, m);
 
+    // Correlation for each pair of columns
+    for (int i = 0; i < m; i++)
+        for (int j = i + 1; j < m; j++)
             cout << "Correlation between column " << i + 1
-                 << " and column " << j + 1 << " = " << corr << endl;
-        }
-    }
+                 << " and column " << j + 1 << " = " << R.corr[(size_t)i * m + j] << '\n';
+
+    // Covariance matrix: variances on the diagonal, then every pair
+    cout << '\n';
+    for (int i = 0; i < m; i++)
+        cout << "Variance of column " << i + 1 << " = " << R.cov[(size_t)i * m + i] << '\n';
+    for (int i = 0; i < m; i++)
+        for (int j = i + 1; j < m; j++)
+            cout << "Covariance between column " << i + 1
+                 << " and column " << j + 1 << " = " << R.cov[(size_t)i * m + j] << '\n';
 
     return 0;
 }
@@ -6,17 +6,32 @@
 #include <cmath>
 #include <iomanip>
 #include <set>
+#include <unordered_map>
+#include <algorithm>
+#include <numeric>
+#include <cstdint>
+#include <limits>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <functional>
+#include <chrono>
+#include <cstdlib>
+#include <random>
 using namespace std;
 
 // ---------- Utility: Calculate Gini Impurity ----------
-double gini(const map<string, double> &classCounts) {
+// counts[] is one dense row of class counts (one slot per class code).
+double gini(const double *counts, int numClasses) {
     double total = 0.0;
-    for (auto &p : classCounts) total += p.second;
+    for (int c = 0; c < numClasses; c++) total += counts[c];
     if (total == 0) return 0.0;
 
     double g = 1.0;
-    for (auto &p : classCounts) {
-        double ratio = p.second / total;
+    for (int c = 0; c < numClasses; c++) {
+        double ratio = counts[c] / total;
         g -= ratio * ratio;
     }
     return g;
@@ -42,131 +57,584 @@ vector<vector<string>> readCSV(const string &filename) {
     return data;
 }
 
+// ---------- Numeric Column Detection ----------
+// Finite numbers only: "nan"/"inf" would break the sorted threshold search
+bool isNumber(const string &s) {
+    if (s.empty()) return false;
+    char *end = nullptr;
+    double v = strtod(s.c_str(), &end);
+    return *end == '\0' && isfinite(v);
+}
+
+// A column is numeric when every value in it parses as a number
+vector<char> detectNumeric(const vector<vector<string>> &data) {
+    int cols = data[0].size();
+    vector<char> numeric(cols, 0);
+    for (int col = 0; col + 1 < cols; col++) {
+        bool ok = data.size() > 1;
+        for (size_t r = 1; r < data.size() && ok; r++)
+            ok = col < (int)data[r].size() && isNumber(data[r][col]);
+        numeric[col] = ok;
+    }
+    return numeric;
+}
+
+// ---------- Dictionary-Encoded Dataset ----------
+// Every column (attributes and the class column) is encoded once into small
+// integer codes. Codes follow sorted value order, so looping over codes visits
+// values in the same order the old map<string, ...> tables did.
+//
+// Numeric columns get ordinal codes instead: code c covers the values in
+// (cuts[c - 1], cuts[c]], so "x <= cuts[c]" is a binary split between codes.
+//   NUMERIC_EXACT : one code per distinct value (the column is presorted once)
+//   NUMERIC_HIST  : at most 256 quantile bins (LightGBM-style histogram)
+enum NumericMode { NUMERIC_EXACT = 1, NUMERIC_HIST = 2 };
+const int HIST_BINS = 256;
+
+struct EncodedData {
+    vector<string> headers;
+    vector<vector<string>> dict;   // dict[col][code] -> original value (categorical)
+    vector<vector<double>> cuts;   // cuts[col][code]  -> upper bound of code (numeric)
+    vector<char> isNumeric;
+    vector<vector<int>> codes;     // codes[col][row] (column-major)
+    int numRows = 0;
+    int classCol = 0;              // last column = target
+    int numClasses = 0;
+};
+
+int numCodes(const EncodedData &ed, int col) {
+    return ed.isNumeric[col] ? ed.cuts[col].size() : ed.dict[col].size();
+}
+
+void encodeNumericColumn(const vector<vector<string>> &data, int col, int mode, EncodedData &ed) {
+    vector<double> vals(ed.numRows);
+    for (int r = 0; r < ed.numRows; r++) vals[r] = strtod(data[r + 1][col].c_str(), nullptr);
+
+    vector<double> sorted = vals;
+    sort(sorted.begin(), sorted.end());
+    vector<double> &cuts = ed.cuts[col];
+    if (mode == NUMERIC_HIST) {
+        // Quantile bin edges; duplicates collapse so heavy values get one bin
+        for (int b = 1; b <= HIST_BINS; b++) {
+            double edge = sorted[min((long long)ed.numRows - 1, (long long)b * ed.numRows / HIST_BINS)];
+            if (b == HIST_BINS) edge = sorted.back();
+            if (cuts.empty() || edge > cuts.back()) cuts.push_back(edge);
+        }
+    } else {
+        cuts = sorted;
+        cuts.erase(unique(cuts.begin(), cuts.end()), cuts.end());
+    }
+    for (int r = 0; r < ed.numRows; r++)
+        ed.codes[col][r] = lower_bound(cuts.begin(), cuts.end(), vals[r]) - cuts.begin();
+}
+
+EncodedData encodeData(const vector<vector<string>> &data, const vector<char> &numeric, int mode) {
+    EncodedData ed;
+    ed.headers = data[0];
+    int cols = ed.headers.size();
+    ed.numRows = data.size() - 1;
+    ed.classCol = cols - 1;
+    ed.dict.resize(cols);
+    ed.cuts.resize(cols);
+    ed.isNumeric = numeric;
+    ed.codes.assign(cols, vector<int>(ed.numRows));
+
+    for (int col = 0; col < cols; col++) {
+        if (numeric[col]) {
+            encodeNumericColumn(data, col, mode, ed);
+            continue;
+        }
+        // Class is always the last cell of a row (as in the original code)
+        auto cell = [&](int r) -> const string & {
+            const vector<string> &row = data[r + 1];
+            static const string missing;
+            if (col == ed.classCol) return row.empty() ? missing : row.back();
+            return col < (int)row.size() ? row[col] : missing;
+        };
+        // First pass: codes in order of first appearance
+        unordered_map<string, int> index;
+        vector<int> &codes = ed.codes[col];
+        for (int r = 0; r < ed.numRows; r++) {
+            auto it = index.emplace(cell(r), (int)index.size()).first;
+            codes[r] = it->second;
+        }
+        // Re-number codes so they follow sorted value order
+        vector<string> &values = ed.dict[col];
+        values.resize(index.size());
+        for (auto &kv : index) values[kv.second] = kv.first;
+        vector<int> order(values.size()), remap(values.size());
+        iota(order.begin(), order.end(), 0);
+        sort(order.begin(), order.end(), [&](int a, int b) { return values[a] < values[b]; });
+        vector<string> sorted(values.size());
+        for (int i = 0; i < (int)order.size(); i++) {
+            remap[order[i]] = i;
+            sorted[i] = values[order[i]];
+        }
+        values.swap(sorted);
+        for (int &c : codes) c = remap[c];
+    }
+    ed.numClasses = ed.dict[ed.classCol].size();
+    return ed;
+}
+
+// ---------- Split Finder: dense value x class counts ----------
+// counts[v * numClasses + c] = number of rows with value v and class c.
+void countValueClass(const EncodedData &ed, int col, const int *rows, int n, vector<double> &counts) {
+    int K = ed.numClasses;
+    counts.assign(numCodes(ed, col) * K, 0.0);
+    const int *attr = ed.codes[col].data();
+    const int *cls = ed.codes[ed.classCol].data();
+    for (int i = 0; i < n; i++) counts[attr[rows[i]] * K + cls[rows[i]]] += 1.0;
+}
+
+// ---------- Split Finder: binary threshold on a numeric column ----------
+// Returns the code c of the best "x <= cuts[c]" split, or -1 if the column is
+// constant in this node. bestWeighted receives the weighted impurity of that
+// split and leftCounts the class counts of its left side.
+int findNumericSplit(const EncodedData &ed, int col, const int *rows, int n, const vector<double> &classCounts,
+                     vector<double> &leftCounts, double &bestWeighted) {
+    int K = ed.numClasses;
+    int D = ed.cuts[col].size();
+    const int *code = ed.codes[col].data();
+    const int *cls = ed.codes[ed.classCol].data();
+
+    vector<double> left(K, 0.0), right = classCounts;
+    double nLeft = 0;
+    int bestCode = -1;
+    bestWeighted = 0.0;
+
+    auto consider = [&](int c) {
+        double nRight = n - nLeft;
+        if (nLeft == 0 || nRight == 0) return;
+        double w = (nLeft / n) * gini(left.data(), K) + (nRight / n) * gini(right.data(), K);
+        if (bestCode < 0 || w < bestWeighted) {
+            bestWeighted = w;
+            bestCode = c;
+            leftCounts = left;
+        }
+    };
+
+    if ((double)n * log2(n + 1.0) < D) {
+        // Few rows, many distinct codes: sort only this node's rows by code
+        vector<pair<int, int>> pts(n);
+        for (int i = 0; i < n; i++) pts[i] = make_pair(code[rows[i]], cls[rows[i]]);
+        sort(pts.begin(), pts.end());
+        for (int i = 0; i < n; i++) {
+            left[pts[i].second]++;
+            right[pts[i].second]--;
+            nLeft++;
+            if (i + 1 < n && pts[i + 1].first == pts[i].first) continue;
+            consider(pts[i].first);
+        }
+    } else {
+        // Sweep the presorted codes with running class counts
+        vector<double> hist(D * K, 0.0);
+        for (int i = 0; i < n; i++) hist[code[rows[i]] * K + cls[rows[i]]] += 1.0;
+        for (int c = 0; c < D; c++) {
+            const double *h = &hist[c * K];
+            double m = 0;
+            for (int k = 0; k < K; k++) {
+                left[k] += h[k];
+                right[k] -= h[k];
+                m += h[k];
+            }
+            if (m == 0) continue;
+            nLeft += m;
+            consider(c);
+        }
+    }
+    return bestCode;
+}
+
+// ---------- In-Place Row Partitioning ----------
+// Groups idx[begin, end) by the row's code in column `col` by swapping
+// entries inside the range (American-flag sort, no second buffer).
+// Returns start offsets: group v occupies [start[v], start[v + 1]).
+vector<int> partitionRows(const EncodedData &ed, int col, vector<int> &idx, int begin, int end) {
+    int V = numCodes(ed, col);
+    const int *code = ed.codes[col].data();
+
+    vector<int> start(V + 1, 0);
+    for (int i = begin; i < end; i++) start[code[idx[i]] + 1]++;
+    start[0] = begin;
+    for (int v = 0; v < V; v++) start[v + 1] += start[v];
+
+    vector<int> next(start.begin(), start.end() - 1);
+    for (int v = 0; v < V; v++) {
+        while (next[v] < start[v + 1]) {
+            int r = idx[next[v]];
+            int c = code[r];
+            if (c == v) {
+                next[v]++;
+            } else {
+                idx[next[v]] = idx[next[c]];
+                idx[next[c]++] = r;
+            }
+        }
+    }
+    return start;
+}
+
+// ---------- Used-Attribute Bitmask ----------
+typedef vector<uint64_t> AttrMask;
+
+bool isUsed(const AttrMask &mask, int col) { return (mask[col >> 6] >> (col & 63)) & 1; }
+void markUsed(AttrMask &mask, int col) { mask[col >> 6] |= uint64_t(1) << (col & 63); }
+
+// ---------- Work-Stealing Task Pool ----------
+// Every thread owns a deque of tasks. A thread pushes and pops its own tasks
+// at the back (newest first, depth-first like the serial recursion), and an
+// idle thread steals from the front of another deque (the oldest task, which
+// is usually the biggest subtree). wait() keeps running tasks instead of
+// blocking, so a parent waiting for its children never idles a thread.
+class TaskPool {
+public:
+    struct Group { atomic<int> pending{0}; };
+
+    explicit TaskPool(int threads) {
+        threads = max(1, threads);
+        for (int i = 0; i < threads; i++) queues.emplace_back(new Queue());
+        for (int i = 1; i < threads; i++)
+            workers.emplace_back([this, i] {
+                self = i;
+                int misses = 0;
+                while (!stopping) {
+                    if (tryRunOne()) misses = 0;
+                    else if (++misses < 64) this_thread::yield();
+                    else this_thread::sleep_for(chrono::microseconds(100));
+                }
+            });
+    }
+
+    ~TaskPool() {
+        stopping = true;
+        for (auto &t : workers) t.join();
+    }
+
+    int size() const { return queues.size(); }
+
+    void spawn(Group &g, function<void()> fn) {
+        g.pending++;
+        Queue &q = *queues[self];
+        lock_guard<mutex> lock(q.m);
+        q.tasks.push_back(Task{&g, move(fn)});
+    }
+
+    void wait(Group &g) {
+        while (g.pending > 0)
+            if (!tryRunOne()) this_thread::yield();
+    }
+
+private:
+    struct Task { Group *group; function<void()> fn; };
+    struct Queue { mutex m; deque<Task> tasks; };
+
+    vector<unique_ptr<Queue>> queues;
+    vector<thread> workers;
+    atomic<bool> stopping{false};
+    static thread_local int self;   // index of the calling thread's own deque (0 = main)
+
+    bool tryRunOne() {
+        Task task;
+        bool found = false;
+        {
+            Queue &q = *queues[self];
+            lock_guard<mutex> lock(q.m);
+            if (!q.tasks.empty()) {
+                task = move(q.tasks.back());
+                q.tasks.pop_back();
+                found = true;
+            }
+        }
+        for (int k = 1; !found && k < (int)queues.size(); k++) {
+            Queue &q = *queues[(self + k) % queues.size()];
+            lock_guard<mutex> lock(q.m);
+            if (!q.tasks.empty()) {
+                task = move(q.tasks.front());
+                q.tasks.pop_front();
+                found = true;
+            }
+        }
+        if (!found) return false;
+        task.fn();
+        task.group->pending--;
+        return true;
+    }
+};
+
+thread_local int TaskPool::self = 0;
+
+// Nodes with at least this many rows score their attributes in parallel;
+// below it, subtrees of at least SUBTREE_TASK_ROWS rows become pool tasks
+// and anything smaller is built inline by the thread that reached it.
+const int ATTR_PARALLEL_ROWS = 100000;
+const int SUBTREE_TASK_ROWS = 2000;
+
 // ---------- Decision Tree Node ----------
 struct Node {
     string attribute;
     map<string, Node*> children;
     string label;  // class label for leaf
+    bool numeric = false;   // numeric split: children "<=" and ">" threshold
+    double threshold = 0.0;
+    string trace;           // build log for this node (printed by printBuildLog)
 };
 
+// ---------- Build Options ----------
+// maxFeatures > 0 makes every split consider only that many attributes,
+// drawn at random per node (random forest); trace = false skips the log.
+struct BuildOptions {
+    int maxFeatures = 0;
+    uint64_t seed = 0;
+    bool trace = true;
+};
+
+uint64_t mixSeed(uint64_t x) {
+    // splitmix64 finaliser
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
 // ---------- Recursive Gini Tree Builder ----------
-Node* buildTree(vector<vector<string>> data, vector<string> headers, string indent = "") {
+// The records reaching this node are idx[begin, end). idx is one shared
+// row-index array that every level partitions in place; the dataset itself
+// is never copied. `used` marks attributes already split on along this path.
+// The step-by-step log is written to node->trace (see printBuildLog), so the
+// tree and its log are identical whether subtrees are built serially or not.
+Node* buildTree(const EncodedData &ed, vector<int> &idx, int begin, int end, const AttrMask &used,
+                TaskPool &pool, const BuildOptions &opt, string indent = "") {
+    int K = ed.numClasses;
+    const vector<string> &classNames = ed.dict[ed.classCol];
+    const int *rows = idx.data() + begin;
+    int n = end - begin;
+
+    ostringstream out;
+    out.copyfmt(cout);
+    if (!opt.trace) out.setstate(ios_base::badbit);   // every << becomes a no-op
+
     // Step 1: Count target classes
-    map<string, double> classCounts;
-    for (int i = 1; i < data.size(); i++)
-        classCounts[data[i].back()]++;
+    vector<double> classCounts(K, 0.0);
+    for (int i = 0; i < n; i++) classCounts[ed.codes[ed.classCol][rows[i]]]++;
 
-    double currentGini = gini(classCounts);
+    double currentGini = gini(classCounts.data(), K);
 
-    cout << "\n" << indent << "---------------------------------------------\n";
-    cout << indent << "Current Subset (" << data.size() - 1 << " records)\n";
-    cout << indent << "Class Distribution: ";
-    for (auto &p : classCounts) cout << p.first << "=" << p.second << " ";
-    cout << "\n" << indent << "Parent Gini = " << currentGini << endl;
+    out << "\n" << indent << "---------------------------------------------\n";
+    out << indent << "Current Subset (" << n << " records)\n";
+    out << indent << "Class Distribution: ";
+    for (int c = 0; c < K; c++)
+        if (classCounts[c] > 0) out << classNames[c] << "=" << classCounts[c] << " ";
+    out << "\n" << indent << "Parent Gini = " << currentGini << endl;
 
     // Step 2: Pure node (Gini = 0)
     if (currentGini == 0.0) {
         Node* leaf = new Node();
-        leaf->label = data[1].back();
-        cout << indent << "--> Leaf Node created with label: " << leaf->label << endl;
+        leaf->label = classNames[ed.codes[ed.classCol][rows[0]]];
+        out << indent << "--> Leaf Node created with label: " << leaf->label << endl;
+        leaf->trace = out.str();
         return leaf;
     }
 
-    // Step 3: If only one attribute left
-    if (headers.size() <= 1) {
+    // Step 3: If no attributes left
+    vector<int> candidates;
+    for (int col = 0; col < ed.classCol; col++)
+        if (!isUsed(used, col)) candidates.push_back(col);
+    auto majorityLeaf = [&](const string &reason) {
         string majorityClass;
         double maxCount = -1;
-        for (auto &c : classCounts)
-            if (c.second > maxCount)
-                majorityClass = c.first, maxCount = c.second;
+        for (int c = 0; c < K; c++)
+            if (classCounts[c] > 0 && classCounts[c] > maxCount)
+                majorityClass = classNames[c], maxCount = classCounts[c];
         Node* leaf = new Node();
         leaf->label = majorityClass;
-        cout << indent << "--> Leaf (no attributes left): " << majorityClass << endl;
+        out << indent << "--> Leaf (" << reason << "): " << majorityClass << endl;
+        leaf->trace = out.str();
         return leaf;
+    };
+    if (candidates.empty()) return majorityLeaf("no attributes left");
+
+    // Random forest: keep a random subset of the candidates. The generator is
+    // seeded from the node's position, so the draw never depends on which
+    // thread builds the node.
+    if (opt.maxFeatures > 0 && (int)candidates.size() > opt.maxFeatures) {
+        mt19937_64 rng(mixSeed(opt.seed ^ mixSeed(((uint64_t)begin << 32 | (uint32_t)end) ^ indent.size())));
+        for (int i = 0; i < opt.maxFeatures; i++)
+            swap(candidates[i], candidates[i + rng() % (candidates.size() - i)]);
+        candidates.resize(opt.maxFeatures);
+        sort(candidates.begin(), candidates.end());
     }
 
     // Step 4: Compute weighted Gini for each attribute
-    int totalRecords = data.size() - 1;
-    double bestWeightedGini = 999.0;
-    string bestAttr;
-    int bestCol = -1;
+    int totalRecords = n;
+
+    // Scores one attribute and writes its log lines. Returns the weighted
+    // Gini, or +infinity when the attribute cannot be chosen; threshold codes of
+    // numeric attributes are returned through `code`.
+    auto evalAttr = [&](int col, ostream &log, int &code) -> double {
+        string attr = ed.headers[col];
+
+        if (ed.isNumeric[col]) {
+            vector<double> left;
+            double weightedGini;
+            code = findNumericSplit(ed, col, rows, n, classCounts, left, weightedGini);
+
+            log << "\n" << indent << "Attribute: " << attr << " (numeric)" << endl;
+            if (code < 0) {
+                log << indent << "  constant in this subset, no threshold" << endl;
+                return numeric_limits<double>::infinity();
+            }
+            vector<double> right(K);
+            for (int c = 0; c < K; c++) right[c] = classCounts[c] - left[c];
+            double threshold = ed.cuts[col][code];
+            const char *ops[2] = {" <= ", " > "};
+            const vector<double> *sides[2] = {&left, &right};
+            for (int s = 0; s < 2; s++) {
+                log << indent << "  " << attr << ops[s] << threshold << " -> ";
+                for (int c = 0; c < K; c++)
+                    if ((*sides[s])[c] > 0) log << classNames[c] << "=" << (*sides[s])[c] << " ";
+                log << "| Gini=" << gini(sides[s]->data(), K) << endl;
+            }
+
+            log << indent << "  Weighted Gini(" << attr << ") = " << weightedGini << endl;
 
-    for (int col = 0; col < headers.size() - 1; col++) {
-        string attr = headers[col];
-        map<string, map<string, double>> valueClassCount;
+            // A numeric split must actually improve purity, since the column stays usable below
+            return weightedGini < currentGini - 1e-12 ? weightedGini : numeric_limits<double>::infinity();
+        }
+        const vector<string> &values = ed.dict[col];
 
         // Count occurrences of target classes for each value
-        for (int i = 1; i < data.size(); i++)
-            valueClassCount[data[i][col]][data[i].back()]++;
+        vector<double> valueClassCount;
+        countValueClass(ed, col, rows, n, valueClassCount);
 
         double weightedGini = 0.0;
 
-        cout << "\n" << indent << "Attribute: " << attr << endl;
-        for (auto &kv : valueClassCount) {
+        log << "\n" << indent << "Attribute: " << attr << endl;
+        for (int v = 0; v < (int)values.size(); v++) {
+            const double *cnt = &valueClassCount[v * K];
             double subsetTotal = 0.0;
-            for (auto &cls : kv.second) subsetTotal += cls.second;
-            double g = gini(kv.second);
+            for (int c = 0; c < K; c++) subsetTotal += cnt[c];
+            if (subsetTotal == 0) continue;
+            double g = gini(cnt, K);
             weightedGini += (subsetTotal / totalRecords) * g;
 
-            cout << indent << "  " << attr << "=" << kv.first << " -> ";
-            for (auto &cls : kv.second)
-                cout << cls.first << "=" << cls.second << " ";
-            cout << "| Gini=" << g << endl;
+            log << indent << "  " << attr << "=" << values[v] << " -> ";
+            for (int c = 0; c < K; c++)
+                if (cnt[c] > 0) log << classNames[c] << "=" << cnt[c] << " ";
+            log << "| Gini=" << g << endl;
         }
 
-        cout << indent << "  Weighted Gini(" << attr << ") = " << weightedGini << endl;
+        log << indent << "  Weighted Gini(" << attr << ") = " << weightedGini << endl;
+        return weightedGini;
+    };
+
+    int m = candidates.size();
+    vector<double> scores(m);
+    vector<int> codes(m, -1);
+    vector<string> logs(m);
+    auto evalOne = [&](int i) {
+        ostringstream log;
+        log.copyfmt(out);
+        log.setstate(out.rdstate());
+        scores[i] = evalAttr(candidates[i], log, codes[i]);
+        logs[i] = log.str();
+    };
+    if (n >= ATTR_PARALLEL_ROWS && m > 1 && pool.size() > 1) {
+        TaskPool::Group scoring;
+        for (int i = 0; i < m; i++) pool.spawn(scoring, [&evalOne, i] { evalOne(i); });
+        pool.wait(scoring);
+    } else {
+        for (int i = 0; i < m; i++) evalOne(i);
+    }
 
-        if (weightedGini < bestWeightedGini) {
-            bestWeightedGini = weightedGini;
-            bestAttr = attr;
-            bestCol = col;
+    // Pick the winner in attribute order, exactly like the serial loop
+    double bestWeightedGini = 999.0;
+    string bestAttr;
+    int bestCol = -1;
+    int bestCode = -1;   // threshold code when the best attribute is numeric
+    for (int i = 0; i < m; i++) {
+        out << logs[i];
+        if (scores[i] < bestWeightedGini) {
+            bestWeightedGini = scores[i];
+            bestCol = candidates[i];
+            bestAttr = ed.headers[bestCol];
+            bestCode = codes[i];
         }
     }
 
-    cout << indent << "---------------------------------------------\n";
-    cout << indent << "Best Attribute Chosen: " << bestAttr << " (Lowest Weighted Gini = " << bestWeightedGini << ")\n";
+    if (bestCol < 0) return majorityLeaf("no useful split");
+
+    out << indent << "---------------------------------------------\n";
+    out << indent << "Best Attribute Chosen: " << bestAttr << " (Lowest Weighted Gini = " << bestWeightedGini << ")\n";
 
-    // Step 5: Split dataset by best attribute
+    // Step 5: Partition this node's rows in place by best attribute
     Node* node = new Node();
     node->attribute = bestAttr;
+    node->trace = out.str();
 
-    map<string, vector<vector<string>>> subsets;
-    for (int i = 1; i < data.size(); i++) {
-        string val = data[i][bestCol];
-        subsets[val].push_back(data[i]);
-    }
+    // Children work on disjoint slices of idx, so they can be built concurrently
+    TaskPool::Group children;
+    auto buildChild = [&](Node *&slot, int b, int e, const AttrMask &mask) {
+        if (e - b >= SUBTREE_TASK_ROWS && pool.size() > 1)
+            pool.spawn(children, [&ed, &idx, &pool, &opt, &slot, &mask, b, e, indent] {
+                slot = buildTree(ed, idx, b, e, mask, pool, opt, indent + "   ");
+            });
+        else
+            slot = buildTree(ed, idx, b, e, mask, pool, opt, indent + "   ");
+    };
 
-    // Prepare reduced headers
-    vector<string> newHeaders;
-    for (int i = 0; i < headers.size(); i++)
-        if (i != bestCol) newHeaders.push_back(headers[i]);
+    AttrMask childUsed = used;
+    if (ed.isNumeric[bestCol]) {
+        // Binary split; the numeric column stays available further down
+        node->numeric = true;
+        node->threshold = ed.cuts[bestCol][bestCode];
+        const int *code = ed.codes[bestCol].data();
+        int mid = partition(idx.begin() + begin, idx.begin() + end,
+                            [&](int r) { return code[r] <= bestCode; }) - idx.begin();
 
-    // Recursive step
-    for (auto &sub : subsets) {
-        cout << "\n" << indent << "|-- Splitting on " << bestAttr << " = " << sub.first << endl;
+        buildChild(node->children["<="], begin, mid, used);
+        buildChild(node->children[">"], mid, end, used);
+    } else {
+        const vector<string> &bestValues = ed.dict[bestCol];
+        vector<int> start = partitionRows(ed, bestCol, idx, begin, end);
+        markUsed(childUsed, bestCol);
 
-        vector<vector<string>> newData;
-        newData.push_back(newHeaders);
-        for (auto &row : sub.second) {
-            vector<string> newRow;
-            for (int i = 0; i < row.size(); i++)
-                if (i != bestCol) newRow.push_back(row[i]);
-            newData.push_back(newRow);
+        // Recursive step
+        for (int v = 0; v < (int)bestValues.size(); v++) {
+            if (start[v] == start[v + 1]) continue;
+            buildChild(node->children[bestValues[v]], start[v], start[v + 1], childUsed);
         }
-
-        node->children[sub.first] = buildTree(newData, newHeaders, indent + "   ");
     }
+    pool.wait(children);
 
     return node;
 }
 
+// ---------- Build Log Printing ----------
+// Prints every node's log in depth-first order, with the same "Splitting on"
+// lines between parent and child that the serial recursion used to print.
+void printBuildLog(Node* node, string indent = "") {
+    cout << node->trace;
+    for (auto &child : node->children) {
+        cout << "\n" << indent << "|-- Splitting on " << node->attribute;
+        if (node->numeric)
+            cout << " " << child.first << " " << node->threshold << endl;
+        else
+            cout << " = " << child.first << endl;
+        printBuildLog(child.second, indent + "   ");
+    }
+}
+
 // ---------- Tree Printing ----------
 void printTree(Node* node, string indent = "") {
     if (!node) return;
     if (!node->attribute.empty()) {
         cout << indent << "Attribute: " << node->attribute << endl;
         for (auto &child : node->children) {
-            cout << indent << "|-- " << node->attribute << " = " << child.first << endl;
+            if (node->numeric)
+                cout << indent << "|-- " << node->attribute << " " << child.first << " " << node->threshold << endl;
+            else
+                cout << indent << "|-- " << node->attribute << " = " << child.first << endl;
             printTree(child.second, indent + "   ");
         }
     } else {
@@ -174,21 +642,289 @@ void printTree(Node* node, string indent = "") {
     }
 }
 
+// ---------- Compiled (Flat) Tree ----------
+// For prediction the pointer tree is flattened into one contiguous array.
+// Nodes test integer feature ids instead of attribute names: a categorical
+// node finds the child for value code v at childIndex[firstChild + v]
+// (-1 when that value never reached the node during training), and a
+// numeric node has its "<=" child at firstChild and its ">" child next to it.
+struct FlatNode {
+    int feature;        // column tested here, -1 for a leaf
+    int label;          // class code of a leaf
+    int firstChild;     // offset into FlatTree::childIndex
+    bool numeric;
+    double threshold;
+};
+
+struct FlatTree {
+    vector<FlatNode> nodes;     // nodes[0] is the root
+    vector<int> childIndex;
+};
+
+int compileNode(Node* node, const EncodedData &ed, FlatTree &tree) {
+    int id = tree.nodes.size();
+    tree.nodes.push_back(FlatNode{-1, -1, -1, false, 0.0});
+    if (node->attribute.empty()) {
+        const vector<string> &classes = ed.dict[ed.classCol];
+        tree.nodes[id].label = lower_bound(classes.begin(), classes.end(), node->label) - classes.begin();
+        return id;
+    }
+
+    int col = find(ed.headers.begin(), ed.headers.end(), node->attribute) - ed.headers.begin();
+    int slots = node->numeric ? 2 : ed.dict[col].size();
+    int first = tree.childIndex.size();
+    tree.childIndex.resize(first + slots, -1);
+    tree.nodes[id].feature = col;
+    tree.nodes[id].firstChild = first;
+    tree.nodes[id].numeric = node->numeric;
+    tree.nodes[id].threshold = node->threshold;
+
+    for (auto &child : node->children) {
+        int slot;
+        if (node->numeric) {
+            slot = child.first == "<=" ? 0 : 1;
+        } else {
+            const vector<string> &values = ed.dict[col];
+            slot = lower_bound(values.begin(), values.end(), child.first) - values.begin();
+        }
+        int childId = compileNode(child.second, ed, tree);
+        tree.childIndex[first + slot] = childId;
+    }
+    return id;
+}
+
+FlatTree compileTree(Node* root, const EncodedData &ed) {
+    FlatTree tree;
+    compileNode(root, ed, tree);
+    return tree;
+}
+
+// ---------- Model File ----------
+// Saves the compiled forest (a single tree is a forest of one) together with
+// what is needed to encode new records, so a model server can load it
+// without retraining. Layout (native-endian):
+//   "DTM1", headers, per attribute a numeric flag plus (categorical) its
+//   sorted values, class labels, then every tree's nodes and child index.
+const char DT_MAGIC[4] = {'D', 'T', 'M', '1'};
+
+template <class T> void writePod(ostream &out, const T &x) { out.write((const char *)&x, sizeof(T)); }
+
+void writeString(ostream &out, const string &s) {
+    writePod(out, (uint32_t)s.size());
+    out.write(s.data(), s.size());
+}
+
+bool saveForest(const EncodedData &ed, const vector<FlatTree> &forest, const string &filename) {
+    ofstream out(filename, ios::binary);
+    if (!out.is_open()) return false;
+    out.write(DT_MAGIC, 4);
+    writePod(out, (uint32_t)ed.headers.size());
+    for (auto &h : ed.headers) writeString(out, h);
+    for (int col = 0; col < ed.classCol; col++) {
+        writePod(out, (uint8_t)ed.isNumeric[col]);
+        if (ed.isNumeric[col]) continue;
+        writePod(out, (uint32_t)ed.dict[col].size());
+        for (auto &v : ed.dict[col]) writeString(out, v);
+    }
+    writePod(out, (uint32_t)ed.numClasses);
+    for (auto &c : ed.dict[ed.classCol]) writeString(out, c);
+
+    writePod(out, (uint32_t)forest.size());
+    for (const FlatTree &tree : forest) {
+        writePod(out, (uint32_t)tree.nodes.size());
+        for (const FlatNode &nd : tree.nodes) {
+            writePod(out, (int32_t)nd.feature);
+            writePod(out, (int32_t)nd.label);
+            writePod(out, (int32_t)nd.firstChild);
+            writePod(out, (uint8_t)nd.numeric);
+            writePod(out, nd.threshold);
+        }
+        writePod(out, (uint32_t)tree.childIndex.size());
+        for (int c : tree.childIndex) writePod(out, (int32_t)c);
+    }
+    return (bool)out;
+}
+
+// ---------- Columnar Test Batch ----------
+// Test records are encoded column by column with the training dictionaries:
+// categorical cells become value codes (-1 if unseen in training) and numeric
+// cells become doubles (NaN if not a number).
+struct ColumnBatch {
+    int numRows = 0;
+    vector<vector<int>> codes;       // codes[col][row] for categorical columns
+    vector<vector<double>> values;   // values[col][row] for numeric columns
+};
+
+ColumnBatch encodeBatch(const vector<vector<string>> &records, const EncodedData &ed) {
+    ColumnBatch batch;
+    batch.numRows = records.size();
+    batch.codes.resize(ed.classCol);
+    batch.values.resize(ed.classCol);
+    for (int col = 0; col < ed.classCol; col++) {
+        if (ed.isNumeric[col]) {
+            vector<double> &v = batch.values[col];
+            v.resize(batch.numRows);
+            for (int r = 0; r < batch.numRows; r++) {
+                const vector<string> &rec = records[r];
+                v[r] = col < (int)rec.size() && isNumber(rec[col]) ? strtod(rec[col].c_str(), nullptr) : NAN;
+            }
+        } else {
+            unordered_map<string, int> lookup;
+            for (int c = 0; c < (int)ed.dict[col].size(); c++) lookup[ed.dict[col][c]] = c;
+            vector<int> &v = batch.codes[col];
+            v.resize(batch.numRows);
+            for (int r = 0; r < batch.numRows; r++) {
+                const vector<string> &rec = records[r];
+                auto it = col < (int)rec.size() ? lookup.find(rec[col]) : lookup.end();
+                v[r] = it == lookup.end() ? -1 : it->second;
+            }
+        }
+    }
+    return batch;
+}
+
 // ---------- Prediction ----------
-string predict(Node* root, const vector<string> &headers, const vector<string> &record) {
-    if (root->attribute.empty()) return root->label;
+// Walks one flat tree for one record. catCode(col) gives the record's value
+// code of a categorical column and numValue(col) its numeric value. Returns
+// the class code, or -1 ("Unknown") when the record reaches a branch that
+// did not exist in the training data.
+template <class CatCode, class NumValue>
+int walkTree(const FlatTree &tree, CatCode catCode, NumValue numValue) {
+    int id = 0;
+    while (true) {
+        const FlatNode &nd = tree.nodes[id];
+        if (nd.feature < 0) return nd.label;
+        int slot;
+        if (nd.numeric) {
+            double x = numValue(nd.feature);
+            if (std::isnan(x)) return -1;
+            slot = x <= nd.threshold ? 0 : 1;
+        } else {
+            slot = catCode(nd.feature);
+            if (slot < 0) return -1;
+        }
+        id = tree.childIndex[nd.firstChild + slot];
+        if (id < 0) return -1;
+    }
+}
+
+int predictRow(const FlatTree &tree, const ColumnBatch &batch, int r) {
+    return walkTree(tree, [&](int col) { return batch.codes[col][r]; },
+                    [&](int col) { return batch.values[col][r]; });
+}
 
-    string attr = root->attribute;
-    int idx = -1;
-    for (int i = 0; i < headers.size(); i++)
-        if (headers[i] == attr) idx = i;
+// Majority vote over per-class counts; ties go to the lower class code and
+// -1 means every tree answered "Unknown".
+int majorityVote(const int *votes, int numClasses) {
+    int best = -1;
+    for (int c = 0; c < numClasses; c++)
+        if (votes[c] > 0 && (best < 0 || votes[c] > votes[best])) best = c;
+    return best;
+}
 
-    if (idx == -1) return "Unknown";
+// Scores every row of the batch with every tree (a single tree is just a
+// forest of one); blocks of rows are spread over the pool.
+const int PREDICT_BLOCK_ROWS = 16384;
 
-    string val = record[idx];
-    if (root->children.find(val) == root->children.end())
-        return "Unknown";
-    return predict(root->children[val], headers, record);
+void predictMany(const vector<FlatTree> &forest, int numClasses, const ColumnBatch &batch, vector<int> &out,
+                 TaskPool &pool) {
+    out.resize(batch.numRows);
+    TaskPool::Group blocks;
+    for (int b = 0; b < batch.numRows; b += PREDICT_BLOCK_ROWS) {
+        int e = min(batch.numRows, b + PREDICT_BLOCK_ROWS);
+        pool.spawn(blocks, [&forest, numClasses, &batch, &out, b, e] {
+            vector<int> votes(numClasses);
+            for (int r = b; r < e; r++) {
+                fill(votes.begin(), votes.end(), 0);
+                for (const FlatTree &tree : forest) {
+                    int c = predictRow(tree, batch, r);
+                    if (c >= 0) votes[c]++;
+                }
+                out[r] = majorityVote(votes.data(), numClasses);
+            }
+        });
+    }
+    pool.wait(blocks);
+}
+
+string classLabel(const EncodedData &ed, int code) {
+    return code < 0 ? "Unknown" : ed.dict[ed.classCol][code];
+}
+
+// ---------- Random Forest ----------
+// Every tree is grown on a bootstrap sample of row indices over the one
+// shared EncodedData, so a tree only costs its index array while it is
+// being built and its flat nodes afterwards. The sample is a pure function
+// of the tree's seed and is regenerated for the out-of-bag error instead of
+// keeping an in-bag set per tree.
+vector<int> bootstrapSample(int numRows, uint64_t seed) {
+    mt19937_64 rng(seed);
+    uniform_int_distribution<int> pick(0, numRows - 1);
+    vector<int> idx(numRows);
+    for (int &r : idx) r = pick(rng);
+    return idx;
+}
+
+void deleteTree(Node* node) {
+    for (auto &child : node->children) deleteTree(child.second);
+    delete node;
+}
+
+vector<FlatTree> trainForest(const EncodedData &ed, int numTrees, int maxFeatures, uint64_t seed, TaskPool &pool) {
+    vector<FlatTree> forest(numTrees);
+    TaskPool::Group trees;
+    for (int t = 0; t < numTrees; t++)
+        pool.spawn(trees, [&ed, &forest, &pool, maxFeatures, seed, t] {
+            BuildOptions opt;
+            opt.maxFeatures = maxFeatures;
+            opt.seed = seed + t;
+            opt.trace = false;
+            vector<int> idx = bootstrapSample(ed.numRows, opt.seed);
+            AttrMask used((ed.classCol + 63) / 64, 0);
+            Node* root = buildTree(ed, idx, 0, ed.numRows, used, pool, opt);
+            forest[t] = compileTree(root, ed);
+            deleteTree(root);
+        });
+    pool.wait(trees);
+    return forest;
+}
+
+// Each training row is voted on only by the trees whose sample missed it.
+// Returns the error rate over the rows that got at least one such vote.
+double outOfBagError(const EncodedData &ed, const vector<FlatTree> &forest, uint64_t seed, TaskPool &pool,
+                     int &scored) {
+    int n = ed.numRows, K = ed.numClasses;
+    vector<int> votes((size_t)n * K, 0);
+    vector<char> inBag(n);
+    for (int t = 0; t < (int)forest.size(); t++) {
+        fill(inBag.begin(), inBag.end(), 0);
+        for (int r : bootstrapSample(n, seed + t)) inBag[r] = 1;
+
+        TaskPool::Group blocks;
+        for (int b = 0; b < n; b += PREDICT_BLOCK_ROWS) {
+            int e = min(n, b + PREDICT_BLOCK_ROWS);
+            pool.spawn(blocks, [&ed, &forest, &votes, &inBag, K, t, b, e] {
+                for (int r = b; r < e; r++) {
+                    if (inBag[r]) continue;
+                    // Training rows carry codes; a numeric code stands for values up to cuts[code]
+                    int c = walkTree(forest[t], [&](int col) { return ed.codes[col][r]; },
+                                     [&](int col) { return ed.cuts[col][ed.codes[col][r]]; });
+                    if (c >= 0) votes[(size_t)r * K + c]++;
+                }
+            });
+        }
+        pool.wait(blocks);
+    }
+
+    int wrong = 0;
+    scored = 0;
+    for (int r = 0; r < n; r++) {
+        int c = majorityVote(&votes[(size_t)r * K], K);
+        if (c < 0) continue;
+        scored++;
+        if (c != ed.codes[ed.classCol][r]) wrong++;
+    }
+    return scored ? (double)wrong / scored : 0.0;
 }
 
 // ---------- Main ----------
@@ -204,16 +940,132 @@ int main() {
     }
 
     vector<string> headers = data[0];
+
+    // Numeric columns get threshold splits instead of one branch per value
+    vector<char> numeric = detectNumeric(data);
+    int numericMode = NUMERIC_EXACT;
+    if (count(numeric.begin(), numeric.end(), 1) > 0) {
+        cout << "Numeric attributes:";
+        for (int col = 0; col < (int)numeric.size(); col++)
+            if (numeric[col]) cout << " " << headers[col];
+        cout << "\nThreshold search (1 = exact sorted sweep, 2 = 256-bin histogram): ";
+        cin >> numericMode;
+        if (numericMode != NUMERIC_HIST) numericMode = NUMERIC_EXACT;
+    }
+
+    int buildMode = 1, numTrees = 100, maxFeatures = 0;
+    cout << "Build (1) a single decision tree or (2) a random forest: ";
+    cin >> buildMode;
+    if (buildMode == 2) {
+        cout << "Number of trees: ";
+        cin >> numTrees;
+        cout << "Attributes tried per split (0 = square root of attribute count): ";
+        cin >> maxFeatures;
+        numTrees = max(1, numTrees);
+        if (maxFeatures <= 0) maxFeatures = max(1, (int)round(sqrt((double)headers.size() - 1)));
+    }
+
     cout << fixed << setprecision(4);
-    cout << "\n=========== GINI-BASED DECISION TREE ===========" << endl;
+    if (buildMode == 2)
+        cout << "\n=========== GINI-BASED RANDOM FOREST ===========" << endl;
+    else
+        cout << "\n=========== GINI-BASED DECISION TREE ===========" << endl;
+
+    // Encode once and drop the string copy; the tree is built on codes only
+    EncodedData ed = encodeData(data, numeric, numericMode);
+    vector<vector<string>>().swap(data);
+
+    TaskPool pool(thread::hardware_concurrency());
+    vector<FlatTree> forest;
 
-    Node* root = buildTree(data, headers);
+    if (buildMode == 2) {
+        const uint64_t seed = 20251107;
+        auto t0 = chrono::steady_clock::now();
+        forest = trainForest(ed, numTrees, maxFeatures, seed, pool);
+        double secs = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
 
-    cout << "\n=========== Final Decision Tree ===========" << endl;
-    printTree(root);
-    cout << "===============================================" << endl;
+        size_t totalNodes = 0;
+        for (const FlatTree &tree : forest) totalNodes += tree.nodes.size();
+        cout << "Trained " << numTrees << " trees in " << secs << " s ("
+             << maxFeatures << " attributes tried per split, "
+             << totalNodes / numTrees << " nodes per tree on average)" << endl;
+
+        int scored = 0;
+        double oob = outOfBagError(ed, forest, seed, pool, scored);
+        cout << "Out-of-bag error = " << 100.0 * oob << "% (" << scored << " records scored)" << endl;
+    } else {
+        vector<int> idx(ed.numRows);
+        iota(idx.begin(), idx.end(), 0);
+        AttrMask used((ed.classCol + 63) / 64, 0);
+
+        Node* root = buildTree(ed, idx, 0, ed.numRows, used, pool, BuildOptions());
+        printBuildLog(root);
+
+        cout << "\n=========== Final Decision Tree ===========" << endl;
+        printTree(root);
+        cout << "===============================================" << endl;
+
+        forest.push_back(compileTree(root, ed));
+    }
+
+    // ---------- Save Model ----------
+    string modelFile;
+    cout << "\nSave model as (.dtm file for ModelServer, or - to skip): ";
+    cin >> modelFile;
+    if (modelFile != "-") {
+        if (saveForest(ed, forest, modelFile)) cout << "Model saved to " << modelFile << endl;
+        else cout << "Error: Cannot write " << modelFile << endl;
+    }
 
     // ---------- Test Prediction ----------
+
+    int choice = 1;
+    cout << "\nPredict (1) one test case or (2) all records of a CSV file: ";
+    cin >> choice;
+
+    if (choice == 2) {
+        string testFile, outFile;
+        cout << "Enter test CSV filename: ";
+        cin >> testFile;
+        cout << "Enter output CSV filename: ";
+        cin >> outFile;
+
+        vector<vector<string>> test = readCSV(testFile);
+        if (test.size() < 2) {
+            cout << "Error: Empty or invalid test file.\n";
+            return 0;
+        }
+        vector<vector<string>> records(test.begin() + 1, test.end());
+        ColumnBatch batch = encodeBatch(records, ed);
+
+        auto t0 = chrono::steady_clock::now();
+        vector<int> predicted;
+        predictMany(forest, ed.numClasses, batch, predicted, pool);
+        double secs = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+
+        // Accuracy is reported when the test file still has the class column
+        int labelled = 0, correct = 0;
+        ofstream out(outFile);
+        for (int i = 0; i < (int)test[0].size(); i++) out << test[0][i] << ",";
+        out << "Predicted_" << headers.back() << "\n";
+        for (int r = 0; r < batch.numRows; r++) {
+            for (int i = 0; i < (int)records[r].size(); i++) out << records[r][i] << ",";
+            string label = classLabel(ed, predicted[r]);
+            out << label << "\n";
+            if (records[r].size() == headers.size()) {
+                labelled++;
+                if (records[r].back() == label) correct++;
+            }
+        }
+
+        cout << "\nScored " << batch.numRows << " records in " << secs << " s";
+        if (secs > 0) cout << " (" << (long long)(batch.numRows / secs) << " records/s)";
+        cout << "\nPredictions written to " << outFile << endl;
+        if (labelled > 0)
+            cout << "Accuracy = " << 100.0 * correct / labelled << "% (" << correct << "/" << labelled << ")" << endl;
+        return 0;
+    }
+
     cout << "\nEnter values for a test case:\n";
     vector<string> test(headers.size() - 1);
     for (int i = 0; i < headers.size() - 1; i++) {
@@ -221,7 +1073,9 @@ int main() {
         cin >> test[i];
     }
 
-    string result = predict(root, headers, test);
+    vector<int> predicted;
+    predictMany(forest, ed.numClasses, encodeBatch(vector<vector<string>>(1, test), ed), predicted, pool);
+    string result = classLabel(ed, predicted[0]);
     cout << "\nPredicted Class = " << result << endl;
 
     return 0;
@@ -254,6 +1108,34 @@ int main() {
 //     - Each row = one record.
 //     - The last column in the dataset is assumed to be the target class label.
 //
+// ➤ encodeData()
+//     - Converts every column into small integer codes once (dict[col][code] = value).
+//
+// ➤ countValueClass()
+//     - Fills a flat counts[value * numClasses + class] array for one attribute,
+//       replacing the nested map<string, map<string, double>> of the old version.
+//
+// ➤ findNumericSplit()
+//     - Numeric columns get binary "x <= threshold" splits instead of one branch per value.
+//     - Exact mode: one code per distinct value (column presorted once), swept with running counts.
+//     - Histogram mode: the column is bucketed into 256 quantile bins, and only bin edges are tried.
+//
+// ➤ partitionRows()
+//     - Reorders the node's slice of one shared row-index array so that rows are
+//       grouped by attribute value; children receive index ranges, not data copies.
+//     - Attributes already used on the path are tracked in a small bitmask.
+//
+// ➤ TaskPool / printBuildLog()
+//     - Big nodes compute the Gini of their attributes in parallel; smaller subtrees run as tasks
+//       on a work-stealing pool. Each node keeps its own log, printed afterwards in tree order,
+//       so the output matches a serial build exactly.
+//
+// ➤ trainForest() / outOfBagError()
+//     - Random forest mode: many trees grown in parallel on bootstrap samples of row indices over
+//       the same encoded data, each split trying only a random subset of attributes.
+//     - Rows left out of a tree's sample are used to estimate the out-of-bag error; predictions
+//       are a majority vote of all trees.
+//
 // ➤ struct Node
 //     - Represents a node in the decision tree.
 //     - Fields:
@@ -275,9 +1157,14 @@ int main() {
 // ➤ printTree()
 //     - Displays the final decision tree in a hierarchical structure.
 //
-// ➤ predict()
-//     - Predicts the class label for an unseen test record.
-//     - Traverses the tree according to input attribute values until a leaf node is reached.
+// ➤ compileTree() / predictMany()
+//     - Flattens the tree into a contiguous node array with integer feature ids and child offsets.
+//     - Predicts the class label for one test record or for a whole test CSV (scored in parallel),
+//       walking the flat tree according to the attribute values until a leaf node is reached.
+//
+// ➤ saveForest()
+//     - Saves the compiled tree(s) with the attribute dictionaries and class labels as a
+//       binary .dtm file, which ModelServer.cpp loads to serve predictions.
 //
 // ➤ main()
 //     - Reads dataset, builds the Gini-based decision tree, prints it, and predicts a class for user input.
@@ -0,0 +1,780 @@
+#include <bits/stdc++.h>
+using namespace std;
+
+// ---------- CSV Reader ----------
+vector<vector<string>> readCSV(const string &filename) {
+    vector<vector<string>> data;
+    ifstream file(filename);
+    string line;
+    while (getline(file, line)) {
+        if (line.empty()) continue;
+        stringstream ss(line);
+        string cell;
+        vector<string> row;
+        while (getline(ss, cell, ',')) {
+            if (!cell.empty() && cell.front() == ' ') cell.erase(cell.begin());
+            if (!cell.empty() && cell.back() == ' ') cell.pop_back();
+            row.push_back(cell);
+        }
+        data.push_back(row);
+    }
+    return data;
+}
+
+// Finite numbers only: "nan"/"inf" would break the sort in binNumeric
+bool isNumber(const string &s) {
+    if (s.empty()) return false;
+    char *end = nullptr;
+    double v = strtod(s.c_str(), &end);
+    return *end == '\0' && isfinite(v);
+}
+
+// ---------- Work-Stealing Task Pool ----------
+// Same pool as the decision tree programs: every thread owns a deque, pops
+// its own newest task and steals the oldest task of another thread when
+// idle. wait() runs tasks instead of blocking.
+class TaskPool {
+public:
+    struct Group { atomic<int> pending{0}; };
+
+    explicit TaskPool(int threads) {
+        threads = max(1, threads);
+        for (int i = 0; i < threads; i++) queues.emplace_back(new Queue());
+        for (int i = 1; i < threads; i++)
+            workers.emplace_back([this, i] {
+                self = i;
+                int misses = 0;
+                while (!stopping) {
+                    if (tryRunOne()) misses = 0;
+                    else if (++misses < 64) this_thread::yield();
+                    else this_thread::sleep_for(chrono::microseconds(100));
+                }
+            });
+    }
+
+    ~TaskPool() {
+        stopping = true;
+        for (auto &t : workers) t.join();
+    }
+
+    int size() const { return queues.size(); }
+
+    void spawn(Group &g, function<void()> fn) {
+        g.pending++;
+        Queue &q = *queues[self];
+        lock_guard<mutex> lock(q.m);
+        q.tasks.push_back(Task{&g, move(fn)});
+    }
+
+    void wait(Group &g) {
+        while (g.pending > 0)
+            if (!tryRunOne()) this_thread::yield();
+    }
+
+private:
+    struct Task { Group *group; function<void()> fn; };
+    struct Queue { mutex m; deque<Task> tasks; };
+
+    vector<unique_ptr<Queue>> queues;
+    vector<thread> workers;
+    atomic<bool> stopping{false};
+    static thread_local int self;
+
+    bool tryRunOne() {
+        Task task;
+        bool found = false;
+        {
+            Queue &q = *queues[self];
+            lock_guard<mutex> lock(q.m);
+            if (!q.tasks.empty()) {
+                task = move(q.tasks.back());
+                q.tasks.pop_back();
+                found = true;
+            }
+        }
+        for (int k = 1; !found && k < (int)queues.size(); k++) {
+            Queue &q = *queues[(self + k) % queues.size()];
+            lock_guard<mutex> lock(q.m);
+            if (!q.tasks.empty()) {
+                task = move(q.tasks.front());
+                q.tasks.pop_front();
+                found = true;
+            }
+        }
+        if (!found) return false;
+        task.fn();
+        task.group->pending--;
+        return true;
+    }
+};
+
+thread_local int TaskPool::self = 0;
+
+// ---------- Binned (Quantized) Dataset ----------
+// Every feature is quantized once into at most 256 bins, one byte per cell:
+//   numeric     : quantile bins; bin b holds the values in (upper[b - 1], upper[b]]
+//   categorical : one bin per value (values past the 255th share the last bin)
+// Trees only ever look at bin numbers, so a histogram of a node has at most
+// 256 slots per feature no matter how many distinct values a column has.
+const int MAX_BINS = 256;
+
+struct BinnedData {
+    vector<string> headers;               // feature names + target name
+    int numRows = 0;
+    int numFeatures = 0;
+    vector<char> isNumeric;
+    vector<int> numBins;
+    vector<vector<uint8_t>> bins;         // bins[feature][row]
+    vector<vector<double>> upper;         // numeric: upper edge of each bin
+    vector<vector<string>> catNames;      // categorical: bin -> value
+    vector<unordered_map<string, int>> catIndex;
+};
+
+void binNumeric(const vector<vector<string>> &data, int f, BinnedData &bd) {
+    vector<double> vals(bd.numRows);
+    for (int r = 0; r < bd.numRows; r++) vals[r] = strtod(data[r + 1][f].c_str(), nullptr);
+
+    vector<double> sorted = vals;
+    sort(sorted.begin(), sorted.end());
+    vector<double> &edges = bd.upper[f];
+    for (int b = 1; b <= MAX_BINS; b++) {
+        double edge = sorted[min((long long)bd.numRows - 1, (long long)b * bd.numRows / MAX_BINS)];
+        if (b == MAX_BINS) edge = sorted.back();
+        if (edges.empty() || edge > edges.back()) edges.push_back(edge);
+    }
+    bd.numBins[f] = edges.size();
+    for (int r = 0; r < bd.numRows; r++)
+        bd.bins[f][r] = lower_bound(edges.begin(), edges.end(), vals[r]) - edges.begin();
+}
+
+void binCategorical(const vector<vector<string>> &data, int f, BinnedData &bd) {
+    set<string> values;
+    for (int r = 0; r < bd.numRows; r++) values.insert(data[r + 1][f]);
+    for (const string &v : values) {
+        int b = min((int)bd.catNames[f].size(), MAX_BINS - 1);
+        if (b == (int)bd.catNames[f].size()) bd.catNames[f].push_back(v);
+        bd.catIndex[f][v] = b;
+    }
+    bd.numBins[f] = bd.catNames[f].size();
+    for (int r = 0; r < bd.numRows; r++) bd.bins[f][r] = bd.catIndex[f][data[r + 1][f]];
+}
+
+BinnedData binData(const vector<vector<string>> &data) {
+    BinnedData bd;
+    bd.headers = data[0];
+    bd.numRows = data.size() - 1;
+    bd.numFeatures = bd.headers.size() - 1;
+    int F = bd.numFeatures;
+    bd.isNumeric.assign(F, 0);
+    bd.numBins.assign(F, 0);
+    bd.bins.assign(F, vector<uint8_t>(bd.numRows));
+    bd.upper.resize(F);
+    bd.catNames.resize(F);
+    bd.catIndex.resize(F);
+
+    for (int f = 0; f < F; f++) {
+        bool numeric = true;
+        for (int r = 1; r < (int)data.size() && numeric; r++) numeric = isNumber(data[r][f]);
+        bd.isNumeric[f] = numeric;
+        if (numeric) binNumeric(data, f, bd);
+        else binCategorical(data, f, bd);
+    }
+    return bd;
+}
+
+// ---------- Histograms ----------
+// Per feature and bin: sum of gradients, sum of hessians and row count.
+struct HistBin {
+    double g = 0.0, h = 0.0;
+    int n = 0;
+};
+
+struct Histogram {
+    vector<HistBin> bins;                 // bins[feature * MAX_BINS + bin]
+};
+
+// Builds the histogram of rows idx[begin, end). Features are spread over
+// the pool; each feature is accumulated by one task in row order, so the
+// sums are the same for any number of threads.
+const int HIST_TASK_ROWS = 4096;
+
+void buildHistogram(const BinnedData &bd, const vector<int> &idx, int begin, int end, const vector<double> &grad,
+                    const vector<double> &hess, Histogram &hist, TaskPool &pool) {
+    hist.bins.assign((size_t)bd.numFeatures * MAX_BINS, HistBin());
+    auto one = [&](int f) {
+        HistBin *hb = &hist.bins[(size_t)f * MAX_BINS];
+        const uint8_t *bin = bd.bins[f].data();
+        for (int i = begin; i < end; i++) {
+            int r = idx[i];
+            HistBin &b = hb[bin[r]];
+            b.g += grad[r];
+            b.h += hess[r];
+            b.n++;
+        }
+    };
+    if (end - begin >= HIST_TASK_ROWS && pool.size() > 1) {
+        TaskPool::Group features;
+        for (int f = 0; f < bd.numFeatures; f++) pool.spawn(features, [&one, f] { one(f); });
+        pool.wait(features);
+    } else {
+        for (int f = 0; f < bd.numFeatures; f++) one(f);
+    }
+}
+
+// Histogram subtraction: the larger child is parent minus the smaller child,
+// so only the smaller child's rows are ever scanned.
+void subtractHistogram(const Histogram &parent, const Histogram &child, Histogram &out) {
+    out.bins.resize(parent.bins.size());
+    for (size_t i = 0; i < parent.bins.size(); i++) {
+        out.bins[i].g = parent.bins[i].g - child.bins[i].g;
+        out.bins[i].h = parent.bins[i].h - child.bins[i].h;
+        out.bins[i].n = parent.bins[i].n - child.bins[i].n;
+    }
+}
+
+// ---------- Split Finding ----------
+// Second-order gain of splitting a leaf with gradient sum G and hessian sum H:
+//   gain = GL² / (HL + λ) + GR² / (HR + λ) − G² / (H + λ)
+// For squared error this is the variance reduction; for log loss it plays the
+// role the Gini/entropy decrease plays in the single-tree programs.
+struct BoostParams {
+    int rounds = 100;
+    double learningRate = 0.1;
+    int maxLeaves = 31;
+    int minLeafRows = 20;
+    double lambda = 1.0;
+};
+
+struct SplitInfo {
+    double gain = 0.0;
+    int feature = -1;
+    int bin = -1;
+    bool categorical = false;   // left = (bin == this bin) instead of bin <= this bin
+};
+
+double leafScore(double g, double h, double lambda) { return g * g / (h + lambda); }
+
+SplitInfo findBestSplit(const BinnedData &bd, const Histogram &hist, double G, double H, int n,
+                        const BoostParams &p) {
+    SplitInfo best;
+    double parent = leafScore(G, H, p.lambda);
+    for (int f = 0; f < bd.numFeatures; f++) {
+        const HistBin *hb = &hist.bins[(size_t)f * MAX_BINS];
+        if (bd.isNumeric[f]) {
+            double gL = 0, hL = 0;
+            int nL = 0;
+            for (int b = 0; b + 1 < bd.numBins[f]; b++) {
+                gL += hb[b].g;
+                hL += hb[b].h;
+                nL += hb[b].n;
+                if (nL < p.minLeafRows) continue;
+                if (n - nL < p.minLeafRows) break;
+                double gain = leafScore(gL, hL, p.lambda) + leafScore(G - gL, H - hL, p.lambda) - parent;
+                if (gain > best.gain) best = SplitInfo{gain, f, b, false};
+            }
+        } else {
+            for (int b = 0; b < bd.numBins[f]; b++) {
+                if (hb[b].n < p.minLeafRows || n - hb[b].n < p.minLeafRows) continue;
+                double gain = leafScore(hb[b].g, hb[b].h, p.lambda) +
+                              leafScore(G - hb[b].g, H - hb[b].h, p.lambda) - parent;
+                if (gain > best.gain) best = SplitInfo{gain, f, b, true};
+            }
+        }
+    }
+    return best;
+}
+
+// ---------- Compiled Regression Tree ----------
+// Flat node array like the compiled decision trees: an internal node tests
+// one feature and jumps to child offsets, a leaf holds its output value.
+struct GBNode {
+    int feature = -1;           // -1 = leaf
+    bool categorical = false;
+    int bin = 0;                // split bin (training data)
+    double threshold = 0.0;     // numeric: x <= threshold goes left
+    int left = -1, right = -1;
+    double value = 0.0;         // leaf output (already scaled by learning rate)
+};
+
+typedef vector<GBNode> GBTree;
+
+// ---------- Leaf-Wise Tree Growth ----------
+// Grows one tree on the gradients: the leaf with the largest gain is split
+// next (not level by level) until maxLeaves is reached or no split helps.
+// Rows are kept in one index array and partitioned in place; each leaf
+// owns a [begin, end) slice. Training scores of every row are updated with
+// the leaf values on the way out.
+struct GrowLeaf {
+    int node, begin, end;
+    double g, h;
+    Histogram hist;
+    SplitInfo split;
+};
+
+GBTree growTree(const BinnedData &bd, const vector<double> &grad, const vector<double> &hess, vector<int> &idx,
+                const BoostParams &p, TaskPool &pool, vector<double> &score, int scoreStride, int scoreOffset) {
+    GBTree tree(1);
+    vector<GrowLeaf> leaves(1);
+    GrowLeaf &root = leaves[0];
+    root.node = 0;
+    root.begin = 0;
+    root.end = bd.numRows;
+    root.g = root.h = 0.0;
+    for (int r = 0; r < bd.numRows; r++) {
+        root.g += grad[r];
+        root.h += hess[r];
+    }
+    buildHistogram(bd, idx, 0, bd.numRows, grad, hess, root.hist, pool);
+    root.split = findBestSplit(bd, root.hist, root.g, root.h, bd.numRows, p);
+
+    while ((int)leaves.size() < p.maxLeaves) {
+        int pick = -1;
+        for (int i = 0; i < (int)leaves.size(); i++)
+            if (leaves[i].split.feature >= 0 && (pick < 0 || leaves[i].split.gain > leaves[pick].split.gain))
+                pick = i;
+        if (pick < 0) break;
+
+        GrowLeaf parent = move(leaves[pick]);
+        const SplitInfo &s = parent.split;
+        const uint8_t *bin = bd.bins[s.feature].data();
+        int mid = partition(idx.begin() + parent.begin, idx.begin() + parent.end, [&](int r) {
+            return s.categorical ? bin[r] == s.bin : bin[r] <= s.bin;
+        }) - idx.begin();
+
+        GBNode &nd = tree[parent.node];
+        nd.feature = s.feature;
+        nd.categorical = s.categorical;
+        nd.bin = s.bin;
+        nd.threshold = s.categorical ? 0.0 : bd.upper[s.feature][s.bin];
+        nd.left = tree.size();
+        nd.right = tree.size() + 1;
+        tree.resize(tree.size() + 2);
+
+        GrowLeaf left, right;
+        left.node = tree[parent.node].left;
+        right.node = tree[parent.node].right;
+        left.begin = parent.begin;
+        left.end = right.begin = mid;
+        right.end = parent.end;
+
+        // Scan only the smaller child; the other histogram is parent - smaller
+        bool leftSmaller = left.end - left.begin <= right.end - right.begin;
+        GrowLeaf &small = leftSmaller ? left : right;
+        GrowLeaf &large = leftSmaller ? right : left;
+        buildHistogram(bd, idx, small.begin, small.end, grad, hess, small.hist, pool);
+        subtractHistogram(parent.hist, small.hist, large.hist);
+
+        for (GrowLeaf *leaf : {&left, &right}) {
+            leaf->g = leaf->h = 0.0;
+            for (int i = leaf->begin; i < leaf->end; i++) {
+                leaf->g += grad[idx[i]];
+                leaf->h += hess[idx[i]];
+            }
+            leaf->split = findBestSplit(bd, leaf->hist, leaf->g, leaf->h, leaf->end - leaf->begin, p);
+        }
+
+        leaves[pick] = move(left);
+        leaves.push_back(move(right));
+    }
+
+    for (GrowLeaf &leaf : leaves) {
+        double value = -p.learningRate * leaf.g / (leaf.h + p.lambda);
+        tree[leaf.node].value = value;
+        for (int i = leaf.begin; i < leaf.end; i++) score[(size_t)idx[i] * scoreStride + scoreOffset] += value;
+    }
+    return tree;
+}
+
+// ---------- Prediction on Encoded Records ----------
+// A test record is encoded once into one double per feature: the value of a
+// numeric feature (NaN when missing or non-numeric) or the training bin of a
+// categorical one (-1 for a category never seen). The trees are then walked
+// on that array; NaN and unseen categories follow the right-hand branch.
+void encodeRecord(const BinnedData &bd, const vector<string> &record, double *x) {
+    for (int f = 0; f < bd.numFeatures; f++) {
+        bool present = f < (int)record.size();
+        if (bd.isNumeric[f]) {
+            x[f] = present && isNumber(record[f]) ? strtod(record[f].c_str(), nullptr) : NAN;
+        } else {
+            auto it = present ? bd.catIndex[f].find(record[f]) : bd.catIndex[f].end();
+            x[f] = it == bd.catIndex[f].end() ? -1.0 : it->second;
+        }
+    }
+}
+
+double predictTree(const GBTree &tree, const double *x) {
+    int id = 0;
+    while (tree[id].feature >= 0) {
+        const GBNode &nd = tree[id];
+        double v = x[nd.feature];
+        bool goLeft = nd.categorical ? v == nd.bin : v <= nd.threshold;
+        id = goLeft ? nd.left : nd.right;
+    }
+    return tree[id].value;
+}
+
+// ---------- Boosted Model ----------
+// Regression and binary classification use one tree per round; K-class
+// classification uses K trees per round (softmax).
+enum Task { REGRESSION = 1, CLASSIFICATION = 2 };
+
+struct BoostedModel {
+    int task = REGRESSION;
+    int outputs = 1;                  // raw scores per record
+    vector<double> base;              // initial score per output
+    vector<vector<GBTree>> trees;     // trees[output][round]
+    vector<string> classNames;
+};
+
+// Raw scores -> class probabilities (in place)
+void toProbabilities(double *s, int outputs) {
+    if (outputs == 1) {
+        double p = 1.0 / (1.0 + exp(-s[0]));
+        s[0] = p;
+        return;
+    }
+    double mx = *max_element(s, s + outputs), sum = 0.0;
+    for (int k = 0; k < outputs; k++) sum += (s[k] = exp(s[k] - mx));
+    for (int k = 0; k < outputs; k++) s[k] /= sum;
+}
+
+int predictedClass(const double *prob, int outputs) {
+    if (outputs == 1) return prob[0] >= 0.5 ? 1 : 0;
+    return max_element(prob, prob + outputs) - prob;
+}
+
+BoostedModel trainBoosting(const BinnedData &bd, int task, const vector<double> &y, int numClasses,
+                           const BoostParams &p, TaskPool &pool) {
+    int n = bd.numRows;
+    BoostedModel model;
+    model.task = task;
+    model.outputs = task == CLASSIFICATION && numClasses > 2 ? numClasses : 1;
+    int K = model.outputs;
+    model.trees.resize(K);
+
+    // Initial score: mean for regression, log-odds / log-prior for classes
+    model.base.assign(K, 0.0);
+    if (task == REGRESSION) {
+        model.base[0] = accumulate(y.begin(), y.end(), 0.0) / n;
+    } else {
+        vector<double> prior(max(2, numClasses), 0.0);
+        for (double v : y) prior[(int)v] += 1.0 / n;
+        if (K == 1) model.base[0] = log(max(prior[1], 1e-12) / max(prior[0], 1e-12));
+        else for (int k = 0; k < K; k++) model.base[k] = log(max(prior[k], 1e-12));
+    }
+
+    vector<double> score((size_t)n * K);
+    for (int r = 0; r < n; r++)
+        for (int k = 0; k < K; k++) score[(size_t)r * K + k] = model.base[k];
+
+    // Gradients of all outputs are taken from the scores at the start of the round
+    vector<vector<double>> grad(K, vector<double>(n)), hess(K, vector<double>(n));
+    vector<double> prob(K);
+    vector<int> idx(n);
+    for (int round = 1; round <= p.rounds; round++) {
+        for (int r = 0; r < n; r++) {
+            double *s = &score[(size_t)r * K];
+            if (task == REGRESSION) {
+                grad[0][r] = s[0] - y[r];
+                hess[0][r] = 1.0;
+                continue;
+            }
+            copy(s, s + K, prob.begin());
+            toProbabilities(prob.data(), K);
+            for (int k = 0; k < K; k++) {
+                double target = K == 1 ? y[r] : (y[r] == k ? 1.0 : 0.0);
+                grad[k][r] = prob[k] - target;
+                hess[k][r] = max(prob[k] * (1.0 - prob[k]), 1e-16);
+            }
+        }
+        for (int k = 0; k < K; k++) {
+            iota(idx.begin(), idx.end(), 0);
+            model.trees[k].push_back(growTree(bd, grad[k], hess[k], idx, p, pool, score, K, k));
+        }
+
+        if (round % 10 == 0 || round == p.rounds) {
+            double loss = 0.0;
+            int correct = 0;
+            for (int r = 0; r < n; r++) {
+                double *s = &score[(size_t)r * K];
+                if (task == REGRESSION) {
+                    loss += (s[0] - y[r]) * (s[0] - y[r]);
+                    continue;
+                }
+                copy(s, s + K, prob.begin());
+                toProbabilities(prob.data(), K);
+                int c = (int)y[r];
+                double pc = K == 1 ? (c == 1 ? prob[0] : 1.0 - prob[0]) : prob[c];
+                loss -= log(max(pc, 1e-15));
+                if (predictedClass(prob.data(), K) == c) correct++;
+            }
+            cout << "Round " << setw(4) << round << ": ";
+            if (task == REGRESSION) cout << "training RMSE = " << sqrt(loss / n) << endl;
+            else cout << "training log loss = " << loss / n << ", accuracy = " << 100.0 * correct / n << "%" << endl;
+        }
+    }
+    return model;
+}
+
+// Raw scores of one encoded record
+vector<double> predictScores(const BoostedModel &model, const double *x) {
+    vector<double> s = model.base;
+    for (int k = 0; k < model.outputs; k++)
+        for (const GBTree &tree : model.trees[k]) s[k] += predictTree(tree, x);
+    return s;
+}
+
+// Output text for raw scores: the regression value or the class name
+string predictLabel(const BoostedModel &model, vector<double> s) {
+    if (model.task == REGRESSION) {
+        ostringstream out;
+        out << fixed << setprecision(4) << s[0];
+        return out.str();
+    }
+    toProbabilities(s.data(), model.outputs);
+    return model.classNames[predictedClass(s.data(), model.outputs)];
+}
+
+// ---------- Main ----------
+int main() {
+    string filename;
+    cout << "Enter CSV filename: ";
+    cin >> filename;
+
+    vector<vector<string>> data = readCSV(filename);
+    if (data.size() < 2) {
+        cout << "Error: Empty or invalid file.\n";
+        return 0;
+    }
+    vector<string> headers = data[0];
+
+    // Rows whose width differs from the header cannot be binned or labelled
+    size_t kept = 1;
+    for (size_t r = 1; r < data.size(); r++)
+        if (data[r].size() == headers.size()) data[kept++].swap(data[r]);
+    if (kept < data.size()) {
+        cout << "Skipped " << data.size() - kept << " row(s) without " << headers.size() << " columns.\n";
+        data.resize(kept);
+    }
+    if (data.size() < 2) {
+        cout << "Error: No complete records in file.\n";
+        return 0;
+    }
+
+    int task = REGRESSION;
+    cout << "Task (1) regression or (2) classification on '" << headers.back() << "': ";
+    cin >> task;
+    if (task != CLASSIFICATION) task = REGRESSION;
+
+    BoostParams params;
+    cout << "Boosting rounds: ";
+    cin >> params.rounds;
+    cout << "Learning rate: ";
+    cin >> params.learningRate;
+    cout << "Max leaves per tree: ";
+    cin >> params.maxLeaves;
+    params.rounds = max(1, params.rounds);
+    params.maxLeaves = max(2, params.maxLeaves);
+
+    // Target column
+    int n = data.size() - 1;
+    vector<double> y(n);
+    vector<string> classNames;
+    if (task == REGRESSION) {
+        for (int r = 0; r < n; r++) {
+            if (!isNumber(data[r + 1].back())) {
+                cout << "Error: target '" << data[r + 1].back() << "' is not numeric.\n";
+                return 0;
+            }
+            y[r] = strtod(data[r + 1].back().c_str(), nullptr);
+        }
+    } else {
+        set<string> labels;
+        for (int r = 0; r < n; r++) labels.insert(data[r + 1].back());
+        classNames.assign(labels.begin(), labels.end());
+        for (int r = 0; r < n; r++)
+            y[r] = lower_bound(classNames.begin(), classNames.end(), data[r + 1].back()) - classNames.begin();
+    }
+
+    BinnedData bd = binData(data);
+    vector<vector<string>>().swap(data);
+
+    cout << fixed << setprecision(4);
+    cout << "\n=========== Gradient Boosted Trees ===========" << endl;
+    cout << "Records: " << n << ", features: " << bd.numFeatures << " (";
+    for (int f = 0; f < bd.numFeatures; f++)
+        cout << (f ? ", " : "") << bd.headers[f] << (bd.isNumeric[f] ? " numeric/" : " categorical/")
+             << bd.numBins[f] << " bins";
+    cout << ")" << endl;
+
+    TaskPool pool(thread::hardware_concurrency());
+    auto t0 = chrono::steady_clock::now();
+    BoostedModel model = trainBoosting(bd, task, y, classNames.size(), params, pool);
+    model.classNames = classNames;
+    double secs = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+
+    size_t leaves = 0, treeCount = 0;
+    for (auto &perOutput : model.trees)
+        for (const GBTree &tree : perOutput) {
+            treeCount++;
+            for (const GBNode &nd : tree) leaves += nd.feature < 0;
+        }
+    cout << "Trained " << treeCount << " trees (" << (double)leaves / treeCount << " leaves on average) in "
+         << secs << " s" << endl;
+
+    // ---------- Test Prediction ----------
+    int choice = 1;
+    cout << "\nPredict (1) one test case or (2) all records of a CSV file: ";
+    cin >> choice;
+
+    if (choice == 2) {
+        string testFile, outFile;
+        cout << "Enter test CSV filename: ";
+        cin >> testFile;
+        cout << "Enter output CSV filename: ";
+        cin >> outFile;
+
+        vector<vector<string>> test = readCSV(testFile);
+        if (test.size() < 2) {
+            cout << "Error: Empty or invalid test file.\n";
+            return 0;
+        }
+        int m = test.size() - 1;
+        vector<string> predicted(m);
+        vector<double> value(m);               // raw regression output, for the RMSE
+        TaskPool::Group blocks;
+        for (int b = 0; b < m; b += 4096) {
+            int e = min(m, b + 4096);
+            pool.spawn(blocks, [&, b, e] {
+                vector<double> x(bd.numFeatures);
+                for (int r = b; r < e; r++) {
+                    encodeRecord(bd, test[r + 1], x.data());
+                    vector<double> s = predictScores(model, x.data());
+                    value[r] = s[0];
+                    predicted[r] = predictLabel(model, s);
+                }
+            });
+        }
+        pool.wait(blocks);
+
+        // Metrics when the file still has the target column
+        int labelled = 0, correct = 0;
+        double sq = 0.0;
+        ofstream out(outFile);
+        for (const string &h : test[0]) out << h << ",";
+        out << "Predicted_" << headers.back() << "\n";
+        for (int r = 0; r < m; r++) {
+            const vector<string> &rec = test[r + 1];
+            for (const string &cell : rec) out << cell << ",";
+            out << predicted[r] << "\n";
+            if (rec.size() != headers.size()) continue;
+            if (task == REGRESSION) {
+                if (!isNumber(rec.back())) continue;
+                double d = value[r] - strtod(rec.back().c_str(), nullptr);
+                sq += d * d;
+                labelled++;
+            } else {
+                labelled++;
+                if (rec.back() == predicted[r]) correct++;
+            }
+        }
+        cout << "\nPredictions for " << m << " records written to " << outFile << endl;
+        if (labelled > 0) {
+            if (task == REGRESSION) cout << "Test RMSE = " << sqrt(sq / labelled) << endl;
+            else cout << "Test accuracy = " << 100.0 * correct / labelled << "% (" << correct << "/" << labelled << ")" << endl;
+        }
+        return 0;
+    }
+
+    cout << "\nEnter values for a test case:\n";
+    vector<string> record(headers.size() - 1);
+    for (int i = 0; i < (int)headers.size() - 1; i++) {
+        cout << headers[i] << ": ";
+        cin >> record[i];
+    }
+    vector<double> x(bd.numFeatures);
+    encodeRecord(bd, record, x.data());
+    cout << "\nPredicted " << headers.back() << " = " << predictLabel(model, predictScores(model, x.data())) << endl;
+    return 0;
+}
+// ==================================================================================================
+// 🔹 DETAILED EXPLANATION OF GRADIENT BOOSTED TREES PROGRAM
+// ==================================================================================================
+//
+// 🧩 PURPOSE:
+// This program trains a **Gradient Boosted Decision Tree** model (the idea behind LightGBM/XGBoost)
+// for **regression** (numeric target) or **classification** (categorical target).
+// Instead of one big tree, it adds many small trees; each new tree corrects the errors
+// (gradients) left by the trees before it.
+//
+// --------------------------------------------------------------------------------------------------
+// 🔸 1️⃣ FUNCTION OVERVIEW
+// --------------------------------------------------------------------------------------------------
+//
+// ➤ binData()
+//     - Quantizes every feature once into at most 256 bins (1 byte per cell).
+//     - Numeric columns → quantile bins; categorical columns → one bin per value.
+//
+// ➤ buildHistogram() / subtractHistogram()
+//     - For the rows of a leaf, sums gradient, hessian and count per (feature, bin).
+//     - Features are processed in parallel on a work-stealing pool.
+//     - After a split only the smaller child is scanned; the larger child's histogram is
+//       parent − smaller child (the "histogram subtraction trick").
+//
+// ➤ findBestSplit()
+//     - Sweeps each feature's bins with running sums and scores every split with
+//           gain = GL²/(HL+λ) + GR²/(HR+λ) − G²/(H+λ)
+//     - Numeric features split as x <= threshold; categorical ones as value == v vs the rest.
+//
+// ➤ growTree()
+//     - Leaf-wise growth: always splits the leaf with the largest gain, until the
+//       maximum number of leaves is reached or no split has positive gain.
+//     - Rows are partitioned in place inside one index array (no data copies).
+//     - Leaf value = −learningRate × G / (H + λ).
+//
+// ➤ trainBoosting()
+//     - Regression: squared error (gradient = prediction − y, hessian = 1).
+//     - Two classes: logistic loss; more classes: softmax with one tree per class per round.
+//     - Prints the training RMSE or log loss/accuracy every 10 rounds.
+//
+// ➤ encodeRecord() / predictTree() / predictLabel()
+//     - A test record is parsed once into one double per feature (numeric value or category bin).
+//     - Each tree is a flat array of nodes (feature, threshold, child offsets, leaf value),
+//       the same compiled layout used by the decision tree programs, walked on that array.
+//     - A record's score = initial score + sum of all tree outputs.
+//
+// --------------------------------------------------------------------------------------------------
+// 🔸 2️⃣ ALGORITHM FLOW
+// --------------------------------------------------------------------------------------------------
+//
+// STEP 1: Start every record at the initial score (mean of y, or class log-odds).
+// STEP 2: Compute gradient and hessian of the loss for every record.
+// STEP 3: Grow a small tree on those gradients (histograms → best split → leaf-wise growth).
+// STEP 4: Add learningRate × tree output to every record's score.
+// STEP 5: Repeat for the requested number of rounds.
+//
+// --------------------------------------------------------------------------------------------------
+// 🔸 3️⃣ EXAMPLE
+// --------------------------------------------------------------------------------------------------
+//
+//     Enter CSV filename: house.csv
+//     Task (1) regression or (2) classification on 'Price': 1
+//     Boosting rounds: 100
+//     Learning rate: 0.1
+//     Max leaves per tree: 31
+//
+//     Round   10: training RMSE = 41.2035
+//     ...
+//     Round  100: training RMSE = 8.9127
+//
+// --------------------------------------------------------------------------------------------------
+// 🔸 4️⃣ WHY GRADIENT BOOSTING
+// --------------------------------------------------------------------------------------------------
+//
+// 🔹 A single decision tree (ID3 / Gini) is easy to read but not very accurate.
+// 🔹 Boosting many shallow trees gives much better accuracy on both numeric and
+//     categorical data, and works for regression as well as classification.
+// 🔹 Histogram-based training makes the cost depend on 256 bins per feature instead of the
+//     number of distinct values, so it scales to very large files.
+//
+// ==================================================================================================
@@ -1,14 +1,15 @@
 #include <bits/stdc++.h>
 using namespace std;
 
-double entropy(const map<string, double> &classCounts) {
+// counts[] is one dense row of class counts (one slot per class code).
+double entropy(const double *counts, int numClasses) {
     double total = 0.0;
-    for (auto &p : classCounts) total += p.second;
+    for (int c = 0; c < numClasses; c++) total += counts[c];
     if (total == 0) return 0.0;
 
     double e = 0.0;
-    for (auto &p : classCounts) {
-        double ratio = p.second / total;
+    for (int c = 0; c < numClasses; c++) {
+        double ratio = counts[c] / total;
         if (ratio > 0)
             e += -ratio * log2(ratio);
     }
@@ -34,6 +35,72 @@ vector<vector<string>> readCSV(const string &filename) {
     return data;
 }
 
+// ---------- Dictionary-Encoded Dataset ----------
+// Every column (attributes and the class column) is encoded once into small
+// integer codes. Codes follow sorted value order, so looping over codes visits
+// values in the same order the old map<string, ...> tables did.
+struct EncodedData {
+    vector<string> headers;
+    vector<vector<string>> dict;   // dict[col][code] -> original value
+    vector<vector<int>> codes;     // codes[col][row] (column-major)
+    int numRows = 0;
+    int classCol = 0;              // last column = target
+    int numClasses = 0;
+};
+
+EncodedData encodeData(const vector<vector<string>> &data) {
+    EncodedData ed;
+    ed.headers = data[0];
+    int cols = ed.headers.size();
+    ed.numRows = data.size() - 1;
+    ed.classCol = cols - 1;
+    ed.dict.resize(cols);
+    ed.codes.assign(cols, vector<int>(ed.numRows));
+
+    for (int col = 0; col < cols; col++) {
+        // Class is always the last cell of a row (as in the original code)
+        auto cell = [&](int r) -> const string & {
+            const vector<string> &row = data[r + 1];
+            static const string missing;
+            if (col == ed.classCol) return row.empty() ? missing : row.back();
+            return col < (int)row.size() ? row[col] : missing;
+        };
+        // First pass: codes in order of first appearance
+        unordered_map<string, int> index;
+        vector<int> &codes = ed.codes[col];
+        for (int r = 0; r < ed.numRows; r++) {
+            auto it = index.emplace(cell(r), (int)index.size()).first;
+            codes[r] = it->second;
+        }
+        // Re-number codes so they follow sorted value order
+        vector<string> &values = ed.dict[col];
+        values.resize(index.size());
+        for (auto &kv : index) values[kv.second] = kv.first;
+        vector<int> order(values.size()), remap(values.size());
+        iota(order.begin(), order.end(), 0);
+        sort(order.begin(), order.end(), [&](int a, int b) { return values[a] < values[b]; });
+        vector<string> sorted(values.size());
+        for (int i = 0; i < (int)order.size(); i++) {
+            remap[order[i]] = i;
+            sorted[i] = values[order[i]];
+        }
+        values.swap(sorted);
+        for (int &c : codes) c = remap[c];
+    }
+    ed.numClasses = ed.dict[ed.classCol].size();
+    return ed;
+}
+
+// ---------- Split Finder: dense value x class counts ----------
+// counts[v * numClasses + c] = number of rows with value v and class c.
+void countValueClass(const EncodedData &ed, int col, const vector<int> &rows, vector<double> &counts) {
+    int K = ed.numClasses;
+    counts.assign(ed.dict[col].size() * K, 0.0);
+    const int *attr = ed.codes[col].data();
+    const int *cls = ed.codes[ed.classCol].data();
+    for (int r : rows) counts[attr[r] * K + cls[r]] += 1.0;
+}
+
 int main() {
     string filename;
     cout << "Enter CSV filename: ";
@@ -45,46 +112,52 @@ int main() {
         return 0;
     }
 
-    vector<string> headers = data[0];
-    int totalRecords = data.size() - 1;
+    EncodedData ed = encodeData(data);
+    const vector<string> &headers = ed.headers;
+    const vector<string> &classNames = ed.dict[ed.classCol];
+    int totalRecords = ed.numRows;
+    int K = ed.numClasses;
     string target = headers.back();
 
+    vector<int> rows(totalRecords);
+    iota(rows.begin(), rows.end(), 0);
+
     cout << fixed << setprecision(4);
 
     // Step 1: Calculate Parent Entropy
-    map<string, double> totalTargetCount;
-    for (int i = 1; i < data.size(); i++)
-        totalTargetCount[data[i].back()]++;
+    vector<double> totalTargetCount(K, 0.0);
+    for (int r : rows) totalTargetCount[ed.codes[ed.classCol][r]]++;
 
-    double totalEntropy = entropy(totalTargetCount);
+    double totalEntropy = entropy(totalTargetCount.data(), K);
     cout << "\nEntropy (Parent) = " << totalEntropy << endl;
 
     string bestAttr;
     double bestInfoGain = -1;
 
     // Step 2: For each attribute, calculate Information Gain
-    for (int col = 0; col < headers.size() - 1; col++) {
+    vector<double> valueClassCount;
+    for (int col = 0; col < ed.classCol; col++) {
         string attr = headers[col];
         cout << "\nFor Attribute: " << attr << endl;
 
         // Count how target classes distribute under each attribute value
-        map<string, map<string, double>> valueClassCount;
-        for (int i = 1; i < data.size(); i++)
-            valueClassCount[data[i][col]][data[i].back()]++;
+        countValueClass(ed, col, rows, valueClassCount);
 
         double weightedEntropy = 0.0;
 
-        for (auto &kv : valueClassCount) {
-            string value = kv.first;
+        for (int v = 0; v < (int)ed.dict[col].size(); v++) {
+            const string &value = ed.dict[col][v];
+            const double *cnt = &valueClassCount[v * K];
             double subsetTotal = 0.0;
-            for (auto &cls : kv.second) subsetTotal += cls.second;
+            for (int c = 0; c < K; c++) subsetTotal += cnt[c];
+            if (subsetTotal == 0) continue;
 
-            double e = entropy(kv.second);
+            double e = entropy(cnt, K);
             weightedEntropy += (subsetTotal / totalRecords) * e;
 
             cout << "  Entropy(" << value << ") = " << e << " -> ";
-            for (auto &cls : kv.second)
-                cout << cls.first << "=" << cls.second << " ";
+            for (int c = 0; c < K; c++)
+                if (cnt[c] > 0) cout << classNames[c] << "=" << cnt[c] << " ";
             cout << endl;
         }
 
@@ -133,6 +206,10 @@ int main() {
 //     - The first row (headers) contains attribute names.
 //     - The last column is the **target attribute** (class label).
 //
+// ➤ encodeData() / countValueClass()
+//     - Encode every column into integer codes once, then count value × class
+//       pairs into one flat array per attribute instead of nested string maps.
+//
 // ➤ main()
 //     - Reads the dataset.
 //     - Calculates total (parent) entropy of the target class.
@@ -202,8 +279,8 @@ int main() {
 // headers[]         → Stores attribute names from first row.
 // totalRecords      → Number of data records (excluding header).
 // target            → Name of target class column.
-// totalTargetCount  → Map storing frequency of each class label (e.g., Yes=9, No=5).
-// valueClassCount   → Nested map to count occurrences of class labels for each attribute value.
+// totalTargetCount  → Dense array storing frequency of each class code (e.g., Yes=9, No=5).
+// valueClassCount   → Flat array [value][class] of class counts for each attribute value.
 // totalEntropy      → Entropy of the parent dataset (before splitting).
 // weightedEntropy   → Average entropy across all attribute values, weighted by subset size.
 // infoGain          → Difference between totalEntropy and weightedEntropy (gain in purity).
@@ -0,0 +1,192 @@
+#include <bits/stdc++.h>
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+using namespace std;
+
+// ---------- Read Test Records ----------
+// Keeps every data line of the CSV as raw text; the server ignores a
+// trailing class column, so labelled test files can be replayed as they are.
+vector<string> readRecords(const string &filename) {
+    ifstream file(filename);
+    vector<string> lines;
+    string line;
+    getline(file, line);                          // header
+    while (getline(file, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (!line.empty()) lines.push_back(line);
+    }
+    return lines;
+}
+
+// ---------- Latency Statistics ----------
+double percentile(vector<double> &v, double p) {
+    if (v.empty()) return 0.0;
+    size_t k = min(v.size() - 1, (size_t)ceil(p * v.size()) - (p > 0 ? 1 : 0));
+    nth_element(v.begin(), v.begin() + k, v.end());
+    return v[k];
+}
+
+#ifndef _WIN32
+
+// ---------- One Client Connection ----------
+// Closed loop: send a request (batch records + empty line), wait for the
+// whole reply (one label per record + empty line), record the round trip,
+// repeat. Returns false if the connection fails.
+bool runClient(const string &path, const vector<string> &records, int client, int numRequests, int batch,
+               vector<double> &latency, string &firstReply) {
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (fd < 0 || path.size() >= sizeof(addr.sun_path)) return false;
+    strcpy(addr.sun_path, path.c_str());
+    if (connect(fd, (sockaddr *)&addr, sizeof(addr)) < 0) {
+        close(fd);
+        return false;
+    }
+
+    size_t next = (size_t)client * numRequests * batch;
+    string request, reply;
+    char buf[65536];
+    for (int q = 0; q < numRequests; q++) {
+        request.clear();
+        for (int i = 0; i < batch; i++) {
+            request += records[next++ % records.size()];
+            request += '\n';
+        }
+        request += '\n';
+
+        auto t0 = chrono::steady_clock::now();
+        for (size_t sent = 0; sent < request.size();) {
+            ssize_t n = write(fd, request.data() + sent, request.size() - sent);
+            if (n <= 0) {
+                close(fd);
+                return false;
+            }
+            sent += n;
+        }
+        reply.clear();
+        int newlines = 0;
+        while (newlines < batch + 1) {
+            ssize_t n = read(fd, buf, sizeof(buf));
+            if (n <= 0) {
+                close(fd);
+                return false;
+            }
+            newlines += count(buf, buf + n, '\n');
+            reply.append(buf, n);
+        }
+        latency.push_back(chrono::duration<double, micro>(chrono::steady_clock::now() - t0).count());
+        if (q == 0) firstReply = reply;
+    }
+    close(fd);
+    return true;
+}
+
+#endif
+
+// ---------- Main ----------
+int main() {
+#ifdef _WIN32
+    cout << "Error: The load generator needs Unix domain sockets; build it on Linux or macOS.\n";
+    return 0;
+#else
+    string path, filename;
+    int connections = 4, numRequests = 1000, batch = 1;
+    cout << "Enter server socket path: ";
+    cin >> path;
+    cout << "Enter CSV file with test records: ";
+    cin >> filename;
+    cout << "Concurrent connections: ";
+    cin >> connections;
+    cout << "Requests per connection: ";
+    cin >> numRequests;
+    cout << "Records per request: ";
+    cin >> batch;
+    connections = max(1, connections);
+    numRequests = max(1, numRequests);
+    batch = max(1, batch);
+
+    vector<string> records = readRecords(filename);
+    if (records.empty()) {
+        cout << "Error: Empty or invalid test file.\n";
+        return 0;
+    }
+
+    vector<vector<double>> latency(connections);
+    vector<string> firstReply(connections);
+    vector<char> ok(connections, 0);
+    vector<thread> clients;
+    auto t0 = chrono::steady_clock::now();
+    for (int c = 0; c < connections; c++)
+        clients.emplace_back([&, c] {
+            ok[c] = runClient(path, records, c, numRequests, batch, latency[c], firstReply[c]);
+        });
+    for (thread &t : clients) t.join();
+    double secs = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+
+    vector<double> all;
+    for (int c = 0; c < connections; c++) {
+        if (!ok[c]) cout << "Connection " << c << " failed (is the server running on " << path << "?)\n";
+        all.insert(all.end(), latency[c].begin(), latency[c].end());
+    }
+    if (all.empty()) return 0;
+
+    cout << fixed << setprecision(1);
+    cout << "\nFirst reply:\n" << firstReply[0];
+    cout << "Requests: " << all.size() << " in " << secs << " s";
+    if (secs > 0)
+        cout << " (" << (long long)(all.size() / secs) << " requests/s, "
+             << (long long)(all.size() * batch / secs) << " records/s)";
+    cout << endl;
+    double worst = *max_element(all.begin(), all.end());
+    double p50 = percentile(all, 0.50), p99 = percentile(all, 0.99);
+    cout << "Round-trip latency: p50 = " << p50 << " us, p99 = " << p99 << " us, max = " << worst << " us" << endl;
+    return 0;
+#endif
+}
+
+// ==================================================================================================
+// 🔹 DETAILED EXPLANATION OF THE MODEL SERVER LOAD GENERATOR
+// ==================================================================================================
+//
+// 🧩 PURPOSE:
+// Measures how fast ModelServer.cpp answers predictions. Several client connections replay the
+// records of a test CSV against the server's Unix domain socket at the same time and time every
+// request from the first byte sent to the last byte of the reply.
+//
+// --------------------------------------------------------------------------------------------------
+// 🔸 1️⃣ FUNCTION OVERVIEW
+// --------------------------------------------------------------------------------------------------
+//
+// ➤ readRecords()
+//     - Loads the data lines of the test CSV (header skipped) as raw text.
+//
+// ➤ runClient()
+//     - One connection in a closed loop: send a request of N record lines plus an empty line,
+//       read the N labels plus the empty line, record the round-trip time.
+//
+// ➤ percentile()
+//     - p50 / p99 of the collected latencies (nth_element, no full sort).
+//
+// ➤ main()
+//     - Asks for socket path, test CSV, connections, requests per connection and records per
+//       request; runs one thread per connection and prints throughput and latency.
+//
+// --------------------------------------------------------------------------------------------------
+// 🔸 2️⃣ EXAMPLE
+// --------------------------------------------------------------------------------------------------
+//
+//     Enter server socket path: /tmp/model.sock
+//     Enter CSV file with test records: test.csv
+//     Concurrent connections: 8
+//     Requests per connection: 10000
+//     Records per request: 16
+//
+//     Requests: 80000 in 2.1 s (38095 requests/s, 609523 records/s)
+//     Round-trip latency: p50 = 180.3 us, p99 = 540.7 us, max = 2101.9 us
+//
+// ==================================================================================================
@@ -8,111 +8,431 @@ vector<string> split(const string &s, char d) {
     return tokens;
 }
 
-int main() {
-    string filename;
-    cout << "Enter CSV filename: ";
-    cin >> filename;
-
-    ifstream file(filename);
-    if (!file.is_open()) {
-        cout << "Error: Cannot open file.\n";
-        return 0;
+// ---------- Single-Pass Naive Bayes Trainer ----------
+// Copy of the trainer, .nbm persistence and merge code (through buildModel)
+// in NaiveNumeric.cpp, which documents it. Each program is built on its own,
+// so fix NaiveNumeric.cpp, NaiveB.cpp and bayes.cpp together.
+struct RunningStats {
+    long long n = 0;
+    double mean = 0.0, m2 = 0.0;
+
+    void add(double x) {
+        n++;
+        double d = x - mean;
+        mean += d / n;
+        m2 += d * (x - mean);
+    }
+    double stddev() const { return n > 0 ? sqrt(m2 / n) : 0.0; }   // population
+
+    void merge(const RunningStats &o) {
+        if (o.n == 0) return;
+        long long total = n + o.n;
+        double d = o.mean - mean;
+        mean += d * o.n / total;
+        m2 += o.m2 + d * d * ((double)n * o.n / total);
+        n = total;
+    }
+};
+
+struct NaiveBayesModel {
+    vector<string> headers;
+    int featureCount = 0;
+    vector<bool> isNum;                          // per feature
+    vector<string> classNames;                   // class code -> label
+    unordered_map<string, int> classIndex;
+    vector<long long> classCount;                // per class code
+    vector<vector<string>> valueNames;           // [feature][value code] -> value
+    vector<unordered_map<string, int>> valueIndex;
+    vector<vector<long long>> counts;            // [feature][value * numClasses + class]
+    vector<vector<RunningStats>> stats;          // [feature][class], numeric features
+    long long total = 0;
+    long long skippedCells = 0;                  // non-numeric cells of numeric features (not saved)
+
+    int numClasses() const { return classNames.size(); }
+};
+
+void initModel(NaiveBayesModel &m, const vector<string> &headers, const vector<bool> &isNum) {
+    m.headers = headers;
+    m.featureCount = headers.size() - 1;         // Last column = Class
+    m.isNum = isNum;
+    m.valueNames.assign(m.featureCount, {});
+    m.valueIndex.assign(m.featureCount, {});
+    m.counts.assign(m.featureCount, {});
+    m.stats.assign(m.featureCount, {});
+}
+
+int classCode(NaiveBayesModel &m, const string &label) {
+    auto it = m.classIndex.find(label);
+    if (it != m.classIndex.end()) return it->second;
+
+    int K = m.numClasses();
+    for (int f = 0; f < m.featureCount; f++) {
+        if (m.isNum[f]) {
+            m.stats[f].push_back(RunningStats());
+            continue;
+        }
+        int V = m.valueNames[f].size();
+        vector<long long> wider((size_t)V * (K + 1), 0);
+        for (int v = 0; v < V; v++)
+            copy(m.counts[f].begin() + (size_t)v * K, m.counts[f].begin() + (size_t)(v + 1) * K,
+                 wider.begin() + (size_t)v * (K + 1));
+        m.counts[f].swap(wider);
+    }
+    m.classNames.push_back(label);
+    m.classCount.push_back(0);
+    m.classIndex[label] = K;
+    return K;
+}
+
+int valueCode(NaiveBayesModel &m, int f, const string &value) {
+    auto it = m.valueIndex[f].find(value);
+    if (it != m.valueIndex[f].end()) return it->second;
+    int code = m.valueNames[f].size();
+    m.valueNames[f].push_back(value);
+    m.valueIndex[f][value] = code;
+    m.counts[f].resize(m.counts[f].size() + m.numClasses(), 0);
+    return code;
+}
+
+int findValue(const NaiveBayesModel &m, int f, const string &value) {
+    auto it = m.valueIndex[f].find(value);
+    return it == m.valueIndex[f].end() ? -1 : it->second;
+}
+
+long long valueCount(const NaiveBayesModel &m, int f, int value, int cls) {
+    return m.counts[f][(size_t)value * m.numClasses() + cls];
+}
+
+void makeNumeric(NaiveBayesModel &m, int f) {
+    for (long long n : m.counts[f]) m.skippedCells += n;
+    m.isNum[f] = true;
+    m.counts[f].clear();
+    m.valueNames[f].clear();
+    m.valueIndex[f].clear();
+    m.stats[f].assign(m.numClasses(), RunningStats());
+}
+
+void addRecord(NaiveBayesModel &m, const vector<string> &row, bool (*numericTest)(const string &)) {
+    int c = classCode(m, row.back());
+    int K = m.numClasses();
+    m.classCount[c]++;
+    m.total++;
+    for (int f = 0; f < m.featureCount; f++) {
+        if (numericTest && numericTest(row[f])) {
+            if (!m.isNum[f]) makeNumeric(m, f);
+            m.stats[f][c].add(strtod(row[f].c_str(), nullptr));
+        } else if (m.isNum[f]) {
+            m.skippedCells++;
+        } else {
+            m.counts[f][(size_t)valueCode(m, f, row[f]) * K + c]++;
+        }
     }
+}
 
+bool trainNaiveBayes(istream &in, NaiveBayesModel &m, bool (*numericTest)(const string &)) {
     string line;
-    getline(file, line);
+    if (!getline(in, line)) return false;
     vector<string> headers = split(line, ',');
-    int featureCount = headers.size() - 1;  // Last column = Class
+    if (headers.size() < 2) return false;
 
-    vector<vector<string>> data;
-    while (getline(file, line)) {
+    initModel(m, headers, vector<bool>(headers.size() - 1, false));
+    while (getline(in, line)) {
         vector<string> row = split(line, ',');
-        if (row.size() == headers.size())
-            data.push_back(row);
+        if (row.size() != headers.size()) continue;
+        addRecord(m, row, numericTest);
+    }
+    return true;
+}
+
+vector<int> sortedClasses(const NaiveBayesModel &m) {
+    vector<int> order(m.numClasses());
+    iota(order.begin(), order.end(), 0);
+    sort(order.begin(), order.end(),
+         [&](int a, int b) { return m.classNames[a] < m.classNames[b]; });
+    return order;
+}
+
+vector<int> sortedValues(const NaiveBayesModel &m, int f) {
+    vector<int> order(m.valueNames[f].size());
+    iota(order.begin(), order.end(), 0);
+    sort(order.begin(), order.end(),
+         [&](int a, int b) { return m.valueNames[f][a] < m.valueNames[f][b]; });
+    return order;
+}
+
+// ---------- Model Persistence and Merging ----------
+const char NB_MAGIC[4] = {'N', 'B', 'M', '1'};
+
+template <class T> void writePod(ostream &out, const T &x) { out.write((const char *)&x, sizeof(T)); }
+template <class T> bool readPod(istream &in, T &x) { return (bool)in.read((char *)&x, sizeof(T)); }
+
+void writeString(ostream &out, const string &s) {
+    writePod(out, (uint32_t)s.size());
+    out.write(s.data(), s.size());
+}
+
+bool readCount(istream &in, uint32_t &n, uint64_t size, uint64_t each) {
+    return readPod(in, n) && n <= size / each;
+}
+
+bool readString(istream &in, string &s, uint64_t size) {
+    uint32_t n;
+    if (!readCount(in, n, size, 1)) return false;
+    s.resize(n);
+    return (bool)in.read(&s[0], n);
+}
+
+bool saveModel(const NaiveBayesModel &m, const string &filename) {
+    ofstream out(filename, ios::binary);
+    if (!out.is_open()) return false;
+    out.write(NB_MAGIC, 4);
+    writePod(out, (uint32_t)m.headers.size());
+    for (auto &h : m.headers) writeString(out, h);
+    for (int f = 0; f < m.featureCount; f++) writePod(out, (uint8_t)m.isNum[f]);
+
+    int K = m.numClasses();
+    writePod(out, (uint32_t)K);
+    for (auto &c : m.classNames) writeString(out, c);
+    out.write((const char *)m.classCount.data(), K * sizeof(long long));
+    writePod(out, m.total);
+
+    for (int f = 0; f < m.featureCount; f++) {
+        if (m.isNum[f]) {
+            for (auto &s : m.stats[f]) {
+                writePod(out, s.n);
+                writePod(out, s.mean);
+                writePod(out, s.m2);
+            }
+        } else {
+            writePod(out, (uint32_t)m.valueNames[f].size());
+            for (auto &v : m.valueNames[f]) writeString(out, v);
+            out.write((const char *)m.counts[f].data(), m.counts[f].size() * sizeof(long long));
+        }
     }
-    file.close();
+    return (bool)out;
+}
+
+bool isModelFile(const string &filename) {
+    ifstream in(filename, ios::binary);
+    char magic[4];
+    return in.read(magic, 4) && equal(magic, magic + 4, NB_MAGIC);
+}
+
+bool loadModel(NaiveBayesModel &m, const string &filename) {
+    ifstream in(filename, ios::binary | ios::ate);
+    uint64_t size = max(0LL, (long long)in.tellg());
+    in.seekg(0);
+    char magic[4];
+    if (!in.read(magic, 4) || !equal(magic, magic + 4, NB_MAGIC)) return false;
+
+    uint32_t numHeaders;
+    if (!readCount(in, numHeaders, size, sizeof(uint32_t)) || numHeaders < 2) return false;
+    vector<string> headers(numHeaders);
+    for (auto &h : headers)
+        if (!readString(in, h, size)) return false;
+    vector<bool> isNum(numHeaders - 1);
+    for (size_t f = 0; f < isNum.size(); f++) {
+        uint8_t b;
+        if (!readPod(in, b)) return false;
+        isNum[f] = b;
+    }
+    initModel(m, headers, isNum);
+
+    uint32_t K;
+    if (!readCount(in, K, size, sizeof(long long))) return false;
+    m.classNames.resize(K);
+    for (uint32_t c = 0; c < K; c++) {
+        if (!readString(in, m.classNames[c], size)) return false;
+        m.classIndex[m.classNames[c]] = c;
+    }
+    m.classCount.resize(K);
+    if (!in.read((char *)m.classCount.data(), K * sizeof(long long)) || !readPod(in, m.total)) return false;
+
+    for (int f = 0; f < m.featureCount; f++) {
+        if (m.isNum[f]) {
+            m.stats[f].resize(K);
+            for (auto &s : m.stats[f])
+                if (!readPod(in, s.n) || !readPod(in, s.mean) || !readPod(in, s.m2)) return false;
+        } else {
+            uint32_t V;
+            if (!readCount(in, V, size, sizeof(uint32_t)) || (uint64_t)V * K > size / sizeof(long long)) return false;
+            m.valueNames[f].resize(V);
+            m.valueIndex[f].reserve(V);
+            for (uint32_t v = 0; v < V; v++) {
+                if (!readString(in, m.valueNames[f][v], size)) return false;
+                m.valueIndex[f][m.valueNames[f][v]] = v;
+            }
+            m.counts[f].resize((size_t)V * K);
+            if (!in.read((char *)m.counts[f].data(), m.counts[f].size() * sizeof(long long))) return false;
+        }
+    }
+    return true;
+}
+
+bool mergeModel(NaiveBayesModel &dst, const NaiveBayesModel &src) {
+    if (src.headers.empty()) return true;
+    if (dst.headers.empty()) {
+        dst = src;
+        return true;
+    }
+    if (dst.headers != src.headers) return false;
+
+    int srcK = src.numClasses();
+    vector<int> classMap(srcK);
+    for (int c = 0; c < srcK; c++) classMap[c] = classCode(dst, src.classNames[c]);
+    int K = dst.numClasses();
+
+    for (int c = 0; c < srcK; c++) dst.classCount[classMap[c]] += src.classCount[c];
+    dst.total += src.total;
+    dst.skippedCells += src.skippedCells;
+
+    for (int f = 0; f < dst.featureCount; f++) {
+        if (src.isNum[f] && !dst.isNum[f]) makeNumeric(dst, f);
+        if (dst.isNum[f]) {
+            if (!src.isNum[f]) {
+                for (long long n : src.counts[f]) dst.skippedCells += n;
+                continue;
+            }
+            for (int c = 0; c < srcK; c++) dst.stats[f][classMap[c]].merge(src.stats[f][c]);
+            continue;
+        }
+        for (int v = 0; v < (int)src.valueNames[f].size(); v++) {
+            size_t row = (size_t)valueCode(dst, f, src.valueNames[f][v]) * K;
+            for (int c = 0; c < srcK; c++)
+                dst.counts[f][row + classMap[c]] += src.counts[f][(size_t)v * srcK + c];
+        }
+    }
+    return true;
+}
+
+bool buildModel(const vector<string> &sources, NaiveBayesModel &m, bool (*numericTest)(const string &)) {
+    int n = sources.size();
+    if (n == 0) return false;
+    vector<NaiveBayesModel> parts(n);
+    vector<char> ok(n, 0);
+    vector<thread> threads;
+    for (int i = 0; i < n; i++)
+        threads.emplace_back([&, i] {
+            if (isModelFile(sources[i])) {
+                ok[i] = loadModel(parts[i], sources[i]);
+            } else {
+                ifstream in(sources[i]);
+                ok[i] = in.is_open() && trainNaiveBayes(in, parts[i], numericTest);
+            }
+        });
+    for (thread &th : threads) th.join();
+    for (int i = 0; i < n; i++)
+        if (!ok[i]) {
+            cout << "Error: Cannot read " << sources[i] << "\n";
+            return false;
+        }
+
+    for (int step = 1; step < n; step *= 2) {
+        threads.clear();
+        for (int i = 0; i + step < n; i += 2 * step)
+            threads.emplace_back([&, i, step] { ok[i] = mergeModel(parts[i], parts[i + step]); });
+        for (thread &th : threads) th.join();
+        for (int i = 0; i + step < n; i += 2 * step)
+            if (!ok[i]) {
+                cout << "Error: " << sources[i + step] << " does not have the same columns\n";
+                return false;
+            }
+    }
+    m = move(parts[0]);
+    return true;
+}
+
+int main() {
+    string sources;
+    cout << "Enter CSV file(s) or saved .nbm model(s), comma separated: ";
+    cin >> sources;
+
+    // Every source is read once (shards in parallel) and merged into one model
+    NaiveBayesModel model;
+    if (!buildModel(split(sources, ','), model, nullptr)) return 0;
+
+    string modelFile;
+    cout << "Save model as (.nbm file, or - to skip): ";
+    cin >> modelFile;
+    if (modelFile != "-") {
+        if (saveModel(model, modelFile)) cout << "Model saved to " << modelFile << "\n";
+        else cout << "Error: Cannot write " << modelFile << "\n";
+    }
+
+    const vector<string> &headers = model.headers;
+    int featureCount = model.featureCount;
 
     cout << "\n--- Dataset Loaded Successfully ---\n";
-    cout << "Total records: " << data.size() << endl;
+    cout << "Total records: " << model.total << endl;
     cout << "Features: " << featureCount << endl;
     cout << "Target (Class): " << headers.back() << "\n";
 
-    // Count class occurrences
-    map<string, int> classCount;
-    for (auto &r : data) classCount[r.back()]++;
-
-    int total = data.size();
+    vector<int> classes = sortedClasses(model);
+    long long total = model.total;
     cout << "\n=== PRIOR PROBABILITIES ===\n";
-    map<string, double> prior;
-    for (auto &c : classCount) {
-        prior[c.first] = (double)c.second / total;
-        cout << "P(" << c.first << ") = " << c.second << "/" << total
-             << " = " << fixed << setprecision(3) << prior[c.first] << endl;
+    vector<double> prior(model.numClasses());
+    for (int c : classes) {
+        prior[c] = (double)model.classCount[c] / total;
+        cout << "P(" << model.classNames[c] << ") = " << model.classCount[c] << "/" << total
+             << " = " << fixed << setprecision(3) << prior[c] << endl;
     }
 
-    // Calculate conditional probabilities P(feature=value | class)
+    // Conditional probabilities P(feature=value | class), read off the count table
     cout << "\n=== CONDITIONAL PROBABILITIES ===\n";
-    map<string, map<string, map<string, double>>> condProb;
-
     for (int i = 0; i < featureCount; i++) {
-        map<string, map<string, int>> freq;
-        for (auto &r : data) {
-            freq[r.back()][r[i]]++;
-        }
-
-        for (auto &cls : classCount) {
-            cout << "\nFor Class = " << cls.first
+        vector<int> values = sortedValues(model, i);
+        for (int c : classes) {
+            const string &cls = model.classNames[c];
+            cout << "\nFor Class = " << cls
                  << " (" << headers[i] << "):\n";
-            for (auto &pair : freq[cls.first]) {
-                condProb[headers[i]][cls.first][pair.first] =
-                    (double)pair.second / classCount[cls.first];
-                cout << "P(" << pair.first << " | " << cls.first << ") = "
-                     << pair.second << "/" << classCount[cls.first]
-                     << " = " << condProb[headers[i]][cls.first][pair.first] << endl;
+            for (int v : values) {
+                long long cnt = valueCount(model, i, v, c);
+                if (cnt == 0) continue;
+                cout << "P(" << model.valueNames[i][v] << " | " << cls << ") = "
+                     << cnt << "/" << model.classCount[c]
+                     << " = " << (double)cnt / model.classCount[c] << endl;
             }
         }
     }
 
     // Get test case input
     cout << "\n=== ENTER TEST CASE ===\n";
-    map<string, string> test;
+    vector<string> test(featureCount);
     for (int i = 0; i < featureCount; i++) {
         cout << headers[i] << ": ";
-        cin >> test[headers[i]];
+        cin >> test[i];
     }
 
     cout << "\n=== POSTERIOR PROBABILITIES ===\n";
-    map<string, double> posterior;
+    vector<double> posterior(model.numClasses());
 
-    for (auto &cls : classCount) {
-        double prob = prior[cls.first];
-        cout << "\nFor class = " << cls.first << ":\n";
-        cout << "Start with prior P(" << cls.first << ") = " << prob << endl;
+    for (int c : classes) {
+        const string &cls = model.classNames[c];
+        double prob = prior[c];
+        cout << "\nFor class = " << cls << ":\n";
+        cout << "Start with prior P(" << cls << ") = " << prob << endl;
 
         for (int i = 0; i < featureCount; i++) {
-            string feat = headers[i], val = test[feat];
-            double cond = condProb[feat][cls.first].count(val)
-                              ? condProb[feat][cls.first][val]
-                              : 0.0;
-            cout << "P(" << val << " | " << cls.first << ") = " << cond << endl;
+            int v = findValue(model, i, test[i]);
+            double cond = v >= 0 ? (double)valueCount(model, i, v, c) / model.classCount[c]
+                                 : 0.0;
+            cout << "P(" << test[i] << " | " << cls << ") = " << cond << endl;
             prob *= cond;
         }
 
-        posterior[cls.first] = prob;
-        cout << "Final P(" << cls.first << " | Case) = " << prob << endl;
+        posterior[c] = prob;
+        cout << "Final P(" << cls << " | Case) = " << prob << endl;
     }
 
     cout << "\n=== COMPARISON ===\n";
-    for (auto &p : posterior)
-        cout << "P(" << p.first << " | Case) = " << p.second << endl;
+    for (int c : classes)
+        cout << "P(" << model.classNames[c] << " | Case) = " << posterior[c] << endl;
 
-    string prediction = max_element(posterior.begin(), posterior.end(),
-                                    [](auto &a, auto &b) {
-                                        return a.second < b.second;
-                                    })
-                            ->first;
+    int best = classes.empty() ? -1 : classes[0];
+    for (int c : classes)
+        if (posterior[c] > posterior[best]) best = c;
 
-    cout << "\nPredicted Class = " << prediction << endl;
+    cout << "\nPredicted Class = " << (best >= 0 ? model.classNames[best] : "") << endl;
 
     return 0;
 }
@@ -152,8 +472,26 @@ int main() {
 //     - Splits a line of CSV data using the comma (`,`) delimiter.
 //     - Returns a vector of string tokens.
 //
+// ➤ trainNaiveBayes()
+//     - Streams the CSV once and fills a NaiveBayesModel: class counts plus one dense
+//       [value][class] count table per attribute (values and classes dictionary-encoded).
+//     - Helpers: classCode(), valueCode(), addRecord(), findValue(), valueCount().
+//
+// ➤ sortedClasses() / sortedValues()
+//     - Return codes in label order so the printed report stays alphabetical.
+//
+// ➤ saveModel() / loadModel()
+//     - Write / read the model's counts as a compact binary .nbm file, so later runs
+//       skip retraining.
+//
+// ➤ mergeModel() / buildModel()
+//     - mergeModel() adds one model's counts into another in O(size of the added model).
+//     - buildModel() reads each CSV shard or saved model on its own thread and merges
+//       the parts pairwise in parallel; a saved model plus a new CSV batch is the
+//       incremental update.
+//
 // ➤ main()
-//     - Reads dataset from CSV file.
+//     - Trains (or loads and updates) the model and optionally saves it.
 //     - Calculates prior probabilities P(Class).
 //     - Calculates conditional probabilities P(Attribute=value | Class).
 //     - Reads a test case (unseen data record).
@@ -262,11 +600,10 @@ int main() {
 //
 // filename          → Input dataset file.
 // headers[]         → Attribute names (first row of CSV).
-// data[][]          → All dataset rows (vector of vectors).
-// classCount{}      → Count of each target class (used for prior probabilities).
-// condProb{}        → Nested map for storing conditional probabilities P(Attribute=value | Class).
-// test{}            → Stores user input for test record.
-// posterior{}       → Stores computed posterior probabilities for each class.
+// model             → NaiveBayesModel: class counts and per-attribute [value][class] count tables.
+// prior[]           → Prior probability of each class code.
+// test[]            → Stores user input for test record.
+// posterior[]       → Stores computed posterior probabilities for each class.
 //
 // --------------------------------------------------------------------------------------------------
 // 🔸 6️⃣ WHY NAÏVE BAYES CLASSIFIER WAS USED (JUSTIFICATION)
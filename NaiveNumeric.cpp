@@ -20,112 +20,669 @@ vector<string> split(const string &s, char d) {
 }
 
 // ---------- Detect if feature is numeric ----------
+// Digits, '.' and '-' only, and the whole cell must parse ("-" or "1-2"
+// do not), so strtod never has to guess a value
 bool isNumeric(const string &s) {
     if (s.empty()) return false;
-    return all_of(s.begin(), s.end(), [](unsigned char c) {
+    if (!all_of(s.begin(), s.end(), [](unsigned char c) {
         return isdigit(c) || c == '.' || c == '-';
-    });
+    })) return false;
+    char *end = nullptr;
+    strtod(s.c_str(), &end);
+    return *end == '\0';
 }
 
-// ---------- Read CSV ----------
-vector<vector<string>> readCSV(const string &filename) {
-    ifstream file(filename);
-    vector<vector<string>> data;
+// ---------- Single-Pass Naive Bayes Trainer ----------
+// Every statistic the classifier needs is filled in one streaming pass over
+// the file, so no record is kept in memory. Class labels and categorical
+// values are dictionary-encoded to small integer codes the first time they
+// are seen, counts live in one dense [value][class] table per feature, and
+// numeric features keep a running (Welford) mean and sum of squared
+// deviations per class instead of re-reading the rows.
+// NaiveB.cpp and By-vaibhav-new/13.bayes/bayes.cpp carry copies of this code
+// down to buildModel(); change them together.
+struct RunningStats {
+    long long n = 0;
+    double mean = 0.0, m2 = 0.0;
+
+    void add(double x) {
+        n++;
+        double d = x - mean;
+        mean += d / n;
+        m2 += d * (x - mean);
+    }
+    double stddev() const { return n > 0 ? sqrt(m2 / n) : 0.0; }   // population
+
+    // Combines two partial summaries (pairwise update of Chan et al.)
+    void merge(const RunningStats &o) {
+        if (o.n == 0) return;
+        long long total = n + o.n;
+        double d = o.mean - mean;
+        mean += d * o.n / total;
+        m2 += o.m2 + d * d * ((double)n * o.n / total);
+        n = total;
+    }
+};
+
+struct NaiveBayesModel {
+    vector<string> headers;
+    int featureCount = 0;
+    vector<bool> isNum;                          // per feature
+    vector<string> classNames;                   // class code -> label
+    unordered_map<string, int> classIndex;
+    vector<long long> classCount;                // per class code
+    vector<vector<string>> valueNames;           // [feature][value code] -> value
+    vector<unordered_map<string, int>> valueIndex;
+    vector<vector<long long>> counts;            // [feature][value * numClasses + class]
+    vector<vector<RunningStats>> stats;          // [feature][class], numeric features
+    long long total = 0;
+    long long skippedCells = 0;                  // non-numeric cells of numeric features (not saved)
+
+    int numClasses() const { return classNames.size(); }
+};
+
+void initModel(NaiveBayesModel &m, const vector<string> &headers, const vector<bool> &isNum) {
+    m.headers = headers;
+    m.featureCount = headers.size() - 1;         // Last column = Class
+    m.isNum = isNum;
+    m.valueNames.assign(m.featureCount, {});
+    m.valueIndex.assign(m.featureCount, {});
+    m.counts.assign(m.featureCount, {});
+    m.stats.assign(m.featureCount, {});
+}
+
+int classCode(NaiveBayesModel &m, const string &label) {
+    auto it = m.classIndex.find(label);
+    if (it != m.classIndex.end()) return it->second;
+
+    // A new class widens every [value][class] row by one slot
+    int K = m.numClasses();
+    for (int f = 0; f < m.featureCount; f++) {
+        if (m.isNum[f]) {
+            m.stats[f].push_back(RunningStats());
+            continue;
+        }
+        int V = m.valueNames[f].size();
+        vector<long long> wider((size_t)V * (K + 1), 0);
+        for (int v = 0; v < V; v++)
+            copy(m.counts[f].begin() + (size_t)v * K, m.counts[f].begin() + (size_t)(v + 1) * K,
+                 wider.begin() + (size_t)v * (K + 1));
+        m.counts[f].swap(wider);
+    }
+    m.classNames.push_back(label);
+    m.classCount.push_back(0);
+    m.classIndex[label] = K;
+    return K;
+}
+
+int valueCode(NaiveBayesModel &m, int f, const string &value) {
+    auto it = m.valueIndex[f].find(value);
+    if (it != m.valueIndex[f].end()) return it->second;
+    int code = m.valueNames[f].size();
+    m.valueNames[f].push_back(value);
+    m.valueIndex[f][value] = code;
+    m.counts[f].resize(m.counts[f].size() + m.numClasses(), 0);
+    return code;
+}
+
+// Code of a value seen in training, or -1
+int findValue(const NaiveBayesModel &m, int f, const string &value) {
+    auto it = m.valueIndex[f].find(value);
+    return it == m.valueIndex[f].end() ? -1 : it->second;
+}
+
+long long valueCount(const NaiveBayesModel &m, int f, int value, int cls) {
+    return m.counts[f][(size_t)value * m.numClasses() + cls];
+}
+
+// Turns categorical feature f into a numeric one with empty statistics. Its
+// cells so far were all non-numeric, so they are counted as skipped.
+void makeNumeric(NaiveBayesModel &m, int f) {
+    for (long long n : m.counts[f]) m.skippedCells += n;
+    m.isNum[f] = true;
+    m.counts[f].clear();
+    m.valueNames[f].clear();
+    m.valueIndex[f].clear();
+    m.stats[f].assign(m.numClasses(), RunningStats());
+}
+
+// A feature is numeric once any of its cells passes numericTest (nullptr
+// keeps every feature categorical); other cells of a numeric feature, such
+// as "NA" or empty ones, are skipped and counted instead of read as 0.
+void addRecord(NaiveBayesModel &m, const vector<string> &row, bool (*numericTest)(const string &)) {
+    int c = classCode(m, row.back());
+    int K = m.numClasses();
+    m.classCount[c]++;
+    m.total++;
+    for (int f = 0; f < m.featureCount; f++) {
+        if (numericTest && numericTest(row[f])) {
+            if (!m.isNum[f]) makeNumeric(m, f);
+            m.stats[f][c].add(strtod(row[f].c_str(), nullptr));
+        } else if (m.isNum[f]) {
+            m.skippedCells++;
+        } else {
+            m.counts[f][(size_t)valueCode(m, f, row[f]) * K + c]++;
+        }
+    }
+}
+
+// Streams header + records from 'in'; rows with the wrong number of fields
+// are skipped. Column types are decided over the whole column (addRecord).
+bool trainNaiveBayes(istream &in, NaiveBayesModel &m, bool (*numericTest)(const string &)) {
     string line;
-    while (getline(file, line)) {
-        if (!line.empty()) data.push_back(split(line, ','));
+    if (!getline(in, line)) return false;
+    vector<string> headers = split(line, ',');
+    if (headers.size() < 2) return false;
+
+    initModel(m, headers, vector<bool>(headers.size() - 1, false));
+    while (getline(in, line)) {
+        vector<string> row = split(line, ',');
+        if (row.size() != headers.size()) continue;
+        addRecord(m, row, numericTest);
+    }
+    return true;
+}
+
+// Class codes ordered by label, and value codes ordered by value, so the
+// report reads the same as the sorted maps it replaced
+vector<int> sortedClasses(const NaiveBayesModel &m) {
+    vector<int> order(m.numClasses());
+    iota(order.begin(), order.end(), 0);
+    sort(order.begin(), order.end(),
+         [&](int a, int b) { return m.classNames[a] < m.classNames[b]; });
+    return order;
+}
+
+vector<int> sortedValues(const NaiveBayesModel &m, int f) {
+    vector<int> order(m.valueNames[f].size());
+    iota(order.begin(), order.end(), 0);
+    sort(order.begin(), order.end(),
+         [&](int a, int b) { return m.valueNames[f][a] < m.valueNames[f][b]; });
+    return order;
+}
+
+// ---------- Model Persistence and Merging ----------
+// The model is made only of sufficient statistics (counts and n/mean/M2), so
+// it can be saved, loaded back and merged with a model trained on other
+// records without revisiting them. The file is a compact native-endian dump:
+//   "NBM1", headers, numeric flags, class labels + counts, total records,
+//   then per feature either value labels + [value][class] counts or
+//   n/mean/M2 for every class.
+const char NB_MAGIC[4] = {'N', 'B', 'M', '1'};
+
+template <class T> void writePod(ostream &out, const T &x) { out.write((const char *)&x, sizeof(T)); }
+template <class T> bool readPod(istream &in, T &x) { return (bool)in.read((char *)&x, sizeof(T)); }
+
+void writeString(ostream &out, const string &s) {
+    writePod(out, (uint32_t)s.size());
+    out.write(s.data(), s.size());
+}
+
+// A count read from a model file is trusted only if that many items of at
+// least 'each' bytes fit in the file's 'size' bytes, so a damaged file fails
+// to load instead of making resize() ask for gigabytes
+bool readCount(istream &in, uint32_t &n, uint64_t size, uint64_t each) {
+    return readPod(in, n) && n <= size / each;
+}
+
+bool readString(istream &in, string &s, uint64_t size) {
+    uint32_t n;
+    if (!readCount(in, n, size, 1)) return false;
+    s.resize(n);
+    return (bool)in.read(&s[0], n);
+}
+
+bool saveModel(const NaiveBayesModel &m, const string &filename) {
+    ofstream out(filename, ios::binary);
+    if (!out.is_open()) return false;
+    out.write(NB_MAGIC, 4);
+    writePod(out, (uint32_t)m.headers.size());
+    for (auto &h : m.headers) writeString(out, h);
+    for (int f = 0; f < m.featureCount; f++) writePod(out, (uint8_t)m.isNum[f]);
+
+    int K = m.numClasses();
+    writePod(out, (uint32_t)K);
+    for (auto &c : m.classNames) writeString(out, c);
+    out.write((const char *)m.classCount.data(), K * sizeof(long long));
+    writePod(out, m.total);
+
+    for (int f = 0; f < m.featureCount; f++) {
+        if (m.isNum[f]) {
+            for (auto &s : m.stats[f]) {
+                writePod(out, s.n);
+                writePod(out, s.mean);
+                writePod(out, s.m2);
+            }
+        } else {
+            writePod(out, (uint32_t)m.valueNames[f].size());
+            for (auto &v : m.valueNames[f]) writeString(out, v);
+            out.write((const char *)m.counts[f].data(), m.counts[f].size() * sizeof(long long));
+        }
+    }
+    return (bool)out;
+}
+
+bool isModelFile(const string &filename) {
+    ifstream in(filename, ios::binary);
+    char magic[4];
+    return in.read(magic, 4) && equal(magic, magic + 4, NB_MAGIC);
+}
+
+bool loadModel(NaiveBayesModel &m, const string &filename) {
+    ifstream in(filename, ios::binary | ios::ate);
+    uint64_t size = max(0LL, (long long)in.tellg());
+    in.seekg(0);
+    char magic[4];
+    if (!in.read(magic, 4) || !equal(magic, magic + 4, NB_MAGIC)) return false;
+
+    uint32_t numHeaders;
+    if (!readCount(in, numHeaders, size, sizeof(uint32_t)) || numHeaders < 2) return false;
+    vector<string> headers(numHeaders);
+    for (auto &h : headers)
+        if (!readString(in, h, size)) return false;
+    vector<bool> isNum(numHeaders - 1);
+    for (size_t f = 0; f < isNum.size(); f++) {
+        uint8_t b;
+        if (!readPod(in, b)) return false;
+        isNum[f] = b;
+    }
+    initModel(m, headers, isNum);
+
+    uint32_t K;
+    if (!readCount(in, K, size, sizeof(long long))) return false;
+    m.classNames.resize(K);
+    for (uint32_t c = 0; c < K; c++) {
+        if (!readString(in, m.classNames[c], size)) return false;
+        m.classIndex[m.classNames[c]] = c;
+    }
+    m.classCount.resize(K);
+    if (!in.read((char *)m.classCount.data(), K * sizeof(long long)) || !readPod(in, m.total)) return false;
+
+    for (int f = 0; f < m.featureCount; f++) {
+        if (m.isNum[f]) {
+            m.stats[f].resize(K);
+            for (auto &s : m.stats[f])
+                if (!readPod(in, s.n) || !readPod(in, s.mean) || !readPod(in, s.m2)) return false;
+        } else {
+            uint32_t V;
+            if (!readCount(in, V, size, sizeof(uint32_t)) || (uint64_t)V * K > size / sizeof(long long)) return false;
+            m.valueNames[f].resize(V);
+            m.valueIndex[f].reserve(V);
+            for (uint32_t v = 0; v < V; v++) {
+                if (!readString(in, m.valueNames[f][v], size)) return false;
+                m.valueIndex[f][m.valueNames[f][v]] = v;
+            }
+            m.counts[f].resize((size_t)V * K);
+            if (!in.read((char *)m.counts[f].data(), m.counts[f].size() * sizeof(long long))) return false;
+        }
+    }
+    return true;
+}
+
+// Adds the statistics of 'src' into 'dst' in O(size of src). Classes and
+// values are matched by label; numeric moments combine with the pairwise
+// (Chan et al.) update. A feature numeric in only one model is numeric in
+// the result (the other model saw no number in it, so its cells are
+// skipped). Fails when the two models have different columns.
+bool mergeModel(NaiveBayesModel &dst, const NaiveBayesModel &src) {
+    if (src.headers.empty()) return true;
+    if (dst.headers.empty()) {
+        dst = src;
+        return true;
+    }
+    if (dst.headers != src.headers) return false;
+
+    int srcK = src.numClasses();
+    vector<int> classMap(srcK);
+    for (int c = 0; c < srcK; c++) classMap[c] = classCode(dst, src.classNames[c]);
+    int K = dst.numClasses();
+
+    for (int c = 0; c < srcK; c++) dst.classCount[classMap[c]] += src.classCount[c];
+    dst.total += src.total;
+    dst.skippedCells += src.skippedCells;
+
+    for (int f = 0; f < dst.featureCount; f++) {
+        if (src.isNum[f] && !dst.isNum[f]) makeNumeric(dst, f);
+        if (dst.isNum[f]) {
+            if (!src.isNum[f]) {
+                for (long long n : src.counts[f]) dst.skippedCells += n;
+                continue;
+            }
+            for (int c = 0; c < srcK; c++) dst.stats[f][classMap[c]].merge(src.stats[f][c]);
+            continue;
+        }
+        for (int v = 0; v < (int)src.valueNames[f].size(); v++) {
+            size_t row = (size_t)valueCode(dst, f, src.valueNames[f][v]) * K;
+            for (int c = 0; c < srcK; c++)
+                dst.counts[f][row + classMap[c]] += src.counts[f][(size_t)v * srcK + c];
+        }
+    }
+    return true;
+}
+
+// Builds one model from several sources, each a CSV file or a saved model.
+// Every source is read on its own thread, then the partial models are merged
+// pairwise level by level, with the merges of a level also run in parallel.
+bool buildModel(const vector<string> &sources, NaiveBayesModel &m, bool (*numericTest)(const string &)) {
+    int n = sources.size();
+    if (n == 0) return false;
+    vector<NaiveBayesModel> parts(n);
+    vector<char> ok(n, 0);
+    vector<thread> threads;
+    for (int i = 0; i < n; i++)
+        threads.emplace_back([&, i] {
+            if (isModelFile(sources[i])) {
+                ok[i] = loadModel(parts[i], sources[i]);
+            } else {
+                ifstream in(sources[i]);
+                ok[i] = in.is_open() && trainNaiveBayes(in, parts[i], numericTest);
+            }
+        });
+    for (thread &th : threads) th.join();
+    for (int i = 0; i < n; i++)
+        if (!ok[i]) {
+            cout << "Error: Cannot read " << sources[i] << "\n";
+            return false;
+        }
+
+    for (int step = 1; step < n; step *= 2) {
+        threads.clear();
+        for (int i = 0; i + step < n; i += 2 * step)
+            threads.emplace_back([&, i, step] { ok[i] = mergeModel(parts[i], parts[i + step]); });
+        for (thread &th : threads) th.join();
+        for (int i = 0; i + step < n; i += 2 * step)
+            if (!ok[i]) {
+                cout << "Error: " << sources[i + step] << " does not have the same columns\n";
+                return false;
+            }
+    }
+    m = move(parts[0]);
+    return true;
+}
+
+// ---------- Log-Space Batch Scoring ----------
+// A compiled, read-only view of the model for scoring many records at once.
+// Everything is kept as logarithms so wide records cannot underflow:
+//   categorical → log P(value | class) looked up from a [value][class] table
+//                 (Laplace-smoothed; the extra last row is the unseen value)
+//   numeric     → log N(x; mean, sd) = C + A * (x - B)^2 per class
+// Classes are stored in label order, so ties go to the first label.
+// By-girl-new/naive_bayes.cpp (down to scoreMany) and ModelServer.cpp (down to
+// scoreBlock) carry copies of this code.
+struct LogScoreTable {
+    int numClasses = 0;
+    vector<string> labels;                       // table class index -> label
+    vector<double> logPrior;                     // [class]
+    vector<bool> isNum;                          // per feature
+    vector<vector<double>> logCond;              // categorical: [(value) * numClasses + class]
+    vector<vector<double>> gaussA, gaussB, gaussC; // numeric: [feature][class]
+};
+
+// Test records encoded column by column: categorical values as codes
+// (numValues = unseen), numeric values as doubles (NaN = missing, skipped)
+struct ScoreBatch {
+    int numRows = 0;
+    vector<vector<int>> codes;
+    vector<vector<double>> values;
+};
+
+void gaussianLogTerms(double mean, double sd, double &a, double &b, double &c) {
+    if (sd == 0) {                               // same 1e-9 floor as the PDF
+        a = 0.0; b = mean; c = log(1e-9);
+        return;
     }
-    return data;
+    a = -1.0 / (2 * sd * sd);
+    b = mean;
+    c = -log(sqrt(2 * M_PI) * sd);
+}
+
+// Scores rows [begin, end) into 'scores' (class-major, numClasses x rows) and
+// writes the arg-max class of each row. The inner loops run over contiguous
+// rows with no branches so the compiler can vectorize them.
+void scoreBlock(const LogScoreTable &t, const ScoreBatch &b, int begin, int end, double *scores, int *out) {
+    int n = end - begin, K = t.numClasses;
+    for (int k = 0; k < K; k++)
+        fill(scores + (size_t)k * n, scores + (size_t)(k + 1) * n, t.logPrior[k]);
+
+    for (int f = 0; f < (int)t.isNum.size(); f++) {
+        if (t.isNum[f]) {
+            const double *x = b.values[f].data() + begin;
+            for (int k = 0; k < K; k++) {
+                double A = t.gaussA[f][k], B = t.gaussB[f][k], C = t.gaussC[f][k];
+                double *s = scores + (size_t)k * n;
+                for (int i = 0; i < n; i++) {
+                    double d = x[i] - B;
+                    double v = C + A * d * d;
+                    s[i] += v == v ? v : 0.0;
+                }
+            }
+        } else {
+            const int *code = b.codes[f].data() + begin;
+            const double *table = t.logCond[f].data();
+            for (int k = 0; k < K; k++) {
+                double *s = scores + (size_t)k * n;
+                for (int i = 0; i < n; i++) s[i] += table[code[i] * K + k];
+            }
+        }
+    }
+
+    for (int i = 0; i < n; i++) {
+        int best = 0;
+        for (int k = 1; k < K; k++)
+            if (scores[(size_t)k * n + i] > scores[(size_t)best * n + i]) best = k;
+        out[begin + i] = best;
+    }
+}
+
+// Splits the batch into fixed row blocks and lets every hardware thread pull
+// blocks from a shared counter until none are left
+const int SCORE_BLOCK_ROWS = 4096;
+
+void scoreMany(const LogScoreTable &t, const ScoreBatch &b, vector<int> &out) {
+    out.assign(b.numRows, 0);
+    if (t.numClasses == 0) return;
+    int numBlocks = (b.numRows + SCORE_BLOCK_ROWS - 1) / SCORE_BLOCK_ROWS;
+    atomic<int> next(0);
+    auto worker = [&] {
+        vector<double> scores((size_t)t.numClasses * SCORE_BLOCK_ROWS);
+        for (int blk = next++; blk < numBlocks; blk = next++) {
+            int begin = blk * SCORE_BLOCK_ROWS;
+            scoreBlock(t, b, begin, min(b.numRows, begin + SCORE_BLOCK_ROWS), scores.data(), out.data());
+        }
+    };
+    int numThreads = max(1, min((int)thread::hardware_concurrency(), numBlocks));
+    vector<thread> threads;
+    for (int i = 1; i < numThreads; i++) threads.emplace_back(worker);
+    worker();
+    for (thread &th : threads) th.join();
+}
+
+LogScoreTable compileScoreTable(const NaiveBayesModel &m) {
+    LogScoreTable t;
+    vector<int> classes = sortedClasses(m);
+    int K = classes.size();
+    t.numClasses = K;
+    t.isNum = m.isNum;
+    t.logCond.resize(m.featureCount);
+    t.gaussA.resize(m.featureCount);
+    t.gaussB.resize(m.featureCount);
+    t.gaussC.resize(m.featureCount);
+    for (int k = 0; k < K; k++) {
+        t.labels.push_back(m.classNames[classes[k]]);
+        t.logPrior.push_back(log((double)m.classCount[classes[k]] / m.total));
+    }
+    for (int f = 0; f < m.featureCount; f++) {
+        if (m.isNum[f]) {
+            t.gaussA[f].resize(K);
+            t.gaussB[f].resize(K);
+            t.gaussC[f].resize(K);
+            for (int k = 0; k < K; k++) {
+                const RunningStats &s = m.stats[f][classes[k]];
+                gaussianLogTerms(s.mean, s.stddev(), t.gaussA[f][k], t.gaussB[f][k], t.gaussC[f][k]);
+            }
+        } else {
+            int V = m.valueNames[f].size();
+            t.logCond[f].resize((size_t)(V + 1) * K);
+            for (int k = 0; k < K; k++) {
+                double denom = m.classCount[classes[k]] + V;      // Laplace smoothing
+                for (int v = 0; v < V; v++)
+                    t.logCond[f][(size_t)v * K + k] = log((valueCount(m, f, v, classes[k]) + 1.0) / denom);
+                t.logCond[f][(size_t)V * K + k] = log(1.0 / denom);
+            }
+        }
+    }
+    return t;
+}
+
+ScoreBatch encodeScoreBatch(const NaiveBayesModel &m, const vector<vector<string>> &records) {
+    ScoreBatch b;
+    b.numRows = records.size();
+    b.codes.resize(m.featureCount);
+    b.values.resize(m.featureCount);
+    for (int f = 0; f < m.featureCount; f++) {
+        if (m.isNum[f]) {
+            b.values[f].resize(b.numRows);
+            for (int r = 0; r < b.numRows; r++) {
+                const vector<string> &rec = records[r];
+                b.values[f][r] = f < (int)rec.size() && isNumeric(rec[f]) ? strtod(rec[f].c_str(), nullptr) : NAN;
+            }
+        } else {
+            int unseen = m.valueNames[f].size();
+            b.codes[f].resize(b.numRows);
+            for (int r = 0; r < b.numRows; r++) {
+                const vector<string> &rec = records[r];
+                int v = f < (int)rec.size() ? findValue(m, f, rec[f]) : -1;
+                b.codes[f][r] = v < 0 ? unseen : v;
+            }
+        }
+    }
+    return b;
 }
 
 // ---------- Main ----------
 int main() {
-    string filename;
-    cout << "Enter CSV filename: ";
-    cin >> filename;
+    string sources;
+    cout << "Enter CSV file(s) or saved .nbm model(s), comma separated: ";
+    cin >> sources;
 
-    vector<vector<string>> data = readCSV(filename);
-    if (data.empty()) {
+    // One pass over each source: counts for categorical columns, running
+    // mean/variance for numeric ones; shards and saved models are merged
+    NaiveBayesModel model;
+    if (!buildModel(split(sources, ','), model, isNumeric)) return 0;
+    if (model.total == 0) {
         cout << "Error: File empty or invalid!\n";
         return 0;
     }
+    if (model.skippedCells > 0)
+        cout << "Skipped " << model.skippedCells << " non-numeric cell(s) in numeric columns.\n";
 
-    vector<string> headers = data[0];
-    int featureCount = headers.size() - 1;
-    cout << "\n--- Dataset Loaded ---\n";
-    cout << "Records: " << data.size() - 1 << "\nFeatures: " << featureCount
-         << "\nTarget: " << headers.back() << "\n";
-
-    // ---------- Determine which columns are numeric ----------
-    vector<bool> isNum(featureCount, false);
-    for (int j = 0; j < featureCount; j++) {
-        for (int i = 1; i < data.size(); i++) {
-            if (isNumeric(data[i][j])) {
-                isNum[j] = true;
-                break;
-            }
-        }
+    string modelFile;
+    cout << "Save model as (.nbm file, or - to skip): ";
+    cin >> modelFile;
+    if (modelFile != "-") {
+        if (saveModel(model, modelFile)) cout << "Model saved to " << modelFile << "\n";
+        else cout << "Error: Cannot write " << modelFile << "\n";
     }
 
-    // ---------- Split data by class ----------
-    map<string, vector<vector<string>>> classData;
-    for (int i = 1; i < data.size(); i++)
-        classData[data[i].back()].push_back(data[i]);
+    const vector<string> &headers = model.headers;
+    int featureCount = model.featureCount;
+    const vector<bool> &isNum = model.isNum;
+    cout << "\n--- Dataset Loaded ---\n";
+    cout << "Records: " << model.total << "\nFeatures: " << featureCount
+         << "\nTarget: " << headers.back() << "\n";
 
-    int total = data.size() - 1;
+    vector<int> classes = sortedClasses(model);
+    long long total = model.total;
 
     // ---------- Step 1: Priors ----------
     cout << "\n=== PRIOR PROBABILITIES ===\n";
-    map<string, double> priors;
-    for (auto &cls : classData) {
-        priors[cls.first] = (double)cls.second.size() / total;
-        cout << "P(" << cls.first << ") = " << cls.second.size()
-             << "/" << total << " = " << priors[cls.first] << endl;
+    vector<double> priors(model.numClasses());
+    for (int c : classes) {
+        priors[c] = (double)model.classCount[c] / total;
+        cout << "P(" << model.classNames[c] << ") = " << model.classCount[c]
+             << "/" << total << " = " << priors[c] << endl;
     }
 
-    // ---------- Step 2: Compute Class Statistics ----------
+    // ---------- Step 2: Class Statistics ----------
     cout << "\n=== CLASS STATISTICS ===\n";
-    map<string, vector<double>> meanVals, sdVals;
-    map<string, map<string, map<string, double>>> catProb;
-
-    for (auto &cls : classData) {
-        cout << "\nClass: " << cls.first << endl;
+    vector<vector<int>> values(featureCount);
+    for (int j = 0; j < featureCount; j++)
+        if (!isNum[j]) values[j] = sortedValues(model, j);
 
-        // Numeric stats
-        vector<double> mean(featureCount, 0.0), sd(featureCount, 0.0);
-        int n = cls.second.size();
+    for (int c : classes) {
+        cout << "\nClass: " << model.classNames[c] << endl;
+        long long n = model.classCount[c];
 
         for (int j = 0; j < featureCount; j++) {
             if (isNum[j]) {
-                // compute mean
-                for (auto &row : cls.second) mean[j] += stod(row[j]);
-                mean[j] /= n;
-
-                // compute std dev
-                for (auto &row : cls.second)
-                    sd[j] += pow(stod(row[j]) - mean[j], 2);
-                sd[j] = sqrt(sd[j] / n);
-
-                cout << headers[j] << " -> Mean=" << mean[j]
-                     << ", StdDev=" << sd[j] << endl;
+                const RunningStats &s = model.stats[j][c];
+                cout << headers[j] << " -> Mean=" << s.mean
+                     << ", StdDev=" << s.stddev() << endl;
             } else {
-                // categorical
-                map<string, int> freq;
-                for (auto &row : cls.second)
-                    freq[row[j]]++;
-                for (auto &f : freq)
-                    catProb[headers[j]][cls.first][f.first] =
-                        (double)f.second / n;
-
                 cout << headers[j] << " (Categorical): ";
-                for (auto &f : freq)
-                    cout << f.first << "="
-                         << catProb[headers[j]][cls.first][f.first] << " ";
+                for (int v : values[j]) {
+                    long long cnt = valueCount(model, j, v, c);
+                    if (cnt > 0)
+                        cout << model.valueNames[j][v] << "=" << (double)cnt / n << " ";
+                }
                 cout << endl;
             }
         }
-        meanVals[cls.first] = mean;
-        sdVals[cls.first] = sd;
+    }
+
+    // ---------- Batch Scoring ----------
+    int choice = 1;
+    cout << "\nPredict (1) one test case or (2) all records of a CSV file: ";
+    cin >> choice;
+
+    if (choice == 2) {
+        string testFile, outFile;
+        cout << "Enter test CSV filename: ";
+        cin >> testFile;
+        cout << "Enter output CSV filename: ";
+        cin >> outFile;
+
+        ifstream in(testFile);
+        string line;
+        if (!getline(in, line)) {
+            cout << "Error: Empty or invalid test file.\n";
+            return 0;
+        }
+        vector<string> testHeaders = split(line, ',');
+        vector<vector<string>> records;
+        while (getline(in, line))
+            if (!line.empty()) records.push_back(split(line, ','));
+        in.close();
+
+        LogScoreTable table = compileScoreTable(model);
+        ScoreBatch batch = encodeScoreBatch(model, records);
+
+        auto t0 = chrono::steady_clock::now();
+        vector<int> predicted;
+        scoreMany(table, batch, predicted);
+        double secs = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+
+        // Accuracy is reported when the test file still has the class column
+        int labelled = 0, correct = 0;
+        ofstream out(outFile);
+        for (auto &h : testHeaders) out << h << ",";
+        out << "Predicted_" << headers.back() << "\n";
+        for (int r = 0; r < batch.numRows; r++) {
+            for (auto &v : records[r]) out << v << ",";
+            const string &label = table.labels[predicted[r]];
+            out << label << "\n";
+            if (records[r].size() == headers.size()) {
+                labelled++;
+                if (records[r].back() == label) correct++;
+            }
+        }
+
+        cout << "\nScored " << batch.numRows << " records in " << secs << " s";
+        if (secs > 0) cout << " (" << (long long)(batch.numRows / secs) << " records/s)";
+        cout << "\nPredictions written to " << outFile << endl;
+        if (labelled > 0)
+            cout << "Accuracy = " << 100.0 * correct / labelled << "% (" << correct << "/" << labelled << ")" << endl;
+        return 0;
     }
 
     // ---------- Step 3: Get Test Input ----------
@@ -138,44 +695,47 @@ int main() {
 
     // ---------- Step 4: Calculate Posterior ----------
     cout << "\n=== POSTERIOR PROBABILITIES ===\n";
-    map<string, double> post;
+    vector<double> post(model.numClasses());
 
-    for (auto &cls : classData) {
-        double prob = priors[cls.first];
-        cout << "\nClass = " << cls.first << ":\n";
+    for (int c : classes) {
+        const string &cls = model.classNames[c];
+        double prob = priors[c];
+        cout << "\nClass = " << cls << ":\n";
 
         for (int j = 0; j < featureCount; j++) {
             if (isNum[j]) {
-                double val = stod(test[j]);
-                double g = gaussianPDF(val, meanVals[cls.first][j], sdVals[cls.first][j]);
-                cout << "  P(" << headers[j] << "=" << val << " | " << cls.first << ") = " << g << endl;
+                if (!isNumeric(test[j])) continue;      // missing value: feature left out
+                double val = strtod(test[j].c_str(), nullptr);
+                const RunningStats &s = model.stats[j][c];
+                double g = gaussianPDF(val, s.mean, s.stddev());
+                cout << "  P(" << headers[j] << "=" << val << " | " << cls << ") = " << g << endl;
                 prob *= g;
             } else {
-                double cond = catProb[headers[j]][cls.first].count(test[j]) ?
-                              catProb[headers[j]][cls.first][test[j]] : 1e-6;
-                cout << "  P(" << headers[j] << "=" << test[j] << " | " << cls.first << ") = " << cond << endl;
+                int v = findValue(model, j, test[j]);
+                long long cnt = v >= 0 ? valueCount(model, j, v, c) : 0;
+                double cond = cnt > 0 ? (double)cnt / model.classCount[c] : 1e-6;
+                cout << "  P(" << headers[j] << "=" << test[j] << " | " << cls << ") = " << cond << endl;
                 prob *= cond;
             }
         }
-        post[cls.first] = prob;
+        post[c] = prob;
         cout << "  => Combined Probability = " << prob << endl;
     }
 
     // ---------- Step 5: Choose Best Class ----------
-    string bestClass = max_element(post.begin(), post.end(),
-                                   [](auto &a, auto &b) { return a.second < b.second; })
-                           ->first;
+    int best = classes[0];
+    for (int c : classes)
+        if (post[c] > post[best]) best = c;
 
     cout << "\n=== FINAL RESULTS ===\n";
-    for (auto &p : post)
-        cout << "P(" << p.first << " | Test) = " << p.second << endl;
+    for (int c : classes)
+        cout << "P(" << model.classNames[c] << " | Test) = " << post[c] << endl;
 
-    cout << "\nPredicted Class = " << bestClass << endl;
+    cout << "\nPredicted Class = " << model.classNames[best] << endl;
     return 0;
 }
 
 
-
 // ==================================================================================================
 // 🔹 DETAILED EXPLANATION OF GAUSSIAN NAÏVE BAYES CLASSIFIER (FOR MIXED NUMERIC & CATEGORICAL DATA)
 // ==================================================================================================
@@ -206,17 +766,42 @@ int main() {
 // ➤ isNumeric()
 //     - Determines whether a string value is numeric (used to identify numeric columns).
 //
-// ➤ readCSV()
-//     - Reads the dataset file (CSV format) and stores all rows as string vectors.
+// ➤ trainNaiveBayes()
+//     - Streams the CSV once; a column is numeric if any of its cells is a number, and
+//       non-numeric cells of a numeric column (e.g. "NA") are skipped and counted.
+//     - Categorical values and classes are dictionary-encoded into dense [value][class] counts.
+//     - Numeric features keep a per-class RunningStats (Welford mean and M2), so the
+//       mean and standard deviation need no second pass over the data.
+//
+// ➤ sortedClasses() / sortedValues()
+//     - Return codes in label order so the report prints in alphabetical order.
+//
+// ➤ saveModel() / loadModel()
+//     - Persist the sufficient statistics (class counts, [value][class] counts and
+//       per-class n/mean/M2) as a compact binary .nbm file that loads without retraining.
+//
+// ➤ mergeModel() / buildModel()
+//     - mergeModel() folds one model into another in O(size of the added model); numeric
+//       moments use the pairwise mean/M2 update, so merged results equal one full pass.
+//     - buildModel() reads CSV shards / saved models on separate threads and merges them
+//       pairwise in parallel. A saved model plus a new CSV batch is an incremental update.
+//
+// ➤ compileScoreTable() / encodeScoreBatch()
+//     - Turn the model into log-space tables (log prior, Laplace-smoothed log P(value | class),
+//       Gaussian log-pdf coefficients) and a test CSV into per-column codes/values.
+//
+// ➤ scoreBlock() / scoreMany()
+//     - Batch mode: sum log-probabilities for a block of rows and all classes with
+//       branch-free, vectorizable loops; blocks are shared out over all hardware threads.
 //
 // ➤ main()
 //     - Controls the workflow:
-//         1️⃣ Loads dataset
-//         2️⃣ Identifies numeric/categorical columns
+//         1️⃣ Trains the model in one pass over the dataset (or loads / merges saved models)
+//         2️⃣ Identifies numeric/categorical columns (numeric if any cell is a number)
 //         3️⃣ Computes prior probabilities P(Class)
 //         4️⃣ Computes feature statistics (mean, standard deviation) for numeric features
 //         5️⃣ Computes frequency-based probabilities for categorical features
-//         6️⃣ Accepts a test record from the user
+//         6️⃣ Accepts a test record from the user, or scores a whole test CSV in log space
 //         7️⃣ Calculates posterior probabilities using Bayes’ theorem
 //         8️⃣ Predicts the class with the highest posterior probability
 //
@@ -296,15 +881,14 @@ int main() {
 // 🔸 3️⃣ INTERNAL VARIABLES USED
 // --------------------------------------------------------------------------------------------------
 //
-// data[][]           → Complete dataset read from CSV file.
+// model              → NaiveBayesModel filled by the single training pass.
 // headers[]          → Column names (first row of the dataset).
 // featureCount       → Number of features (excluding class column).
 // isNum[]            → Boolean vector indicating which columns are numeric.
-// classData{}        → Map storing rows grouped by class label.
-// priors{}           → Prior probabilities of each class P(Class).
-// meanVals{}, sdVals{} → Numeric mean and standard deviation per class and feature.
-// catProb{}          → Conditional probabilities for categorical features.
-// post{}             → Final posterior probabilities for each class.
+// priors[]           → Prior probabilities of each class code P(Class).
+// model.stats[][]    → Running mean / M2 per numeric feature and class.
+// model.counts[]     → [value][class] counts per categorical feature.
+// post[]             → Final posterior probabilities for each class.
 // test[]             → User-provided test record values.
 //
 // --------------------------------------------------------------------------------------------------
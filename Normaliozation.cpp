@@ -60,87 +60,227 @@ void readCSV(const string &filename, vector<string> &header, vector<vector<doubl
     file.close();
 }
 
-// Compute min, max, mean, and standard deviation
-void calcStats(const vector<vector<double>> &data,
-               vector<double> &minVal, vector<double> &maxVal,
-               vector<double> &meanVal, vector<double> &stdVal) {
-    int rows = data.size();
-    int cols = data[0].size();
+// ---------- Column Statistics Kernel ----------
+// Min, max, sum, mean, M2 (sum of squared deviations, Welford) and max-abs
+// of every column, gathered in a single pass over the rows. The per-row
+// update runs across the columns of one row with no branches, so the
+// compiler can vectorize it. Large inputs are cut into one contiguous block
+// of rows per thread; every thread fills its own partial and the partials
+// are merged in block order with the pairwise (Chan et al.) update.
+// By-girl-new/normal.cpp carries a copy of ColumnStats and computeColumnStats.
+struct ColumnStats {
+    long long n = 0;
+    vector<double> minVal, maxVal, sum, mean, m2, maxAbs;
 
-    minVal.assign(cols, numeric_limits<double>::max());
-    maxVal.assign(cols, numeric_limits<double>::lowest());
-    meanVal.assign(cols, 0.0);
-    stdVal.assign(cols, 0.0);
+    void init(int cols) {
+        n = 0;
+        minVal.assign(cols, numeric_limits<double>::max());
+        maxVal.assign(cols, numeric_limits<double>::lowest());
+        sum.assign(cols, 0.0);
+        mean.assign(cols, 0.0);
+        m2.assign(cols, 0.0);
+        maxAbs.assign(cols, 0.0);
+    }
 
-    for (int j = 0; j < cols; j++) {
-        for (int i = 0; i < rows; i++) {
-            minVal[j] = min(minVal[j], data[i][j]);
-            maxVal[j] = max(maxVal[j], data[i][j]);
-            meanVal[j] += data[i][j];
+    void addRow(const double *x) {
+        n++;
+        double inv = 1.0 / n;
+        int cols = mean.size();
+        for (int j = 0; j < cols; j++) {
+            double v = x[j], a = fabs(v);
+            minVal[j] = v < minVal[j] ? v : minVal[j];
+            maxVal[j] = v > maxVal[j] ? v : maxVal[j];
+            maxAbs[j] = a > maxAbs[j] ? a : maxAbs[j];
+            sum[j] += v;
+            double d = v - mean[j];
+            mean[j] += d * inv;
+            m2[j] += d * (v - mean[j]);
         }
-        meanVal[j] /= rows;
     }
 
-    for (int j = 0; j < cols; j++) {
-        double sumSq = 0;
-        for (int i = 0; i < rows; i++)
-            sumSq += pow(data[i][j] - meanVal[j], 2);
-        stdVal[j] = sqrt(sumSq / rows);
+    void merge(const ColumnStats &o) {
+        if (o.n == 0) return;
+        if (n == 0) {
+            *this = o;
+            return;
+        }
+        long long total = n + o.n;
+        for (int j = 0; j < (int)mean.size(); j++) {
+            minVal[j] = min(minVal[j], o.minVal[j]);
+            maxVal[j] = max(maxVal[j], o.maxVal[j]);
+            maxAbs[j] = max(maxAbs[j], o.maxAbs[j]);
+            sum[j] += o.sum[j];
+            double d = o.mean[j] - mean[j];
+            mean[j] += d * o.n / total;
+            m2[j] += o.m2[j] + d * d * ((double)n * o.n / total);
+        }
+        n = total;
+    }
+
+    double stddev(int j) const { return n > 0 ? sqrt(m2[j] / n) : 0.0; }   // population
+};
+
+const size_t STATS_PARALLEL_ROWS = 100000;
+
+// rowAt(i) returns a pointer to the 'cols' values of row i
+template <class RowAt>
+ColumnStats computeColumnStats(size_t rows, int cols, RowAt rowAt) {
+    int threads = rows < STATS_PARALLEL_ROWS ? 1 : max(1, (int)thread::hardware_concurrency());
+    vector<ColumnStats> part(threads);
+    vector<thread> workers;
+    for (int t = 0; t < threads; t++) {
+        auto work = [&, t] {
+            part[t].init(cols);
+            size_t begin = rows * t / threads, end = rows * (t + 1) / threads;
+            for (size_t i = begin; i < end; i++) part[t].addRow(rowAt(i));
+        };
+        if (t + 1 < threads) workers.emplace_back(work);
+        else work();
     }
+    for (thread &w : workers) w.join();
+    for (int t = 1; t < threads; t++) part[0].merge(part[t]);
+    return part[0];
 }
 
-// Min-Max normalization
-vector<vector<double>> minMaxNorm(const vector<vector<double>> &data,
-                                  const vector<double> &minVal,
-                                  const vector<double> &maxVal,
-                                  double newMin, double newMax) {
-    int rows = data.size();
-    int cols = data[0].size();
-    vector<vector<double>> norm(rows, vector<double>(cols));
+// Statistics of every column in one pass (see computeColumnStats)
+ColumnStats calcStats(const vector<vector<double>> &data) {
+    return computeColumnStats(data.size(), data[0].size(),
+                              [&](size_t i) { return data[i].data(); });
+}
 
-    for (int i = 0; i < rows; i++) {
-        for (int j = 0; j < cols; j++) {
-            norm[i][j] = ((data[i][j] - minVal[j]) / (maxVal[j] - minVal[j])) 
-                         * (newMax - newMin) + newMin;
-        }
+// ---------- Normalization Parameters ----------
+// Everything a method needs to scale a column, fitted once from the column
+// statistics. The same parameters drive the in-memory methods below and the
+// streaming transform of new files, so both give the same numbers.
+struct NormParams {
+    vector<string> header;
+    vector<double> minVal, maxVal, mean, stdDev;
+    vector<int> exponent;                    // decimal scaling: divide by 10^k
+    vector<double> scale;                    // 10^k, derived from exponent
+    double newMin = 0, newMax = 1;
+    bool minMax = false, zScore = false, decScale = false;
+
+    int cols() const { return mean.size(); }
+    double minMaxValue(int j, double x) const {
+        return ((x - minVal[j]) / (maxVal[j] - minVal[j])) * (newMax - newMin) + newMin;
     }
-    return norm;
+    double zScoreValue(int j, double x) const { return stdDev[j] != 0 ? (x - mean[j]) / stdDev[j] : 0; }
+    double decScaleValue(int j, double x) const { return x / scale[j]; }
+
+    void setScale() {
+        scale.resize(exponent.size());
+        for (size_t j = 0; j < exponent.size(); j++) scale[j] = pow(10, exponent[j]);
+    }
+};
+
+NormParams fitParams(const vector<string> &header, const ColumnStats &stats) {
+    NormParams p;
+    p.header = header;
+    p.minVal = stats.minVal;
+    p.maxVal = stats.maxVal;
+    p.mean = stats.mean;
+    int cols = stats.mean.size();
+    p.stdDev.resize(cols);
+    p.exponent.resize(cols);
+    for (int j = 0; j < cols; j++) {
+        p.stdDev[j] = stats.stddev(j);
+        // max |x| comes from the statistics pass, so only the exponent is left
+        double maxAbs = stats.maxAbs[j];
+        p.exponent[j] = (maxAbs == 0) ? 1 : ceil(log10(maxAbs + 1));
+    }
+    p.setScale();
+    return p;
 }
 
-// Z-Score normalization
-vector<vector<double>> zScoreNorm(const vector<vector<double>> &data,
-                                  const vector<double> &meanVal,
-                                  const vector<double> &stdVal) {
+// Applies one method ('m', 'z' or 'd') to every value of the data
+vector<vector<double>> normalize(const vector<vector<double>> &data, const NormParams &p, char method) {
     int rows = data.size();
     int cols = data[0].size();
     vector<vector<double>> norm(rows, vector<double>(cols));
-
     for (int i = 0; i < rows; i++) {
         for (int j = 0; j < cols; j++) {
-            if (stdVal[j] != 0)
-                norm[i][j] = (data[i][j] - meanVal[j]) / stdVal[j];
-            else
-                norm[i][j] = 0;
+            double x = data[i][j];
+            norm[i][j] = method == 'm' ? p.minMaxValue(j, x) : method == 'z' ? p.zScoreValue(j, x) : p.decScaleValue(j, x);
         }
     }
     return norm;
 }
 
-// Decimal scaling normalization
-vector<vector<double>> decScaleNorm(const vector<vector<double>> &data) {
-    int rows = data.size();
-    int cols = data[0].size();
-    vector<vector<double>> norm(rows, vector<double>(cols));
+// ---------- Parameter File ----------
+// Binary .nrm file: magic, column names, per column min/max/mean/stddev and
+// decimal exponent, the Min-Max target range and which methods were fitted.
+const char NRM_MAGIC[4] = {'N', 'R', 'M', '1'};
 
+template <class T> void writePod(ostream &out, const T &x) { out.write((const char *)&x, sizeof(T)); }
+template <class T> bool readPod(istream &in, T &x) { return (bool)in.read((char *)&x, sizeof(T)); }
+
+void writeString(ostream &out, const string &s) {
+    writePod(out, (uint32_t)s.size());
+    out.write(s.data(), s.size());
+}
+
+bool readString(istream &in, string &s) {
+    uint32_t n;
+    if (!readPod(in, n)) return false;
+    s.resize(n);
+    return (bool)in.read(&s[0], n);
+}
+
+bool saveParams(const NormParams &p, const string &filename) {
+    ofstream out(filename, ios::binary);
+    if (!out.is_open()) return false;
+    out.write(NRM_MAGIC, 4);
+    int cols = p.cols();
+    writePod(out, (uint32_t)cols);
+    writePod(out, (uint8_t)!p.header.empty());
+    for (auto &h : p.header) writeString(out, h);
     for (int j = 0; j < cols; j++) {
-        double maxAbs = 0;
-        for (int i = 0; i < rows; i++)
-            maxAbs = max(maxAbs, fabs(data[i][j]));
-        int k = (maxAbs == 0) ? 1 : ceil(log10(maxAbs + 1));
-        for (int i = 0; i < rows; i++)
-            norm[i][j] = data[i][j] / pow(10, k);
+        writePod(out, p.minVal[j]);
+        writePod(out, p.maxVal[j]);
+        writePod(out, p.mean[j]);
+        writePod(out, p.stdDev[j]);
+        writePod(out, (int32_t)p.exponent[j]);
     }
-    return norm;
+    writePod(out, p.newMin);
+    writePod(out, p.newMax);
+    writePod(out, (uint8_t)(p.minMax | p.zScore << 1 | p.decScale << 2));
+    return (bool)out;
+}
+
+bool isParamFile(const string &filename) {
+    ifstream in(filename, ios::binary);
+    char magic[4];
+    return in.read(magic, 4) && equal(magic, magic + 4, NRM_MAGIC);
+}
+
+bool loadParams(NormParams &p, const string &filename) {
+    ifstream in(filename, ios::binary);
+    char magic[4];
+    if (!in.read(magic, 4) || !equal(magic, magic + 4, NRM_MAGIC)) return false;
+    uint32_t cols;
+    uint8_t hasHeader, methods;
+    if (!readPod(in, cols) || !readPod(in, hasHeader)) return false;
+    p.header.assign(hasHeader ? cols : 0, "");
+    for (auto &h : p.header)
+        if (!readString(in, h)) return false;
+    p.minVal.resize(cols);
+    p.maxVal.resize(cols);
+    p.mean.resize(cols);
+    p.stdDev.resize(cols);
+    p.exponent.resize(cols);
+    for (uint32_t j = 0; j < cols; j++) {
+        int32_t k;
+        if (!readPod(in, p.minVal[j]) || !readPod(in, p.maxVal[j]) || !readPod(in, p.mean[j]) ||
+            !readPod(in, p.stdDev[j]) || !readPod(in, k))
+            return false;
+        p.exponent[j] = k;
+    }
+    if (!readPod(in, p.newMin) || !readPod(in, p.newMax) || !readPod(in, methods)) return false;
+    p.minMax = methods & 1;
+    p.zScore = methods & 2;
+    p.decScale = methods & 4;
+    p.setScale();
+    return true;
 }
 
 // Display a preview of data
@@ -158,47 +298,202 @@ void showData(const vector<string> &header, const vector<vector<double>> &data,
     }
 }
 
-// Save data to CSV
+// ---------- Buffered CSV Writer ----------
+// Copy of the CsvWriter in By-girl-new/normal.cpp, trimmed to the calls
+// this program makes (numbers in the default %g, 6-digit form).
+class CsvWriter {
+public:
+    explicit CsvWriter(const string &filename, size_t bufferSize = 1 << 20)
+        : out(filename), limit(bufferSize) {
+        buf.reserve(bufferSize + 4096);
+    }
+    ~CsvWriter() { flush(); }
+
+    CsvWriter &cell(const string &s) { sep(); buf += s; return *this; }
+    CsvWriter &cell(double v) {
+        sep();
+        char tmp[400];
+        buf.append(tmp, to_chars(tmp, tmp + sizeof(tmp), v, chars_format::general, 6).ptr);
+        return *this;
+    }
+
+    CsvWriter &endRow() {
+        buf += '\n';
+        first = true;
+        if (buf.size() >= limit) {
+            out.write(buf.data(), buf.size());
+            buf.clear();
+        }
+        return *this;
+    }
+
+    void flush() {
+        if (!buf.empty()) out.write(buf.data(), buf.size());
+        buf.clear();
+        out.flush();
+    }
+
+private:
+    ofstream out;
+    string buf;
+    size_t limit;
+    bool first = true;
+
+    void sep() {
+        if (!first) buf += ',';
+        first = false;
+    }
+};
+
+// Save data to CSV (numbers as the default stream output would print them)
 void saveCSV(const string &filename, const vector<string> &header, const vector<vector<double>> &data) {
-    ofstream out(filename);
+    CsvWriter out(filename);
     if (!header.empty()) {
-        for (int i = 0; i < header.size(); i++) {
-            out << header[i];
-            if (i < header.size() - 1) out << ",";
-        }
-        out << "\n";
+        for (auto &h : header) out.cell(h);
+        out.endRow();
     }
     for (auto &row : data) {
-        for (int j = 0; j < row.size(); j++) {
-            out << row[j];
-            if (j < row.size() - 1) out << ",";
-        }
-        out << "\n";
+        for (double v : row) out.cell(v);
+        out.endRow();
     }
-    out.close();
+    out.flush();
     cout << "Saved: " << filename << endl;
 }
+// ---------- Streaming Transform ----------
+// Normalizes a new CSV file with saved parameters in a single pass: every
+// line is parsed, scaled with each fitted method and written straight to
+// that method's file, so memory stays constant whatever the file size.
+// Lines are read the same way as readCSV (a first line with text is the
+// header, only numeric cells count). Rows with a different number of
+// numeric cells than the fitted columns are skipped and counted. The first
+// 5 output rows of each method are kept for the preview.
+long long transformCSV(const string &filename, const NormParams &p, const vector<char> &methods,
+                       const vector<string> &outFiles, vector<vector<vector<double>>> &preview,
+                       long long &skipped) {
+    ifstream file(filename);
+    if (!file.is_open()) {
+        cout << "Error: Could not open file.\n";
+        exit(1);
+    }
+    int M = methods.size(), cols = p.cols();
+    vector<unique_ptr<CsvWriter>> outs;
+    for (int m = 0; m < M; m++) outs.emplace_back(new CsvWriter(outFiles[m]));
+    preview.assign(M, {});
+
+    string line;
+    bool headerChecked = false;
+    long long rows = 0;
+    skipped = 0;
+    vector<double> x, y(cols);
+    while (getline(file, line)) {
+        vector<string> row = split(line, ',');
+        if (!headerChecked) {
+            headerChecked = true;
+            bool hasText = false;
+            for (auto &v : row)
+                if (!isNumeric(v)) {
+                    hasText = true;
+                    break;
+                }
+            if (hasText || !p.header.empty()) {
+                for (int m = 0; m < M; m++) {
+                    for (auto &h : hasText ? row : p.header) outs[m]->cell(h);
+                    outs[m]->endRow();
+                }
+            }
+            if (hasText) continue;
+        }
+
+        x.clear();
+        for (auto &v : row)
+            if (isNumeric(v)) x.push_back(stod(v));
+        if (x.empty()) continue;
+        if ((int)x.size() != cols) {
+            skipped++;
+            continue;
+        }
+        for (int m = 0; m < M; m++) {
+            for (int j = 0; j < cols; j++) {
+                y[j] = methods[m] == 'm' ? p.minMaxValue(j, x[j])
+                     : methods[m] == 'z' ? p.zScoreValue(j, x[j]) : p.decScaleValue(j, x[j]);
+                outs[m]->cell(y[j]);
+            }
+            outs[m]->endRow();
+            if (preview[m].size() < 5) preview[m].push_back(y);
+        }
+        rows++;
+    }
+    return rows;
+}
+
+// Normalize a new file with parameters saved by an earlier fit
+void runTransform(const string &paramFile) {
+    NormParams p;
+    if (!loadParams(p, paramFile)) {
+        cout << "Error: Cannot read parameter file " << paramFile << "\n";
+        return;
+    }
+    string filename, prefix;
+    cout << "Enter CSV file to transform: ";
+    cin >> filename;
+    cout << "Enter output file prefix (e.g. day2_, or - for none): ";
+    cin >> prefix;
+    if (prefix == "-") prefix = "";
+
+    vector<char> methods;
+    vector<string> titles, outFiles;
+    if (p.minMax) {
+        methods.push_back('m');
+        titles.push_back("Min-Max Normalization");
+        outFiles.push_back(prefix + "minmax_normalized.csv");
+    }
+    if (p.zScore) {
+        methods.push_back('z');
+        titles.push_back("Z-Score Normalization");
+        outFiles.push_back(prefix + "zscore_normalized.csv");
+    }
+    if (p.decScale) {
+        methods.push_back('d');
+        titles.push_back("Decimal Scaling Normalization");
+        outFiles.push_back(prefix + "decimalscaling_normalized.csv");
+    }
+
+    vector<vector<vector<double>>> preview;
+    long long skipped = 0;
+    long long rows = transformCSV(filename, p, methods, outFiles, preview, skipped);
+    for (size_t m = 0; m < methods.size(); m++) {
+        showData(p.header, preview[m], titles[m]);
+        cout << "Saved: " << outFiles[m] << endl;
+    }
+    cout << "Transformed " << rows << " rows with " << paramFile;
+    if (skipped) cout << " (" << skipped << " rows with a different column count skipped)";
+    cout << endl;
+}
 
 // Main function
 int main() {
     string filename;
-    cout << "Enter CSV file name: ";
+    cout << "Enter CSV file name (or a saved .nrm parameter file to transform new data): ";
     cin >> filename;
+    if (isParamFile(filename)) {
+        runTransform(filename);
+        return 0;
+    }
 
     vector<string> header;
     vector<vector<double>> data;
     readCSV(filename, header, data);
 
-    vector<double> minVal, maxVal, meanVal, stdVal;
-    calcStats(data, minVal, maxVal, meanVal, stdVal);
+    ColumnStats stats = calcStats(data);
+    NormParams params = fitParams(header, stats);
 
     cout << "\n--- Column Statistics ---\n";
-    for (int i = 0; i < minVal.size(); i++) {
+    for (int i = 0; i < stats.minVal.size(); i++) {
         if (!header.empty()) cout << header[i] << " -> ";
-        cout << "Min=" << minVal[i]
-             << ", Max=" << maxVal[i]
-             << ", Mean=" << meanVal[i]
-             << ", StdDev=" << stdVal[i] << endl;
+        cout << "Min=" << stats.minVal[i]
+             << ", Max=" << stats.maxVal[i]
+             << ", Mean=" << stats.mean[i]
+             << ", StdDev=" << stats.stddev(i) << endl;
     }
 
     int choice;
@@ -211,28 +506,39 @@ int main() {
     cin >> choice;
 
     if (choice == 1 || choice == 4) {
-        double newMin, newMax;
         cout << "Enter new minimum value: ";
-        cin >> newMin;
+        cin >> params.newMin;
         cout << "Enter new maximum value: ";
-        cin >> newMax;
-        auto norm = minMaxNorm(data, minVal, maxVal, newMin, newMax);
+        cin >> params.newMax;
+        params.minMax = true;
+        auto norm = normalize(data, params, 'm');
         showData(header, norm, "Min-Max Normalization");
         saveCSV("minmax_normalized.csv", header, norm);
     }
 
     if (choice == 2 || choice == 4) {
-        auto norm = zScoreNorm(data, meanVal, stdVal);
+        params.zScore = true;
+        auto norm = normalize(data, params, 'z');
         showData(header, norm, "Z-Score Normalization");
         saveCSV("zscore_normalized.csv", header, norm);
     }
 
     if (choice == 3 || choice == 4) {
-        auto norm = decScaleNorm(data);
+        params.decScale = true;
+        auto norm = normalize(data, params, 'd');
         showData(header, norm, "Decimal Scaling Normalization");
         saveCSV("decimalscaling_normalized.csv", header, norm);
     }
 
+    if (params.minMax || params.zScore || params.decScale) {
+        string paramFile;
+        cout << "\nSave normalization parameters as (.nrm file, or - to skip): ";
+        if (cin >> paramFile && paramFile != "-") {
+            if (saveParams(params, paramFile)) cout << "Parameters saved to " << paramFile << "\n";
+            else cout << "Error: Cannot write " << paramFile << "\n";
+        }
+    }
+
     return 0;
 }
 // ==================================================================================================
@@ -267,25 +573,33 @@ int main() {
 //     - Reads a CSV file and stores numeric data in a 2D vector `data`.
 //     - Automatically detects if the first line contains column headers.
 //
-// ➤ calcStats()
-//     - Computes for each numeric column:
-//           ▪ Minimum value (minVal)
-//           ▪ Maximum value (maxVal)
-//           ▪ Mean value (meanVal)
-//           ▪ Standard deviation (stdVal)
-//     - These statistics are essential for normalization formulas.
-//
-// ➤ minMaxNorm()
+// ➤ calcStats() / computeColumnStats()
+//     - Computes for each numeric column, in a single pass over the rows:
+//           ▪ Minimum and maximum value (minVal, maxVal)
+//           ▪ Sum and mean value (sum, mean)
+//           ▪ M2, the running sum of squared deviations (Welford), giving the standard deviation
+//           ▪ Largest absolute value (maxAbs, used by decimal scaling)
+//     - Large files are split into one block of rows per thread; the partial results are merged.
+//     - These statistics are essential for normalization formulas, so every method below
+//       needs only one more pass (read + write) over the data.
+//
+// ➤ fitParams() / NormParams
+//     - Turns the column statistics into the fitted parameters of every method: min/max,
+//       mean/stddev and the decimal exponent k, plus the Min-Max target range.
+//     - minMaxValue(), zScoreValue() and decScaleValue() scale one value; normalize() applies
+//       one of them to the whole data set.
+//
+// ➤ Min-Max ('m')
 //     - Applies **Min-Max Normalization** using the formula:
 //           X' = ((X - Min) / (Max - Min)) * (NewMax - NewMin) + NewMin
 //     - Scales all values to a user-defined range (e.g., [0, 1] or [-1, 1]).
 //
-// ➤ zScoreNorm()
+// ➤ Z-Score ('z')
 //     - Applies **Z-Score Normalization (Standardization)** using the formula:
 //           X' = (X - Mean) / StdDev
 //     - Centers data around zero with a standard deviation of 1.
 //
-// ➤ decScaleNorm()
+// ➤ Decimal Scaling ('d')
 //     - Applies **Decimal Scaling Normalization** using the formula:
 //           X' = X / 10^k
 //       where k is the smallest integer such that max(|X'|) < 1.
@@ -293,11 +607,22 @@ int main() {
 // ➤ showData()
 //     - Displays the first few normalized rows for quick verification.
 //
-// ➤ saveCSV()
+// ➤ CsvWriter / saveCSV()
 //     - Saves normalized data into separate CSV files for each method.
+//     - Cells are formatted with to_chars into a 1 MB buffer that is written in large blocks;
+//       numbers keep the default stream format (6 significant digits).
+//
+// ➤ saveParams() / loadParams() / isParamFile()
+//     - Store the fitted parameters and the fitted methods in a binary .nrm file ("NRM1").
+//
+// ➤ transformCSV() / runTransform()
+//     - Given a .nrm file instead of a CSV, the program asks for a new CSV and streams it line
+//       by line through the saved parameters into every fitted method's file: one pass,
+//       constant memory, and exactly the scaling of the original fit.
 //
 // ➤ main()
 //     - Handles user interaction, method selection, and file saving.
+//     - After a fit, offers to save the parameters for later transforms.
 //
 // --------------------------------------------------------------------------------------------------
 // 🔸 2️⃣ STEP-BY-STEP EXECUTION
@@ -1,41 +1,415 @@
 #include <bits/stdc++.h>
 using namespace std;
 
-// ---------- Read CSV File ----------
-vector<vector<string>> readCSV(const string &filename) {
-    vector<vector<string>> data;
-    ifstream file(filename);
-    if (!file.is_open()) {
-        cerr << "Error: Cannot open file " << filename << endl;
-        return data;
+// ---------- Regression Sums ----------
+// Sufficient statistics of simple linear regression. Partial sums over
+// different rows merge by adding, so the file can be split any way.
+struct RegressionSums {
+    long long n = 0;
+    double sumx = 0, sumy = 0, sumxy = 0, sumx2 = 0;
+
+    void add(double x, double y) {
+        n++;
+        sumx += x;
+        sumy += y;
+        sumxy += x * y;
+        sumx2 += x * x;
     }
 
-    string line;
-    while (getline(file, line)) {
-        if (line.empty()) continue;
-        stringstream ss(line);
-        string cell;
-        vector<string> row;
-        while (getline(ss, cell, ',')) {
-            // Remove extra spaces
-            while (!cell.empty() && cell.front() == ' ') cell.erase(cell.begin());
-            while (!cell.empty() && cell.back() == ' ') cell.pop_back();
-            row.push_back(cell);
+    void merge(const RegressionSums &o) {
+        n += o.n;
+        sumx += o.sumx;
+        sumy += o.sumy;
+        sumxy += o.sumxy;
+        sumx2 += o.sumx2;
+    }
+};
+
+// ---------- Parse a Numeric Cell ----------
+// Accepts what stod accepts (leading number, surrounding spaces ignored) and
+// rejects empty cells, text and out-of-range values.
+bool parseNumeric(const char *b, const char *e, double &v) {
+    while (b < e && *b == ' ') b++;
+    while (e > b && e[-1] == ' ') e--;
+    if (b == e) return false;
+    char tmp[128];
+    string big;
+    const char *s = tmp;
+    size_t len = e - b;
+    if (len < sizeof(tmp)) {
+        memcpy(tmp, b, len);
+        tmp[len] = 0;
+    } else {
+        big.assign(b, e);
+        s = big.c_str();
+    }
+    char *stop;
+    errno = 0;
+    v = strtod(s, &stop);
+    return stop != s && errno != ERANGE;
+}
+
+// ---------- Parallel Streaming Reader ----------
+// Copy of streamRange / streamCSV in By-vaibhav-new/12.linear regression/multiple.cpp
+// (each program is built on its own); fix both copies together.
+const long long STREAM_PARALLEL_BYTES = 1 << 22;
+
+template <class Acc, class LineFn>
+void streamRange(const string &filename, long long begin, long long end, Acc &acc, LineFn onLine) {
+    ifstream in(filename, ios::binary);
+    bool skipFirst = begin > 0;
+    in.seekg(skipFirst ? begin - 1 : begin);
+    long long pos = skipFirst ? begin - 1 : begin;    // file offset of buf[0]
+    long long lineStart = pos;
+    vector<char> buf(1 << 20);
+    string carry;
+    while (lineStart < end) {
+        in.read(buf.data(), buf.size());
+        size_t got = in.gcount();
+        if (got == 0) {
+            if (!carry.empty() && carry.back() == '\r') carry.pop_back();
+            if (!carry.empty() && !skipFirst) onLine(acc, carry.data(), carry.data() + carry.size());
+            break;
+        }
+        size_t from = 0;
+        for (size_t i = 0; i < got && lineStart < end; i++) {
+            if (buf[i] != '\n') continue;
+            const char *b = buf.data() + from, *e = buf.data() + i;
+            if (!carry.empty()) {
+                carry.append(b, e);
+                b = carry.data();
+                e = b + carry.size();
+            }
+            if (e > b && e[-1] == '\r') e--;
+            if (skipFirst) skipFirst = false;
+            else onLine(acc, b, e);
+            carry.clear();
+            from = i + 1;
+            lineStart = pos + i + 1;
         }
-        data.push_back(row);
+        if (lineStart < end) carry.append(buf.data() + from, buf.data() + got);
+        pos += got;
     }
-    file.close();
-    return data;
 }
 
-// ---------- Check if String is Numeric ----------
-bool isNumeric(const string &s) {
-    if (s.empty()) return false;
-    try {
-        stod(s);
-        return true;
-    } catch (...) {
-        return false;
+template <class Acc, class LineFn>
+Acc streamCSV(const string &filename, long long dataStart, const Acc &empty, LineFn onLine) {
+    ifstream probe(filename, ios::binary | ios::ate);
+    long long size = probe.tellg();
+    long long bytes = max(0LL, size - dataStart);
+    int threads = bytes < STREAM_PARALLEL_BYTES ? 1 : max(1, (int)thread::hardware_concurrency());
+    vector<Acc> part(threads, empty);
+    vector<thread> workers;
+    for (int t = 0; t < threads; t++) {
+        auto work = [&, t] {
+            streamRange(filename, dataStart + bytes * t / threads, dataStart + bytes * (t + 1) / threads,
+                        part[t], onLine);
+        };
+        if (t + 1 < threads) workers.emplace_back(work);
+        else work();
+    }
+    for (thread &w : workers) w.join();
+    for (int t = 1; t < threads; t++) part[0].merge(part[t]);
+    return part[0];
+}
+
+// ---------- Coefficient File ----------
+// Copy of the .rgm reader/writer in multiple.cpp, which documents the layout;
+// the two must stay identical so either program reads the other's models.
+const char RGM_MAGIC[4] = {'R', 'G', 'M', '1'};
+
+struct RegressionModel {
+    string target;
+    vector<string> features;
+    vector<double> coef;    // b0, b1 .. bk
+};
+
+template <class T> void writePod(ostream &out, const T &x) { out.write((const char *)&x, sizeof(T)); }
+template <class T> bool readPod(istream &in, T &x) { return (bool)in.read((char *)&x, sizeof(T)); }
+
+void writeString(ostream &out, const string &s) {
+    writePod(out, (uint32_t)s.size());
+    out.write(s.data(), s.size());
+}
+
+bool readString(istream &in, string &s) {
+    uint32_t n;
+    if (!readPod(in, n)) return false;
+    s.resize(n);
+    return (bool)in.read(&s[0], n);
+}
+
+bool saveCoefficients(const RegressionModel &m, const string &filename) {
+    ofstream out(filename, ios::binary);
+    if (!out.is_open()) return false;
+    out.write(RGM_MAGIC, 4);
+    writeString(out, m.target);
+    writePod(out, (uint32_t)m.features.size());
+    for (auto &f : m.features) writeString(out, f);
+    out.write((const char *)m.coef.data(), m.coef.size() * sizeof(double));
+    return (bool)out;
+}
+
+bool isCoefficientFile(const string &filename) {
+    ifstream in(filename, ios::binary);
+    char magic[4];
+    return in.read(magic, 4) && equal(magic, magic + 4, RGM_MAGIC);
+}
+
+bool loadCoefficients(RegressionModel &m, const string &filename) {
+    ifstream in(filename, ios::binary);
+    char magic[4];
+    uint32_t k;
+    if (!in.read(magic, 4) || !equal(magic, magic + 4, RGM_MAGIC)) return false;
+    if (!readString(in, m.target) || !readPod(in, k)) return false;
+    m.features.resize(k);
+    for (auto &f : m.features)
+        if (!readString(in, f)) return false;
+    m.coef.resize(k + 1);
+    return (bool)in.read((char *)m.coef.data(), m.coef.size() * sizeof(double));
+}
+
+// ---------- Batch Scoring ----------
+// Copy of the batch scorer in multiple.cpp (ScoreMetrics, ScoreWorker,
+// runScoring), which describes how it works; fix both copies together.
+const int SCORE_BLOCK_ROWS = 4096;
+
+struct ScoreMetrics {
+    long long n = 0, skipped = 0;
+    double sse = 0, sae = 0;     // sum of squared / absolute residuals
+    double yMean = 0, yM2 = 0;   // target mean and centred sum of squares, for R^2
+
+    void merge(long long bn, double bMean, double bM2) {
+        if (bn == 0) return;
+        long long total = n + bn;
+        double d = bMean - yMean;
+        yM2 += bM2 + d * d * ((double)n * bn / total);
+        yMean += d * bn / total;
+        n = total;
+    }
+
+    void merge(const ScoreMetrics &o) {
+        sse += o.sse;
+        sae += o.sae;
+        skipped += o.skipped;
+        merge(o.n, o.yMean, o.yM2);
+    }
+};
+
+bool parseCell(const char *b, const char *e, double &v) {
+    while (b < e && *b == ' ') b++;
+    if (b < e && *b == '+') b++;
+    if (b == e) return false;
+    return from_chars(b, e, v).ec == errc();
+}
+
+struct ScoreWorker {
+    const RegressionModel *model = nullptr;
+    vector<int> featureCol;       // CSV column of each feature
+    int targetCol = -1, lastCol = 0;
+    vector<vector<double>> x;     // [feature][row of block]
+    vector<double> y, pred;
+    vector<int> slot;             // per block line: typed row, or -1 if skipped
+    int typed = 0;                // rows of the block in the typed columns
+    string lines;                 // block lines, each ended by '\n'
+    string buf;
+    vector<const char *> cellB, cellE;
+    ofstream out;
+    bool writing = false;
+    ScoreMetrics metrics;
+
+    // outFile empty: metrics only. append: keep what is already in the file.
+    void init(const RegressionModel &m, const vector<int> &cols, int target, const string &outFile, bool append) {
+        model = &m;
+        featureCol = cols;
+        targetCol = target;
+        lastCol = target;
+        for (int c : cols) lastCol = max(lastCol, c);
+        x.assign(cols.size(), vector<double>(SCORE_BLOCK_ROWS));
+        y.resize(SCORE_BLOCK_ROWS);
+        pred.resize(SCORE_BLOCK_ROWS);
+        cellB.resize(lastCol + 1);
+        cellE.resize(lastCol + 1);
+        writing = !outFile.empty();
+        if (writing) out.open(outFile, append ? ios::binary | ios::app : ios::binary | ios::trunc);
+    }
+
+    void addLine(const char *b, const char *e) {
+        int r = typed;
+        fill(cellB.begin(), cellB.end(), nullptr);
+        int col = 0;
+        for (const char *c = b; col <= lastCol; col++) {
+            const char *comma = find(c, e, ',');
+            cellB[col] = c;
+            cellE[col] = comma;
+            if (comma == e) break;
+            c = comma + 1;
+        }
+        bool ok = b != e;
+        for (size_t f = 0; ok && f < featureCol.size(); f++)
+            ok = cellB[featureCol[f]] && parseCell(cellB[featureCol[f]], cellE[featureCol[f]], x[f][r]);
+        if (ok && targetCol >= 0) ok = cellB[targetCol] && parseCell(cellB[targetCol], cellE[targetCol], y[r]);
+        if (!ok && b != e) metrics.skipped++;
+        slot.push_back(ok ? r : -1);
+        typed += ok;
+        if (writing) {
+            lines.append(b, e);
+            lines += '\n';
+        }
+        if ((int)slot.size() == SCORE_BLOCK_ROWS) flushBlock();
+    }
+
+    void flushBlock() {
+        int n = typed;
+        const vector<double> &coef = model->coef;
+        double *p = pred.data();
+        for (int r = 0; r < n; r++) p[r] = coef[0];
+        for (size_t f = 0; f < x.size(); f++) {
+            const double *xf = x[f].data();
+            double bf = coef[f + 1];
+            for (int r = 0; r < n; r++) p[r] += bf * xf[r];
+        }
+        if (targetCol >= 0 && n > 0) {
+            const double *yv = y.data();
+            double sse = 0, sae = 0, sum = 0, m2 = 0;
+            for (int r = 0; r < n; r++) {
+                double d = yv[r] - p[r];
+                sse += d * d;
+                sae += fabs(d);
+                sum += yv[r];
+            }
+            double mean = sum / n;
+            for (int r = 0; r < n; r++) m2 += (yv[r] - mean) * (yv[r] - mean);
+            metrics.sse += sse;
+            metrics.sae += sae;
+            metrics.merge(n, mean, m2);
+        } else {
+            metrics.n += n;
+        }
+
+        if (writing) {
+            buf.clear();
+            char num[64];
+            size_t pos = 0;
+            for (int s : slot) {
+                size_t end = lines.find('\n', pos);
+                buf.append(lines, pos, end - pos);
+                pos = end + 1;
+                buf += ',';
+                if (s >= 0) buf.append(num, to_chars(num, num + sizeof(num), p[s], chars_format::fixed, 4).ptr);
+                if (targetCol >= 0) {
+                    buf += ',';
+                    if (s >= 0)
+                        buf.append(num, to_chars(num, num + sizeof(num), y[s] - p[s], chars_format::fixed, 4).ptr);
+                }
+                buf += '\n';
+            }
+            out.write(buf.data(), buf.size());
+        }
+        slot.clear();
+        typed = 0;
+        lines.clear();
+    }
+};
+
+vector<string> headerNames(string line) {
+    if (!line.empty() && line.back() == '\r') line.pop_back();
+    vector<string> names;
+    stringstream ss(line);
+    string cell;
+    while (getline(ss, cell, ',')) {
+        while (!cell.empty() && cell.front() == ' ') cell.erase(cell.begin());
+        while (!cell.empty() && cell.back() == ' ') cell.pop_back();
+        names.push_back(cell);
+    }
+    return names;
+}
+
+void runScoring(const string &modelFile) {
+    RegressionModel m;
+    if (!loadCoefficients(m, modelFile)) {
+        cout << "Error: Cannot read coefficient file " << modelFile << "\n";
+        return;
+    }
+    string testFile, outFile;
+    cout << "Enter CSV file to score: ";
+    cin >> testFile;
+    cout << "Write predictions to (CSV file, or - to skip): ";
+    cin >> outFile;
+    if (outFile == "-") outFile.clear();
+
+    ifstream file(testFile, ios::binary);
+    string headerLine;
+    if (!file.is_open() || !getline(file, headerLine)) {
+        cout << "Error: Cannot open file " << testFile << "\n";
+        return;
+    }
+    long long dataStart = file.tellg();
+    file.close();
+    vector<string> names = headerNames(headerLine);
+    auto column = [&](const string &name) { return (int)(find(names.begin(), names.end(), name) - names.begin()); };
+    vector<int> featureCol;
+    for (auto &f : m.features) {
+        int c = column(f);
+        if (c == (int)names.size()) {
+            cout << "Error: Column " << f << " not found in " << testFile << "\n";
+            return;
+        }
+        featureCol.push_back(c);
+    }
+    int targetCol = column(m.target);
+    if (targetCol == (int)names.size()) targetCol = -1;
+
+    auto t0 = chrono::steady_clock::now();
+    ifstream probe(testFile, ios::binary | ios::ate);
+    long long size = probe.tellg();
+    long long bytes = max(0LL, size - dataStart);
+    int threads = bytes < STREAM_PARALLEL_BYTES ? 1 : max(1, (int)thread::hardware_concurrency());
+    if (!outFile.empty()) {
+        ofstream head(outFile, ios::binary);
+        if (!headerLine.empty() && headerLine.back() == '\r') headerLine.pop_back();
+        head << headerLine << ",Predicted_" << m.target << (targetCol >= 0 ? ",Residual" : "") << "\n";
+    }
+    vector<ScoreWorker> part(threads);
+    vector<thread> workers;
+    for (int t = 0; t < threads; t++) {
+        auto work = [&, t] {
+            part[t].init(m, featureCol, targetCol,
+                         outFile.empty() ? "" : t == 0 ? outFile : outFile + ".part" + to_string(t), t == 0);
+            streamRange(testFile, dataStart + bytes * t / threads, dataStart + bytes * (t + 1) / threads, part[t],
+                        [](ScoreWorker &w, const char *b, const char *e) { w.addLine(b, e); });
+            part[t].flushBlock();
+            part[t].out.close();
+        };
+        if (t + 1 < threads) workers.emplace_back(work);
+        else work();
+    }
+    for (thread &w : workers) w.join();
+    for (int t = 1; t < threads; t++) {
+        part[0].metrics.merge(part[t].metrics);
+        if (outFile.empty()) continue;
+        string partFile = outFile + ".part" + to_string(t);
+        ofstream all(outFile, ios::binary | ios::app);
+        ifstream in(partFile, ios::binary);
+        all << in.rdbuf();
+        in.close();
+        remove(partFile.c_str());
+    }
+    double secs = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+
+    const ScoreMetrics &s = part[0].metrics;
+    cout << fixed << setprecision(4);
+    cout << "\nScored " << s.n << " records in " << setprecision(2) << secs << " s";
+    if (secs > 0) cout << " (" << (long long)(s.n / secs) << " records/s)";
+    cout << "\n" << setprecision(4);
+    if (s.skipped) cout << s.skipped << " rows with a missing or non-numeric value left unscored\n";
+    if (!outFile.empty()) cout << "Predictions written to " << outFile << "\n";
+    if (targetCol >= 0 && s.n > 0) {
+        cout << "R^2  = " << (s.yM2 > 0 ? 1 - s.sse / s.yM2 : 0.0) << "\n";
+        cout << "RMSE = " << sqrt(s.sse / s.n) << "\n";
+        cout << "MAE  = " << s.sae / s.n << "\n";
+    } else if (targetCol < 0) {
+        cout << "No " << m.target << " column in " << testFile << ", so no error metrics\n";
     }
 }
 
@@ -45,16 +419,39 @@ int main() {
     cin.tie(nullptr);
 
     string filename;
-    cout << "Enter CSV filename (e.g. data.csv): " << flush;
+    cout << "Enter CSV filename (e.g. data.csv) or saved .rgm coefficient file: " << flush;
     getline(cin >> ws, filename); // handles spaces properly
+    if (isCoefficientFile(filename)) {
+        runScoring(filename);
+        return 0;
+    }
 
-    vector<vector<string>> data = readCSV(filename);
-    if (data.empty()) {
+    ifstream file(filename, ios::binary);
+    if (!file.is_open()) {
+        cerr << "Error: Cannot open file " << filename << endl;
+        return 1;
+    }
+    string headerLine;
+    while (getline(file, headerLine)) {
+        if (!headerLine.empty() && headerLine.back() == '\r') headerLine.pop_back();
+        if (!headerLine.empty()) break;
+    }
+    long long dataStart = file.tellg();
+    file.close();
+    if (headerLine.empty()) {
         cerr << "Error: Empty or invalid CSV file.\n";
         return 1;
     }
 
-    vector<string> headers = data[0];
+    vector<string> headers;
+    stringstream hs(headerLine);
+    string cell;
+    while (getline(hs, cell, ',')) {
+        // Remove extra spaces
+        while (!cell.empty() && cell.front() == ' ') cell.erase(cell.begin());
+        while (!cell.empty() && cell.back() == ' ') cell.pop_back();
+        headers.push_back(cell);
+    }
     cout << "\nColumns detected:\n";
     for (size_t i = 0; i < headers.size(); ++i)
         cout << i + 1 << ". " << headers[i] << endl;
@@ -66,37 +463,38 @@ int main() {
     cin >> colY;
 
     colX--; colY--; // Convert 1-based index to 0-based
-    if (colX >= headers.size() || colY >= headers.size()) {
+    if (colX < 0 || colY < 0 || colX >= headers.size() || colY >= headers.size()) {
         cerr << "Error: Invalid column numbers.\n";
         return 1;
     }
 
-    vector<double> x, y;
-    for (size_t i = 1; i < data.size(); ++i) {
-        if (colX < data[i].size() && colY < data[i].size()) {
-            string sx = data[i][colX];
-            string sy = data[i][colY];
-            if (isNumeric(sx) && isNumeric(sy)) {
-                x.push_back(stod(sx));
-                y.push_back(stod(sy));
-            }
+    // One streaming pass fills the sums; rows where either selected cell is
+    // missing or not numeric are skipped
+    int lastCol = max(colX, colY);
+    RegressionSums sums = streamCSV(filename, dataStart, RegressionSums(),
+                                    [&](RegressionSums &acc, const char *b, const char *e) {
+        const char *cx = nullptr, *ex = nullptr, *cy = nullptr, *ey = nullptr;
+        int col = 0;
+        for (const char *c = b; col <= lastCol; col++) {
+            const char *comma = find(c, e, ',');
+            if (col == colX) cx = c, ex = comma;
+            if (col == colY) cy = c, ey = comma;
+            if (comma == e) break;
+            c = comma + 1;
         }
-    }
+        double x, y;
+        if (cx && cy && parseNumeric(cx, ex, x) && parseNumeric(cy, ey, y)) acc.add(x, y);
+    });
 
-    int n = x.size();
+    long long n = sums.n;
     if (n == 0) {
         cerr << "Error: No valid numeric data found in selected columns.\n";
         return 1;
     }
 
     // ---------- Intermediate Steps ----------
-    double sumx = accumulate(x.begin(), x.end(), 0.0);
-    double sumy = accumulate(y.begin(), y.end(), 0.0);
-    double sumxy = 0, sumx2 = 0;
-    for (int i = 0; i < n; i++) {
-        sumxy += x[i] * y[i];
-        sumx2 += x[i] * x[i];
-    }
+    double sumx = sums.sumx, sumy = sums.sumy;
+    double sumxy = sums.sumxy, sumx2 = sums.sumx2;
 
     cout << "\n---------- Intermediate Calculations ----------\n";
     cout << "ΣX = " << sumx << ", ΣY = " << sumy << "\n";
@@ -121,6 +519,14 @@ int main() {
     cout << "Predicted Y = " << y_pred << "\n";
 
     cout << "==============================================\n";
+
+    string coefFile;
+    cout << "\nSave coefficients as (.rgm file for batch scoring, or - to skip): " << flush;
+    if (cin >> coefFile && coefFile != "-") {
+        RegressionModel model{headers[colY], {headers[colX]}, {b0, b1}};
+        if (saveCoefficients(model, coefFile)) cout << "Coefficients saved to " << coefFile << "\n";
+        else cout << "Error: Cannot write " << coefFile << "\n";
+    }
     return 0;
 }
 
@@ -164,24 +570,40 @@ int main() {
 // 🔸 2️⃣ FUNCTION OVERVIEW
 // --------------------------------------------------------------------------------------------------
 //
-// ➤ readCSV()
-//     - Reads the input CSV dataset line by line.
-//     - Splits each row by commas.
-//     - Removes leading/trailing spaces and stores the data in a 2D vector.
+// ➤ streamCSV() / streamRange()
+//     - Reads the CSV after its header in one pass, one byte range per thread, through a
+//       fixed-size buffer, so even files far larger than memory can be fitted.
+//     - Each line's selected X and Y cells are handed to the thread's own accumulator.
+//
+// ➤ RegressionSums
+//     - Holds n, ΣX, ΣY, ΣXY and ΣX², everything the least-squares formulas need.
+//     - merge() adds two partial sums, so the per-thread results combine into the total.
 //
-// ➤ isNumeric()
-//     - Checks whether a string represents a valid numeric value (integer or decimal).
+// ➤ parseNumeric()
+//     - Checks whether a cell represents a valid numeric value (integer or decimal), with
+//       surrounding spaces ignored, and converts it.
 //     - Helps skip non-numeric data in chosen columns.
 //
+// ➤ saveCoefficients() / loadCoefficients() / isCoefficientFile()
+//     - Store the fitted equation (target, feature names, b₀ and b₁) in a binary .rgm file
+//       ("RGM1"); multiple.cpp writes the same format with more features.
+//
+// ➤ runScoring() / ScoreWorker / ScoreMetrics
+//     - Given a .rgm file instead of a CSV, scores every row of a test CSV in one streaming,
+//       multithreaded pass: rows are gathered into typed column blocks, predicted with
+//       vectorizable loops, and written with Predicted_<Y> and Residual columns appended.
+//     - Reports R², RMSE and MAE when the test file has the target column.
+//
 // ➤ main()
 //     - Handles overall workflow:
-//         1️⃣ Reads CSV file
+//         1️⃣ Reads the CSV header
 //         2️⃣ Displays available columns
 //         3️⃣ User selects X and Y columns
-//         4️⃣ Extracts numeric values
+//         4️⃣ Streams the rows into the regression sums
 //         5️⃣ Computes regression coefficients (b₀, b₁)
 //         6️⃣ Prints regression equation
 //         7️⃣ Predicts Y for a given X
+//         8️⃣ Optionally saves the coefficients for batch scoring
 //
 // --------------------------------------------------------------------------------------------------
 // 🔸 3️⃣ STEP-BY-STEP EXECUTION